@@ -0,0 +1,148 @@
+/**
+ * The ActorComponents class labels the components
+ * with a union-find over the actors that several
+ * threads update at once.
+ *
+ * Instance variables:
+ *  1) components - The component of every actor
+ *
+ *  2) sizes - The number of actors of every component
+ *
+ *  3) largest - The component with the most actors
+ *
+ *  4) numSingletons - The number of components of a
+ *                     single actor
+ */
+
+#include "ActorComponents.hpp"
+#include <atomic>
+#include "Parallel.hpp"
+
+using namespace std;
+
+// Number of movies each thread takes at a time
+static const size_t MOVIES_PER_TASK = 4096;
+
+/*
+ * This function returns the root of the set of an
+ * actor, pointing every other actor on the way at
+ * its grandparent. Parents only ever move to smaller
+ * actors of the same set, so a halving that loses a
+ * race is simply skipped. While other threads unite
+ * sets the result may stop being a root right away.
+ *
+ * Parameters:
+ *  1) parents - The parent of every actor
+ *  2) actor - The actor to look up
+ *
+ */
+static unsigned int findRoot(vector<atomic<unsigned int>>& parents,
+                             unsigned int actor) {
+    unsigned int parent = parents[actor].load(memory_order_relaxed);
+    while (parent != actor) {
+        unsigned int grandparent = parents[parent].load(memory_order_relaxed);
+        unsigned int expected = parent;
+        parents[actor].compare_exchange_weak(expected, grandparent,
+                                             memory_order_relaxed);
+        actor = parent;
+        parent = grandparent;
+    }
+    return actor;
+}
+
+/*
+ * This function merges the sets of two actors by
+ * hanging the larger root under the smaller one,
+ * retrying if another thread moved either root.
+ *
+ * Parameters:
+ *  1) parents - The parent of every actor
+ *  2) actor - An actor of the first set
+ *  3) other - An actor of the second set
+ *
+ */
+static void uniteRoots(vector<atomic<unsigned int>>& parents,
+                       unsigned int actor, unsigned int other) {
+    while (true) {
+        actor = findRoot(parents, actor);
+        other = findRoot(parents, other);
+        if (actor == other) {
+            return;
+        }
+        if (actor < other) {
+            swap(actor, other);
+        }
+        unsigned int expected = actor;
+        if (parents[actor].compare_exchange_strong(expected, other)) {
+            return;
+        }
+    }
+}
+
+/*
+ * This is the contructor method for the
+ * components. It labels every actor of a graph.
+ *
+ * Parameters:
+ *  1) graph - The graph to label
+ *  2) numThreads - The number of threads to use
+ *
+ */
+ActorComponents::ActorComponents(const CSRGraph& graph,
+                                 unsigned int numThreads) {
+    unsigned int numActors = graph.numActors();
+    vector<atomic<unsigned int>> parents(numActors);
+    for (unsigned int a = 0; a < numActors; a++) {
+        parents[a].store(a, memory_order_relaxed);
+    }
+
+    // Every actor of a movie joins the set of its first actor
+    size_t numTasks =
+        (graph.numMovies() + MOVIES_PER_TASK - 1) / MOVIES_PER_TASK;
+    parallelFor(numThreads, numTasks, [&](size_t task) {
+        unsigned int first = task * MOVIES_PER_TASK;
+        unsigned int last =
+            min((size_t)graph.numMovies(), first + MOVIES_PER_TASK);
+        for (unsigned int m = first; m < last; m++) {
+            const unsigned int* cast = graph.actorsBegin(m);
+            for (auto actor = cast + 1; actor < graph.actorsEnd(m); actor++) {
+                uniteRoots(parents, *cast, *actor);
+            }
+        }
+    });
+
+    // Each root is the first actor of its set, so it is numbered
+    // before any other actor of the set looks it up
+    this->components.resize(numActors);
+    this->largest = 0;
+    this->numSingletons = 0;
+    for (unsigned int a = 0; a < numActors; a++) {
+        unsigned int root = findRoot(parents, a);
+        if (root == a) {
+            this->components[a] = this->sizes.size();
+            this->sizes.push_back(0);
+        } else {
+            this->components[a] = this->components[root];
+        }
+        this->sizes[this->components[a]]++;
+    }
+    for (unsigned int c = 0; c < this->sizes.size(); c++) {
+        if (this->sizes[c] > this->sizes[this->largest]) {
+            this->largest = c;
+        }
+        this->numSingletons += this->sizes[c] == 1;
+    }
+}
+
+/*
+ * The purpose of this method is to return the
+ * number of bytes used by the components.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+size_t ActorComponents::memoryUsage() const {
+    return sizeof(unsigned int) * this->components.capacity() +
+           sizeof(unsigned int) * this->sizes.capacity();
+}
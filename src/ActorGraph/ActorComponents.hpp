@@ -0,0 +1,99 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Sources used:
+ *  1) Jayanti and Tarjan, "A Randomized Concurrent
+ *     Algorithm for Disjoint Set Union", PODC 2016
+ *
+ * Description of File:
+ *  This file defines the connected components of the
+ *  actors. Two actors are in the same component if a
+ *  chain of shared movies links them, so a search
+ *  between components can be answered at once.
+ */
+
+#ifndef ACTORCOMPONENTS_HPP
+#define ACTORCOMPONENTS_HPP
+
+#include <cstddef>
+#include <vector>
+#include "CSRGraph.hpp"
+
+using namespace std;
+
+/**
+ * The ActorComponents class labels the components
+ * with a union-find over the actors that several
+ * threads update at once, each uniting the casts of
+ * its own movies. A root is always hung under a
+ * smaller actor, so the root of a component is its
+ * first actor and the components are numbered in the
+ * order of their first actor.
+ *
+ * Instance variables:
+ *  1) components - The component of every actor
+ *
+ *  2) sizes - The number of actors of every component
+ *
+ *  3) largest - The component with the most actors
+ *
+ *  4) numSingletons - The number of components of a
+ *                     single actor
+ */
+class ActorComponents {
+  protected:
+    vector<unsigned int> components;
+    vector<unsigned int> sizes;
+    unsigned int largest;
+    unsigned int numSingletons;
+
+  public:
+    /*
+     * This is the contructor method for the
+     * components. It labels every actor of a graph.
+     *
+     * Parameters:
+     *  1) graph - The graph to label
+     *  2) numThreads - The number of threads to use
+     *
+     */
+    ActorComponents(const CSRGraph& graph, unsigned int numThreads = 1);
+
+    /* Returns the number of components */
+    unsigned int numComponents() const { return this->sizes.size(); }
+
+    /* Returns the component of an actor */
+    unsigned int getComponent(unsigned int actorId) const {
+        return this->components[actorId];
+    }
+
+    /* Returns true if a path links two actors */
+    bool areConnected(unsigned int actorId, unsigned int otherId) const {
+        return this->components[actorId] == this->components[otherId];
+    }
+
+    /* Returns the number of actors of a component */
+    unsigned int getSize(unsigned int component) const {
+        return this->sizes[component];
+    }
+
+    /* Returns the component with the most actors, the first on ties */
+    unsigned int getLargest() const { return this->largest; }
+
+    /* Returns the number of actors that share no movie */
+    unsigned int getNumSingletons() const { return this->numSingletons; }
+
+    /*
+     * The purpose of this method is to return the
+     * number of bytes used by the components.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    size_t memoryUsage() const;
+};
+
+#endif  // ACTORCOMPONENTS_HPP
@@ -7,20 +7,90 @@
  * actors and their movies.
  *
  * Instance variables:
- *  1) ofActors - A hashtable of Actor nodes ordered
- *                by their name
+ *  1) actorNames - The interned names of the actors
+ *
+ *  2) movieNames - The interned "title#@year" names
+ *                  of the movies
+ *
+ *  3) ofActorIds - The actor nodes indexed by their id,
+ *                  kept only while the file is read
+ *
+ *  4) ofMovieIds - The movie nodes indexed by their id,
+ *                  kept only while the file is read
+ *
+ *  5) ofCSR - The frozen copy of the graph that the
+ *             searches run on
+ *
+ *  6) ofSnapshot - The snapshot the graph was loaded
+ *                  from, if any
+ *
+ *  7) ofArena - The arena the nodes and their edges
+ *               are stored in, emptied once frozen
+ *
+ *  8) ofCollaborators - The actor to actor projection,
+ *                       built when asked for or the
+ *                       first time a score needs it
+ *
+ *  9) collaboratorsOnce - Makes sure the projection is
+ *                         built only once
+ *
+ *  10) ofYearIndex - The movies of every actor sorted
+ *                    by year, built the first time a
+ *                    search is limited to some years
+ *
+ *  11) yearIndexOnce - Makes sure the index is built
+ *                      only once
+ *
+ *  12) ofLabels - The distance labels of the actors,
+ *                 read or built before the first
+ *                 indexed search
+ *
+ *  13) labelsOnce - Makes sure the labels are built
+ *                   only once
+ *
+ *  14) ofLandmarks - The distances to a few landmark
+ *                    actors, built before the first
+ *                    search that bounds distances
+ *
+ *  15) landmarksOnce - Makes sure the landmarks are
+ *                      built only once
+ *
+ *  16) ofComponents - The connected components of the
+ *                     actors, labeled once the graph
+ *                     is loaded
+ *
+ *  17) ofCompressed - The compressed copy of the graph
+ *                     that replaces ofCSR once the
+ *                     graph is compressed
+ *
+ *  18) ofCastBitsets - The casts of the largest movies
+ *                      as bitsets, built once the graph
+ *                      is loaded
  */
 
 #include "ActorGraph.hpp"
-#include <fstream>
+#include "CastFileReader.hpp"
+#include "DisjointSets.hpp"
+#include "GraphSnapshot.hpp"
+#include "HybridBFS.hpp"
+#include "MultiSourceBFS.hpp"
+#include "ParallelCastLoader.hpp"
+#include "SearchWorkspace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <iostream>
-#include <queue>
-#include <sstream>
 #include <string>
-#include <unordered_set>
+#include <thread>
+#include <unordered_map>
 
 using namespace std;
 
+const int ActorGraph::NO_YEAR;
+
 /*
  * This is the contructor method for the graph.
  * Its purpose is to initialize the necessary
@@ -31,7 +101,20 @@ using namespace std;
  *
  */
 ActorGraph::ActorGraph() {
-    this->ofActors = new unordered_map<string, ActorNode*>();
+    this->actorNames = new NameTable();
+    this->movieNames = new NameTable();
+    this->ofActorIds = new vector<ActorNode*>();
+    this->ofMovieIds = new vector<MovieNode*>();
+    this->ofCSR = nullptr;
+    this->ofSnapshot = nullptr;
+    this->ofArena = new Arena();
+    this->ofCollaborators = nullptr;
+    this->ofYearIndex = nullptr;
+    this->ofLabels = nullptr;
+    this->ofLandmarks = nullptr;
+    this->ofComponents = nullptr;
+    this->ofCompressed = nullptr;
+    this->ofCastBitsets = nullptr;
 }
 
 /* Build the actor graph from dataset file.
@@ -40,111 +123,350 @@ ActorGraph::ActorGraph() {
  * Two actors are connected by an undirected edge if they have worked in a movie
  * before.
  */
-bool ActorGraph::buildGraphFromFile(const char* filename) {
-    ifstream infile(filename);
-    bool readHeader = false;
+bool ActorGraph::buildGraphFromFile(const char* filename,
+                                    unsigned int numThreads) {
+    CastFileReader reader(filename);
 
-    // Store a list of exiting movie edges in the graph
-    unordered_map<string, MovieNode*>* movieList =
-        new unordered_map<string, MovieNode*>();
+    // if failed to read the file, clear the graph and return
+    if (!reader.isOpen()) {
+        cerr << "Failed to read " << filename << endl;
+        return false;
+    }
 
-    while (infile) {
-        string s;
-        if (!getline(infile, s)) break;
+    // A snapshot holds an already built graph. The bytes already read
+    // are checked, since a pipe cannot be read twice
+    if (GraphSnapshot::isSnapshot(reader.getData(), reader.getSize())) {
+        return this->loadSnapshot(filename, numThreads);
+    }
 
-        // skip the header of the file
-        if (!readHeader) {
-            readHeader = true;
-            continue;
-        }
+    // The rows of this file are added to those read before
+    this->thaw();
 
-        // read each line of the dataset to get the movie actor relation
-        istringstream ss(s);
-        vector<string> record;
-        while (ss) {
-            string str;
-            if (!getline(ss, str, '\t')) break;
-            record.push_back(str);
+    // Intern the names on several threads, then link the rows in order.
+    // The loader numbers the names from 0, so only into empty tables
+    if (numThreads > 1 && this->actorNames->size() == 0 &&
+        this->movieNames->size() == 0) {
+        vector<unsigned int> rowActors;
+        vector<unsigned int> rowMovies;
+        ParallelCastLoader loader(reader, numThreads);
+        loader.load(*this->actorNames, *this->movieNames, rowActors,
+                    rowMovies);
+        this->ofActorIds->reserve(this->actorNames->size());
+        this->ofMovieIds->reserve(this->movieNames->size());
+        for (size_t row = 0; row < rowActors.size(); row++) {
+            this->linkRow(rowActors[row], rowMovies[row]);
         }
+        this->freeze(numThreads);
+        return true;
+    }
 
-        // if format is wrong, skip current line
-        if (record.size() != 3) {
-            continue;
-        }
+    // The names are copied into these buffers, which keep their
+    // capacity, so looking up a known name allocates nothing
+    CastRow row;
+    string actor;
+    string title;
+    char yearDigits[16];
 
+    while (reader.nextRow(row)) {
         // extract the information
-        string actor(record[0]);
-        string title(record[1]);
-        int year = stoi(record[2]);
+        actor.assign(row.actor, row.actorLength);
+        title.assign(row.title, row.titleLength);
 
         // Add year to existing title
-        title = title + "#@" + to_string(year);
-
-        // Check if the actor and movie have not been added before
-        if (this->ofActors->find(actor) == this->ofActors->end() &&
-            movieList->find(title) == movieList->end()) {
-            // Makes a node for the actor and edge
-            auto ofCurrentActor = new ActorNode(actor);
-            auto ofCurrentMovie = new MovieNode(title);
-            // Links the movie and actor node.
-            ofCurrentActor->addMovie(ofCurrentMovie);
-            ofCurrentMovie->addActor(ofCurrentActor);
-            // Makes a pair to insert into hashtable
-            std::pair<string, ActorNode*> actorPair(actor, ofCurrentActor);
-            std::pair<string, MovieNode*> moviePair(title, ofCurrentMovie);
-            // Insert movie and actor to existing list of movies and actors
-            this->ofActors->insert(actorPair);
-            movieList->insert(moviePair);
-        }
-        // If the actor or the movie has not been created before
-        else if (this->ofActors->find(actor) == this->ofActors->end() ||
-                 movieList->find(title) == movieList->end()) {
-            // If the actor has not been created before
-            if (this->ofActors->find(actor) == this->ofActors->end()) {
-                // Create an actor node, get existing movie node
-                auto ofCurrentMovie = movieList->find(title)->second;
-                auto ofCurrentActor = new ActorNode(actor);
-                // Links said movie and actor
-                ofCurrentActor->addMovie(ofCurrentMovie);
-                ofCurrentMovie->addActor(ofCurrentActor);
-                // Adds actor to existing list of actors
-                std::pair<string, ActorNode*> actorPair(actor, ofCurrentActor);
-                this->ofActors->insert(actorPair);
+        int yearLength = snprintf(yearDigits, sizeof(yearDigits), "#@%d",
+                                  row.year);
+        title.append(yearDigits, yearLength);
+
+        // Look up the ids, new names get the next free id
+        this->linkRow(this->actorNames->intern(actor),
+                      this->movieNames->intern(title));
+    }
+
+    // Freeze the nodes into the arrays used by the searches
+    this->freeze(numThreads);
+
+    return true;
+}
+
+/*
+ * This method links an actor and a movie read
+ * from the same row, making their nodes if they
+ * have not been seen before.
+ *
+ * Parameters:
+ *  1) actorId - The id of the row's actor
+ *  2) movieId - The id of the row's movie
+ *
+ */
+void ActorGraph::linkRow(unsigned int actorId, unsigned int movieId) {
+    // If the actor has not been created before make its node
+    if (actorId == this->ofActorIds->size()) {
+        this->ofActorIds->push_back(this->ofArena->make<ActorNode>(
+            this->actorNames->getName(actorId), actorId, *this->ofArena));
+    }
+    // If the movie has not been created before make its node
+    if (movieId == this->ofMovieIds->size()) {
+        this->ofMovieIds->push_back(this->ofArena->make<MovieNode>(
+            this->movieNames->getName(movieId), movieId, *this->ofArena));
+    }
+
+    // Link said movie and actor
+    auto ofCurrentActor = this->ofActorIds->at(actorId);
+    auto ofCurrentMovie = this->ofMovieIds->at(movieId);
+    ofCurrentActor->addMovie(ofCurrentMovie);
+    ofCurrentMovie->addActor(ofCurrentActor);
+}
+
+/*
+ * This method makes the nodes of a frozen graph
+ * again from its CSR arrays, or its compressed
+ * lists, so that the rows of another file can be
+ * linked to them. A compressed graph is no longer
+ * compressed afterwards.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+void ActorGraph::thaw() {
+    // Nothing was read yet, or the nodes are not frozen
+    if ((this->ofCSR == nullptr && this->ofCompressed == nullptr) ||
+        !this->ofActorIds->empty()) {
+        return;
+    }
+    unsigned int numActors = this->actorNames->size();
+    unsigned int numMovies = this->movieNames->size();
+    this->ofActorIds->reserve(numActors);
+    this->ofMovieIds->reserve(numMovies);
+    for (unsigned int a = 0; a < numActors; a++) {
+        this->ofActorIds->push_back(this->ofArena->make<ActorNode>(
+            this->actorNames->getName(a), a, *this->ofArena));
+    }
+    for (unsigned int m = 0; m < numMovies; m++) {
+        this->ofMovieIds->push_back(this->ofArena->make<MovieNode>(
+            this->movieNames->getName(m), m, *this->ofArena));
+    }
+
+    // Each edge list gets back its order in the arrays
+    if (this->ofCSR != nullptr) {
+        const CSRGraph& graph = *this->ofCSR;
+        for (unsigned int a = 0; a < numActors; a++) {
+            for (auto movie = graph.moviesBegin(a);
+                 movie != graph.moviesEnd(a); movie++) {
+                (*this->ofActorIds)[a]->addMovie((*this->ofMovieIds)[*movie]);
             }
-            // If the actor exists but the movie does not
-            else {
-                // Make a node for the movie edge, get existing actor
-                auto ofCurrentMovie = new MovieNode(title);
-                auto ofCurrentActor = this->ofActors->find(actor)->second;
-                // Link actor and movie node.
-                ofCurrentActor->addMovie(ofCurrentMovie);
-                ofCurrentMovie->addActor(ofCurrentActor);
-                // Add new movie node to list of existing movies
-                std::pair<string, MovieNode*> moviePair(title, ofCurrentMovie);
-                movieList->insert(moviePair);
+        }
+        for (unsigned int m = 0; m < numMovies; m++) {
+            for (auto actor = graph.actorsBegin(m);
+                 actor != graph.actorsEnd(m); actor++) {
+                (*this->ofMovieIds)[m]->addActor((*this->ofActorIds)[*actor]);
             }
         }
-        // If both the movie and actor already have nodes
-        else {
-            // Get movie and actor nodes.
-            auto ofCurrentMovie = movieList->find(title)->second;
-            auto ofCurrentActor = this->ofActors->find(actor)->second;
-            // Link said nodes
-            ofCurrentActor->addMovie(ofCurrentMovie);
-            ofCurrentMovie->addActor(ofCurrentActor);
+        return;
+    }
+    const CompressedGraph& graph = *this->ofCompressed;
+    vector<unsigned int> ids(max(graph.getMaxMovies(), graph.getMaxCast()));
+    for (unsigned int a = 0; a < numActors; a++) {
+        unsigned int count = graph.getMovies(a, ids.data());
+        for (unsigned int i = 0; i < count; i++) {
+            (*this->ofActorIds)[a]->addMovie((*this->ofMovieIds)[ids[i]]);
+        }
+    }
+    for (unsigned int m = 0; m < numMovies; m++) {
+        unsigned int count = graph.getActors(m, ids.data());
+        for (unsigned int i = 0; i < count; i++) {
+            (*this->ofMovieIds)[m]->addActor((*this->ofActorIds)[ids[i]]);
         }
     }
+    delete this->ofCompressed;
+    this->ofCompressed = nullptr;
+}
 
-    delete movieList;
+/*
+ * This method loads a graph from a snapshot
+ * written by saveSnapshot. The snapshot is mapped
+ * and used in place, so no node is created.
+ * Returns false if it cannot be used.
+ *
+ * Parameters:
+ *  1) filename - The name of the snapshot file
+ *  2) numThreads - The number of threads labeling
+ *                  the components
+ *
+ */
+bool ActorGraph::loadSnapshot(const char* filename, unsigned int numThreads) {
+    GraphSnapshot* snapshot = new GraphSnapshot();
+    if (!snapshot->open(filename)) {
+        delete snapshot;
+        return false;
+    }
+    delete this->ofCSR;
+    delete this->ofSnapshot;
+    this->ofSnapshot = snapshot;
+    this->ofCSR = snapshot->makeGraph();
+    snapshot->mapNames(*this->actorNames, *this->movieNames);
+    delete this->ofComponents;
+    this->ofComponents = new ActorComponents(*this->ofCSR, numThreads);
+    this->buildCastBitsets(CastBitsets::DEFAULT_MIN_CAST);
+    return true;
+}
 
-    // if failed to read the file, clear the graph and return
-    if (!infile.eof()) {
-        cerr << "Failed to read " << filename << endl;
+/*
+ * This method writes a snapshot of the graph,
+ * which buildGraphFromFile and loadSnapshot can
+ * load much faster than the cast file. Returns
+ * false if the file could not be written.
+ *
+ * Parameters:
+ *  1) filename - The name of the snapshot file
+ *
+ */
+bool ActorGraph::saveSnapshot(const char* filename) {
+    if (this->ofCSR == nullptr) {
         return false;
     }
-    infile.close();
+    return GraphSnapshot::write(filename, *this->ofCSR, *this->actorNames,
+                                *this->movieNames);
+}
 
-    return true;
+/*
+ * This method renumbers the actors and movies so
+ * that co-stars sit close together in the CSR
+ * arrays. It must be called before the
+ * collaborators, year index, labels or landmarks
+ * are built.
+ *
+ * Parameters:
+ *  1) ordering - Which order to give the ids
+ *  2) numThreads - The number of threads labeling
+ *                  the components
+ *
+ */
+void ActorGraph::reorder(VertexOrdering ordering, unsigned int numThreads) {
+    VertexOrder order(*this->ofCSR, ordering);
+    CSRGraph* graph = new CSRGraph(*this->ofCSR, order.getActorOrder(),
+                                   order.getMovieOrder());
+
+    // Intern the names again, so each id still names its node
+    NameTable* actors = new NameTable();
+    actors->reserve(order.getActorOrder().size());
+    for (unsigned int oldId : order.getActorOrder()) {
+        actors->intern(this->actorNames->getName(oldId));
+    }
+    NameTable* movies = new NameTable();
+    movies->reserve(order.getMovieOrder().size());
+    for (unsigned int oldId : order.getMovieOrder()) {
+        movies->intern(this->movieNames->getName(oldId));
+    }
+
+    // The old tables and arrays may point into the snapshot
+    delete this->actorNames;
+    delete this->movieNames;
+    delete this->ofCSR;
+    delete this->ofSnapshot;
+    this->actorNames = actors;
+    this->movieNames = movies;
+    this->ofCSR = graph;
+    this->ofSnapshot = nullptr;
+    delete this->ofComponents;
+    this->ofComponents = new ActorComponents(*this->ofCSR, numThreads);
+    this->buildCastBitsets(this->ofCastBitsets->getMinCast());
+}
+
+/*
+ * This method swaps the CSR arrays for a compressed
+ * copy of them. Afterwards only BFS and predictLink by
+ * common neighbours may be used.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+void ActorGraph::compress() {
+    delete this->ofCompressed;
+    this->ofCompressed = new CompressedGraph(*this->ofCSR);
+    delete this->ofCSR;
+    this->ofCSR = nullptr;
+    delete this->ofCastBitsets;
+    this->ofCastBitsets = nullptr;
+}
+
+/*
+ * This method keeps the casts of the movies with
+ * at least minCast actors as bitsets, replacing
+ * any kept before. It must not be called while
+ * other threads search.
+ *
+ * Parameters:
+ *  1) minCast - The fewest actors a cast needs to
+ *               be kept as a bitset
+ *
+ */
+const CastBitsets& ActorGraph::buildCastBitsets(unsigned int minCast) {
+    delete this->ofCastBitsets;
+    this->ofCastBitsets = new CastBitsets(*this->ofCSR, minCast);
+    return *this->ofCastBitsets;
+}
+
+/*
+ * This method freezes the nodes of the graph
+ * into the contiguous CSR arrays used by the
+ * searches, and labels their components. It is
+ * called once the whole file has been read, and
+ * frees the nodes once they are frozen.
+ *
+ * Parameters:
+ *  1) numThreads - The number of threads labeling
+ *                  the components
+ *
+ */
+void ActorGraph::freeze(unsigned int numThreads) {
+    // The year is the number after the last "#@" of each movie's name
+    vector<int> years(this->movieNames->size());
+    for (unsigned int m = 0; m < years.size(); m++) {
+        const char* yearMark = this->movieNames->getName(m);
+        for (const char* next = yearMark; next != nullptr;
+             next = strstr(next + 2, "#@")) {
+            yearMark = next;
+        }
+        years[m] = atoi(yearMark + 2);
+    }
+    delete this->ofCSR;
+    this->ofCSR = new CSRGraph(*this->ofActorIds, *this->ofMovieIds, years);
+    // The nodes and their edge lists are only needed to build the CSR
+    vector<ActorNode*>().swap(*this->ofActorIds);
+    vector<MovieNode*>().swap(*this->ofMovieIds);
+    delete this->ofArena;
+    this->ofArena = new Arena();
+    delete this->ofComponents;
+    this->ofComponents = new ActorComponents(*this->ofCSR, numThreads);
+    this->buildCastBitsets(CastBitsets::DEFAULT_MIN_CAST);
+}
+
+/*
+ * This method writes a path in the
+ * (actor)--[movie#@year]-->(actor) format.
+ *
+ * Parameters:
+ *  1) actorIds - The actors on the path, in order
+ *  2) movieIds - The movies linking each actor to
+ *                the next one on the path
+ *  3) shortestPath - The string the path is written to
+ *
+ */
+void ActorGraph::writePath(const vector<unsigned int>& actorIds,
+                           const vector<unsigned int>& movieIds,
+                           string& shortestPath) {
+    shortestPath = "(";
+    shortestPath += this->actorNames->getName(actorIds[0]);
+    shortestPath += ")";
+    for (unsigned int i = 0; i < movieIds.size(); i++) {
+        shortestPath += "--[";
+        shortestPath += this->movieNames->getName(movieIds[i]);
+        shortestPath += "]-->(";
+        shortestPath += this->actorNames->getName(actorIds[i + 1]);
+        shortestPath += ")";
+    }
 }
 
 /*
@@ -156,6 +478,10 @@ bool ActorGraph::buildGraphFromFile(const char* filename) {
  * Parameters:
  *  1) fromActor - The vertex from which to start
  *  2) toActor - The vertex we want to end at
+ *  3) shortestPath - The string the path is written to
+ *  4) search - How to search, see PathSearch
+ *  5) years - Only the movies of these years may be
+ *             used
  *
  * Sources used:
  *  1) CSE 100 Lecture slides
@@ -167,104 +493,1074 @@ bool ActorGraph::buildGraphFromFile(const char* filename) {
  * Edge Cases:
  *  1) The actors do not exists - return
  *  2) The input is empty - return
+ *  3) The actors are in different components - return
  *
  */
 void ActorGraph::BFS(const string& fromActor, const string& toActor,
-                     string& shortestPath) {
+                     string& shortestPath, PathSearch search,
+                     const YearRange& years) {
     // Edge case: string inputted are empty
     if (fromActor.size() == 0 || toActor.size() == 0) {
         return;
     }
     // Edge case: One of the actors or both are not in the graph
-    if (this->ofActors->find(fromActor) == this->ofActors->end() ||
-        this->ofActors->find(toActor) == this->ofActors->end()) {
+    unsigned int fromId = this->actorNames->find(fromActor);
+    unsigned int toId = this->actorNames->find(toActor);
+    if (fromId == NameTable::NO_ID || toId == NameTable::NO_ID) {
         return;
     }
-    queue<ActorNode*>* ofNodes = new queue<ActorNode*>();
-    // End node
-    auto endNode = this->ofActors->find(toActor)->second;
-    // List of visited actors and movies
-    unordered_set<string>* ofVisitedActors = new unordered_set<string>();
-    unordered_set<string>* ofVisitedMovies = new unordered_set<string>();
-    // Push the starting vertex
-    ofNodes->push(this->ofActors->find(fromActor)->second);
-    ActorNode* ofCurrentNode = nullptr;
-    auto startNode = this->ofActors->find(fromActor)->second;
-    // While the queue is not empty
-    while (ofNodes->size() > 0) {
-        // Get the first element in queue and remove it
-        ofCurrentNode = ofNodes->front();
-        ofNodes->pop();
+    // Edge case: No path leaves the component of the first actor
+    if (!this->ofComponents->areConnected(fromId, toId)) {
+        return;
+    }
+    // Only touch the names once a path has been found
+    vector<unsigned int> actorIds;
+    vector<unsigned int> movieIds;
+    bool found = false;
+    if (this->ofCompressed != nullptr) {
+        found = this->findPathCompressed(fromId, toId, actorIds, movieIds);
+    } else if (!years.isAll()) {
+        found = this->findPathInYears(fromId, toId, years, actorIds, movieIds);
+    } else if (search == BIDIRECTIONAL_SEARCH) {
+        found = this->findPathBidirectional(fromId, toId, actorIds, movieIds);
+    } else if (search == HYBRID_SEARCH) {
+        found = this->findPathHybrid(fromId, toId, actorIds, movieIds);
+    } else if (search == INDEXED_SEARCH) {
+        found = this->findPathIndexed(fromId, toId, actorIds, movieIds);
+    } else if (search == LANDMARK_SEARCH) {
+        found = this->findPathLandmarks(fromId, toId, actorIds, movieIds);
+    } else if (search == WEIGHTED_SEARCH) {
+        found = this->findPathWeighted(fromId, toId, actorIds, movieIds);
+    } else if (search == PROJECTED_SEARCH) {
+        this->getCollaborators();
+        found = this->findPathProjected(fromId, toId, actorIds, movieIds);
+    } else {
+        found = this->findPath(fromId, toId, actorIds, movieIds);
+    }
+    if (found) {
+        this->writePath(actorIds, movieIds, shortestPath);
+    }
+}
+
+/*
+ * This method finds a shortest path for every pair
+ * of actors in a batch. Pairs are grouped by their
+ * first actor, and up to 64 first actors are searched
+ * at once by a multi source BFS.
+ *
+ * Parameters:
+ *  1) actorPairs - The (fromActor, toActor) pairs
+ *  2) shortestPaths - Filled with one path per pair,
+ *                     in the same order
+ *  3) numThreads - The number of threads that take
+ *                  batches of first actors in turn
+ *
+ */
+void ActorGraph::BFS(const vector<pair<string, string>>& actorPairs,
+                     vector<string>& shortestPaths, unsigned int numThreads) {
+    shortestPaths.assign(actorPairs.size(), "");
+
+    // Group the pairs by their first actor, in order of first use
+    vector<unsigned int> sources;
+    vector<vector<size_t>> pairsOfSource;
+    unordered_map<unsigned int, unsigned int> sourceIndex;
+    for (size_t i = 0; i < actorPairs.size(); i++) {
+        unsigned int fromId = this->actorNames->find(actorPairs[i].first);
+        unsigned int toId = this->actorNames->find(actorPairs[i].second);
+        // Edge case: One of the actors or both are not in the graph,
+        // or no path links them
+        if (fromId == NameTable::NO_ID || toId == NameTable::NO_ID ||
+            !this->ofComponents->areConnected(fromId, toId)) {
+            continue;
+        }
+        auto entry = sourceIndex.insert(make_pair(fromId, sources.size()));
+        if (entry.second) {
+            sources.push_back(fromId);
+            pairsOfSource.push_back(vector<size_t>());
+        }
+        pairsOfSource[entry.first->second].push_back(i);
+    }
+
+    // Each thread searches from one batch of sources at a time
+    atomic<size_t> nextBatch(0);
+    auto searchBatches = [&]() {
+        MultiSourceBFS search(this->ofCSR);
+        vector<unsigned int> batch;
+        vector<pair<unsigned int, unsigned int>> queries;
+        vector<unsigned int> actorIds;
+        vector<unsigned int> movieIds;
+        while (true) {
+            size_t first = MultiSourceBFS::MAX_SOURCES * nextBatch++;
+            if (first >= sources.size()) {
+                return;
+            }
+            size_t last =
+                min(sources.size(), first + MultiSourceBFS::MAX_SOURCES);
+            batch.assign(sources.begin() + first, sources.begin() + last);
+            queries.clear();
+            for (size_t s = first; s < last; s++) {
+                for (size_t i : pairsOfSource[s]) {
+                    unsigned int toId =
+                        this->actorNames->find(actorPairs[i].second);
+                    queries.push_back(make_pair(s - first, toId));
+                }
+            }
+            search.run(batch, queries);
+
+            // Only touch the names once the paths have been found
+            for (size_t s = first; s < last; s++) {
+                for (size_t i : pairsOfSource[s]) {
+                    unsigned int toId =
+                        this->actorNames->find(actorPairs[i].second);
+                    if (search.getPath(s - first, toId, actorIds,
+                                       movieIds)) {
+                        this->writePath(actorIds, movieIds, shortestPaths[i]);
+                    }
+                }
+            }
+        }
+    };
+    vector<thread> workers;
+    for (unsigned int t = 1; t < numThreads; t++) {
+        workers.push_back(thread(searchBatches));
+    }
+    searchBatches();
+    for (unsigned int t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+}
+
+/*
+ * This function walks the previous links of a
+ * search back from an actor to the start, and
+ * writes the path between them.
+ *
+ * Parameters:
+ *  1) workspace - The workspace of the search
+ *  2) fromId - The actor the search started from
+ *  3) toId - The reached actor the path ends at
+ *  4) actorIds - Filled with the actors on the path
+ *  5) movieIds - Filled with the movies between them
+ *
+ */
+static void walkBack(const SearchWorkspace& workspace, unsigned int fromId,
+                     unsigned int toId, vector<unsigned int>& actorIds,
+                     vector<unsigned int>& movieIds) {
+    unsigned int current = toId;
+    actorIds.push_back(current);
+    while (current != fromId) {
+        movieIds.push_back(workspace.getPrevMovie(current));
+        current = workspace.getPrevActor(current);
+        actorIds.push_back(current);
+    }
+    reverse(actorIds.begin(), actorIds.end());
+    reverse(movieIds.begin(), movieIds.end());
+}
+
+/*
+ * This method finds a shortest path between two
+ * actors given by id. It does so using a BFS over
+ * the CSR arrays, so it never looks at a name.
+ * The casts kept as bitsets are reached a word at
+ * a time.
+ *
+ * Parameters:
+ *  1) fromId - The actor from which to start
+ *  2) toId - The actor we want to end at
+ *  3) actorIds - Filled with the actors on the path
+ *  4) movieIds - Filled with the movies between them
+ *
+ */
+bool ActorGraph::findPath(unsigned int fromId, unsigned int toId,
+                          vector<unsigned int>& actorIds,
+                          vector<unsigned int>& movieIds) {
+    actorIds.clear();
+    movieIds.clear();
+    // Reuse this thread's visited marks and queue
+    SearchWorkspace& workspace = SearchWorkspace::forThread();
+    workspace.startSearch(this->ofCSR->numActors(), this->ofCSR->numMovies());
+    // Queue of actors to explore, read from head to tail
+    vector<unsigned int>& ofNodes = workspace.getFrontier();
+    ofNodes.push_back(fromId);
+    workspace.reachActor(fromId, fromId, CSRGraph::NO_ID);
+    // Casts this large may be kept as bitsets, see CastBitsets
+    unsigned int minCast = this->ofCastBitsets->getMinCast();
+    // The bitmap of the reached actors, once a bitset is used
+    uint64_t* reachedBits = nullptr;
+    for (size_t head = 0; head < ofNodes.size(); head++) {
+        unsigned int current = ofNodes[head];
         // If the current vertex is the destination we want
-        if (ofCurrentNode->getActorName() == toActor) {
-            // Gets the previous node of path
-            auto ofCurrPrev = ofCurrentNode->getPrevious();
-            // Creates a string representing current path
-            shortestPath = "(" + ofCurrentNode->getActorName() + ")";
-            // Loop through the whole path taken
-            while (ofCurrentNode != startNode) {
-                // Use a series of string concatenations in order to output path
-                string ofActor = "(" + ofCurrPrev.first->getActorName() + ")";
-                ofActor = ofActor + "--";
-                string ofMovie = "[" + ofCurrPrev.second->getMovieName() + "]";
-                ofActor = ofActor + ofMovie + "-->";
-                ofActor = ofActor + shortestPath;
-                shortestPath = ofActor;
-                // Move back in the path once at a time
-                ofCurrentNode = ofCurrentNode->getPrevious().first;
-                ofCurrPrev = ofCurrentNode->getPrevious();
+        if (current == toId) {
+            walkBack(workspace, fromId, toId, actorIds, movieIds);
+            return true;
+        }
+        // Go through all the edges of the current vertex
+        for (auto movie = this->ofCSR->moviesBegin(current);
+             movie != this->ofCSR->moviesEnd(current); movie++) {
+            // Skip the edges that have been visited
+            if (!workspace.visitMovie(*movie)) {
+                continue;
+            }
+            const unsigned int* castBegin = this->ofCSR->actorsBegin(*movie);
+            const unsigned int* castEnd = this->ofCSR->actorsEnd(*movie);
+            unsigned int bitset = CastBitsets::NO_BITSET;
+            if ((size_t)(castEnd - castBegin) >= minCast) {
+                bitset = this->ofCastBitsets->find(*movie);
+            }
+            // Reach a whole large cast a word at a time
+            if (bitset != CastBitsets::NO_BITSET) {
+                // The bitmap is only kept once a large cast is reached,
+                // so it starts with every actor queued so far
+                if (reachedBits == nullptr) {
+                    reachedBits =
+                        workspace.clearActorBits(this->ofCSR->numActors());
+                    for (unsigned int actor : ofNodes) {
+                        reachedBits[actor / 64] |= 1ull << (actor % 64);
+                    }
+                }
+                const CastBitsets& bitsets = *this->ofCastBitsets;
+                const uint64_t* cast = bitsets.getWords(bitset);
+                unsigned int first = bitsets.getFirstWord(bitset);
+                size_t numWords = bitsets.getNumWords(bitset);
+                // A cast with the destination ends the search at once,
+                // with the same path as reaching it later would give
+                size_t toWord = toId / 64 - first;
+                if (toId / 64 >= first && toWord < numWords &&
+                    (cast[toWord] >> (toId % 64) & 1) != 0 &&
+                    !workspace.hasActor(toId)) {
+                    workspace.reachActor(toId, current, *movie);
+                    walkBack(workspace, fromId, toId, actorIds, movieIds);
+                    return true;
+                }
+                for (size_t w = 0; w < numWords; w++) {
+                    uint64_t fresh = cast[w] & ~reachedBits[first + w];
+                    reachedBits[first + w] |= fresh;
+                    while (fresh != 0) {
+                        unsigned int actor =
+                            (first + w) * 64 + __builtin_ctzll(fresh);
+                        workspace.reachActor(actor, current, *movie);
+                        ofNodes.push_back(actor);
+                        fresh &= fresh - 1;
+                    }
+                }
+                continue;
+            }
+            // Reach every actor linked by that edge
+            for (auto actor = castBegin; actor != castEnd; actor++) {
+                if (!workspace.hasActor(*actor)) {
+                    workspace.reachActor(*actor, current, *movie);
+                    ofNodes.push_back(*actor);
+                    if (reachedBits != nullptr) {
+                        reachedBits[*actor / 64] |= 1ull << (*actor % 64);
+                    }
+                }
             }
-            // Finish, we found the node we wanted
-            break;
         }
-        // Mark vertex as visited
-        ofVisitedActors->insert(ofCurrentNode->getActorName());
-        // Make a vector of all the possible edges
-        vector<MovieNode*> ofEdges = vector<MovieNode*>();
-        // Get all the edges of current vertex.
-        auto ofMovies = ofCurrentNode->inMovies();
-        for (int i = 0; i < ofMovies->size(); i++) {
-            // Get the current edge
-            auto currentMovie = ofMovies->at(i);
-            // If the edge has not been visited
-            if (ofVisitedMovies->find(currentMovie->getMovieName()) ==
-                ofVisitedMovies->end()) {
-                // Mark movie node as visited
-                ofVisitedMovies->insert(currentMovie->getMovieName());
-                // Get all the actors linked to that edge vertex
-                auto actorVector = currentMovie->actorsInMovie();
-                for (int j = 0; j < actorVector->size(); j++) {
-                    // Get current actor vertex
-                    auto currActorEdge = actorVector->at(j);
-                    // If the actor vertex has not been visited
-                    if (ofVisitedActors->find(currActorEdge->getActorName()) ==
-                        ofVisitedActors->end()) {
-                        // Mark vertex as visited
-                        pair<ActorNode*, MovieNode*> ofPrevious(ofCurrentNode,
-                                                                currentMovie);
-                        currActorEdge->setPrevious(ofPrevious);
-                        ofVisitedActors->insert(currActorEdge->getActorName());
-                        // Add actor vertex to exiting queue.
-                        ofNodes->push(currActorEdge);
+    }
+    return false;
+}
+
+/*
+ * This method finds a shortest path between two
+ * actors given by id by growing one BFS from each
+ * end. Each round expands a whole level of the side
+ * with the smaller frontier, and the search stops
+ * as soon as an actor is reached by both sides.
+ *
+ * Parameters:
+ *  1) fromId - The actor from which to start
+ *  2) toId - The actor we want to end at
+ *  3) actorIds - Filled with the actors on the path
+ *  4) movieIds - Filled with the movies between them
+ *
+ */
+bool ActorGraph::findPathBidirectional(unsigned int fromId, unsigned int toId,
+                                       vector<unsigned int>& actorIds,
+                                       vector<unsigned int>& movieIds) {
+    actorIds.clear();
+    movieIds.clear();
+    // Edge case: the path is a single actor
+    if (fromId == toId) {
+        actorIds.push_back(fromId);
+        return true;
+    }
+    // Side 0 grows from fromId and side 1 grows from toId, each in
+    // its own workspace of this thread
+    SearchWorkspace* sides[2] = {&SearchWorkspace::forThread(0),
+                                 &SearchWorkspace::forThread(1)};
+    for (int side = 0; side < 2; side++) {
+        sides[side]->startSearch(this->ofCSR->numActors(),
+                                 this->ofCSR->numMovies());
+    }
+    sides[0]->reachActor(fromId, fromId, CSRGraph::NO_ID);
+    sides[0]->getFrontier().push_back(fromId);
+    sides[1]->reachActor(toId, toId, CSRGraph::NO_ID);
+    sides[1]->getFrontier().push_back(toId);
+    unsigned int meetId = CSRGraph::NO_ID;
+
+    // Stop once the sides meet or one of them runs out of actors
+    while (meetId == CSRGraph::NO_ID && !sides[0]->getFrontier().empty() &&
+           !sides[1]->getFrontier().empty()) {
+        // Expand one whole level of the smaller side
+        int side = sides[0]->getFrontier().size() <=
+                           sides[1]->getFrontier().size()
+                       ? 0
+                       : 1;
+        SearchWorkspace& ours = *sides[side];
+        SearchWorkspace& theirs = *sides[1 - side];
+        vector<unsigned int>& frontier = ours.getFrontier();
+        vector<unsigned int>& nextFrontier = ours.getNextFrontier();
+        nextFrontier.clear();
+        for (size_t i = 0; i < frontier.size(); i++) {
+            unsigned int current = frontier[i];
+            for (auto movie = this->ofCSR->moviesBegin(current);
+                 movie != this->ofCSR->moviesEnd(current); movie++) {
+                if (!ours.visitMovie(*movie)) {
+                    continue;
+                }
+                for (auto actor = this->ofCSR->actorsBegin(*movie);
+                     actor != this->ofCSR->actorsEnd(*movie); actor++) {
+                    if (ours.hasActor(*actor)) {
+                        continue;
                     }
+                    ours.reachActor(*actor, current, *movie);
+                    nextFrontier.push_back(*actor);
+                    // The first actor seen by both sides is on a
+                    // shortest path, since the other side has only
+                    // reached actors up to its own frontier
+                    if (theirs.hasActor(*actor)) {
+                        meetId = *actor;
+                        break;
+                    }
+                }
+                if (meetId != CSRGraph::NO_ID) break;
+            }
+            if (meetId != CSRGraph::NO_ID) break;
+        }
+        frontier.swap(nextFrontier);
+    }
+    if (meetId == CSRGraph::NO_ID) {
+        return false;
+    }
+
+    // Walk back from the meeting actor to the start
+    unsigned int current = meetId;
+    actorIds.push_back(current);
+    while (current != fromId) {
+        movieIds.push_back(sides[0]->getPrevMovie(current));
+        current = sides[0]->getPrevActor(current);
+        actorIds.push_back(current);
+    }
+    reverse(actorIds.begin(), actorIds.end());
+    reverse(movieIds.begin(), movieIds.end());
+    // Then walk forward from the meeting actor to the end
+    current = meetId;
+    while (current != toId) {
+        movieIds.push_back(sides[1]->getPrevMovie(current));
+        current = sides[1]->getPrevActor(current);
+        actorIds.push_back(current);
+    }
+    return true;
+}
+
+/*
+ * This method finds a shortest path between two
+ * actors given by id. It does so using a BFS over
+ * the collaborator graph, which goes from actor to
+ * actor without the movies, and then picks a movie
+ * for each step of the path.
+ *
+ * Parameters:
+ *  1) fromId - The actor from which to start
+ *  2) toId - The actor we want to end at
+ *  3) actorIds - Filled with the actors on the path
+ *  4) movieIds - Filled with the movies between them
+ *
+ */
+bool ActorGraph::findPathProjected(unsigned int fromId, unsigned int toId,
+                                   vector<unsigned int>& actorIds,
+                                   vector<unsigned int>& movieIds) {
+    actorIds.clear();
+    movieIds.clear();
+    const CollaboratorGraph& graph = *this->ofCollaborators;
+    SearchWorkspace& workspace = SearchWorkspace::forThread();
+    workspace.startSearch(this->ofCSR->numActors(), this->ofCSR->numMovies());
+    vector<unsigned int>& ofNodes = workspace.getFrontier();
+    ofNodes.push_back(fromId);
+    workspace.reachActor(fromId, fromId, CSRGraph::NO_ID);
+    // Stop as soon as the destination is reached
+    for (size_t head = 0; head < ofNodes.size() && !workspace.hasActor(toId);
+         head++) {
+        unsigned int current = ofNodes[head];
+        for (auto actor = graph.begin(current); actor != graph.end(current);
+             actor++) {
+            if (!workspace.hasActor(*actor)) {
+                workspace.reachActor(*actor, current, CSRGraph::NO_ID);
+                ofNodes.push_back(*actor);
+            }
+        }
+    }
+    if (!workspace.hasActor(toId)) {
+        return false;
+    }
+
+    // Walk the previous links back to the start
+    unsigned int current = toId;
+    actorIds.push_back(current);
+    while (current != fromId) {
+        current = workspace.getPrevActor(current);
+        actorIds.push_back(current);
+    }
+    reverse(actorIds.begin(), actorIds.end());
+    // Each step takes the first movie of its actor with the next one
+    for (size_t i = 0; i + 1 < actorIds.size(); i++) {
+        movieIds.push_back(
+            this->ofCSR->sharedMovie(actorIds[i], actorIds[i + 1]));
+    }
+    return true;
+}
+
+/*
+ * This method finds a shortest path between two
+ * actors given by id. It does so using a BFS over
+ * the compressed lists, decoding each list as it
+ * is reached. Returns false if there is no path.
+ *
+ * Parameters:
+ *  1) fromId - The actor from which to start
+ *  2) toId - The actor we want to end at
+ *  3) actorIds - Filled with the actors on the path
+ *  4) movieIds - Filled with the movies between them
+ *
+ */
+bool ActorGraph::findPathCompressed(unsigned int fromId, unsigned int toId,
+                                    vector<unsigned int>& actorIds,
+                                    vector<unsigned int>& movieIds) {
+    actorIds.clear();
+    movieIds.clear();
+    const CompressedGraph& graph = *this->ofCompressed;
+    // Each thread decodes the lists into its own buffers
+    static thread_local vector<unsigned int> movieBuffer;
+    static thread_local vector<unsigned int> castBuffer;
+    movieBuffer.resize(graph.getMaxMovies());
+    castBuffer.resize(graph.getMaxCast());
+    unsigned int* movies = movieBuffer.data();
+    unsigned int* cast = castBuffer.data();
+
+    SearchWorkspace& workspace = SearchWorkspace::forThread();
+    workspace.startSearch(graph.numActors(), graph.numMovies());
+    vector<unsigned int>& ofNodes = workspace.getFrontier();
+    ofNodes.push_back(fromId);
+    workspace.reachActor(fromId, fromId, CSRGraph::NO_ID);
+    for (size_t head = 0; head < ofNodes.size(); head++) {
+        unsigned int current = ofNodes[head];
+        if (current == toId) {
+            walkBack(workspace, fromId, toId, actorIds, movieIds);
+            return true;
+        }
+        unsigned int numMovies = graph.getMovies(current, movies);
+        for (unsigned int i = 0; i < numMovies; i++) {
+            if (!workspace.visitMovie(movies[i])) {
+                continue;
+            }
+            // Only the casts of the movies not seen yet are decoded
+            unsigned int castSize = graph.getActors(movies[i], cast);
+            for (unsigned int j = 0; j < castSize; j++) {
+                if (!workspace.hasActor(cast[j])) {
+                    workspace.reachActor(cast[j], current, movies[i]);
+                    ofNodes.push_back(cast[j]);
                 }
             }
         }
     }
-    delete ofNodes;
-    delete ofVisitedActors;
-    delete ofVisitedMovies;
-    return;
+    return false;
+}
+
+/*
+ * This method finds a shortest path between two
+ * actors given by id. It does so using a BFS that
+ * keeps its frontiers as bitmaps and expands each
+ * step top down or bottom up.
+ *
+ * Parameters:
+ *  1) fromId - The actor from which to start
+ *  2) toId - The actor we want to end at
+ *  3) actorIds - Filled with the actors on the path
+ *  4) movieIds - Filled with the movies between them
+ *
+ */
+bool ActorGraph::findPathHybrid(unsigned int fromId, unsigned int toId,
+                                vector<unsigned int>& actorIds,
+                                vector<unsigned int>& movieIds) {
+    HybridBFS& search = HybridBFS::forThread();
+    search.run(*this->ofCSR, fromId, toId);
+    return search.getPath(toId, actorIds, movieIds);
+}
+
+/*
+ * This method finds the number of movies between
+ * an actor and every actor of the graph.
+ *
+ * Parameters:
+ *  1) sourceId - The actor to start from
+ *  2) distances - Filled with the distance of every
+ *                 actor by id
+ *
+ */
+void ActorGraph::actorDistances(unsigned int sourceId,
+                                vector<unsigned int>& distances) {
+    HybridBFS& search = HybridBFS::forThread();
+    search.run(*this->ofCSR, sourceId);
+    distances.resize(this->ofCSR->numActors());
+    for (unsigned int a = 0; a < distances.size(); a++) {
+        distances[a] = search.getLevel(a);
+    }
+}
+
+/*
+ * This method finds the number of movies between
+ * a center actor and every actor of the graph, with
+ * one BFS whose levels are spread over threads.
+ * Returns false if the center is unknown or the
+ * graph is compressed.
+ *
+ * Parameters:
+ *  1) centerActor - The name of the actor at the
+ *                   center
+ *  2) numbers - Filled with the distance of every
+ *               actor, their histogram and the
+ *               farthest actors
+ *  3) numThreads - The number of threads to use
+ *
+ */
+bool ActorGraph::baconNumbers(const string& centerActor,
+                              BaconNumbers& numbers, unsigned int numThreads) {
+    unsigned int centerId = this->actorNames->find(centerActor);
+    if (centerId == NameTable::NO_ID || this->ofCSR == nullptr) {
+        return false;
+    }
+    numbers.run(*this->ofCSR, centerId, numThreads);
+    return true;
 }
 
 /*
- * This method tries to predict a link between actors.
- * Not implemented.
+ * This method estimates how many pairs of actors
+ * are each number of movies apart, over the whole
+ * graph, with a HyperLogLog counter per actor.
+ * Returns false if the graph is compressed.
+ *
+ * Parameters:
+ *  1) distribution - Filled with the estimates; its
+ *                    counters size is kept
+ *  2) numThreads - The number of threads to use
+ *
+ */
+bool ActorGraph::distanceDistribution(DistanceDistribution& distribution,
+                                      unsigned int numThreads) {
+    if (this->ofCSR == nullptr) {
+        return false;
+    }
+    distribution.run(*this->ofCSR, numThreads);
+    return true;
+}
+
+/*
+ * This method finds a shortest path between two
+ * actors given by id from their distance labels,
+ * or by findPath if they are too far apart for the
+ * labels.
+ *
+ * Parameters:
+ *  1) fromId - The actor from which to start
+ *  2) toId - The actor we want to end at
+ *  3) actorIds - Filled with the actors on the path
+ *  4) movieIds - Filled with the movies between them
+ *
+ */
+bool ActorGraph::findPathIndexed(unsigned int fromId, unsigned int toId,
+                                 vector<unsigned int>& actorIds,
+                                 vector<unsigned int>& movieIds) {
+    const PrunedLabelIndex& labels = this->buildLabels();
+    if (labels.getPath(*this->ofCSR, fromId, toId, actorIds, movieIds)) {
+        return true;
+    }
+    // Actors past MAX_DISTANCE have no common hub
+    if (!this->ofComponents->areConnected(fromId, toId)) {
+        return false;
+    }
+    return this->findPath(fromId, toId, actorIds, movieIds);
+}
+
+/*
+ * This method finds a shortest path as long as
+ * the one of findPath, but does not expand the
+ * actors that the landmark bounds show are too far
+ * from the second actor to be on a shortest path,
+ * and stops as soon as the second actor is reached.
+ *
+ * Parameters:
+ *  1) fromId - The actor from which to start
+ *  2) toId - The actor we want to end at
+ *  3) actorIds - Filled with the actors on the path
+ *  4) movieIds - Filled with the movies between them
+ *
+ */
+bool ActorGraph::findPathLandmarks(unsigned int fromId, unsigned int toId,
+                                   vector<unsigned int>& actorIds,
+                                   vector<unsigned int>& movieIds) {
+    actorIds.clear();
+    movieIds.clear();
+    if (!this->ofComponents->areConnected(fromId, toId)) {
+        return false;
+    }
+    const LandmarkOracle& landmarks = this->buildLandmarks();
+    unsigned int lower;
+    unsigned int upper;
+    landmarks.bounds(fromId, toId, lower, upper);
+    SearchWorkspace& workspace = SearchWorkspace::forThread();
+    workspace.startSearch(this->ofCSR->numActors(), this->ofCSR->numMovies());
+    vector<unsigned int>& ofNodes = workspace.getFrontier();
+    ofNodes.push_back(fromId);
+    workspace.reachActor(fromId, fromId, CSRGraph::NO_ID);
+    // The actors of the queue from levelEnd on are one level further
+    unsigned int level = 0;
+    size_t levelEnd = 1;
+    bool isFound = fromId == toId;
+    for (size_t head = 0; !isFound && head < ofNodes.size(); head++) {
+        if (head == levelEnd) {
+            level++;
+            levelEnd = ofNodes.size();
+        }
+        unsigned int current = ofNodes[head];
+        // A shortest path is at most upper movies long, so an actor
+        // that cannot be closer to toId is not expanded
+        if (upper != LandmarkOracle::NO_DISTANCE &&
+            level + landmarks.lowerBound(current, toId) > upper) {
+            continue;
+        }
+        for (auto movie = this->ofCSR->moviesBegin(current);
+             !isFound && movie != this->ofCSR->moviesEnd(current); movie++) {
+            if (!workspace.visitMovie(*movie)) {
+                continue;
+            }
+            for (auto actor = this->ofCSR->actorsBegin(*movie);
+                 actor != this->ofCSR->actorsEnd(*movie); actor++) {
+                if (workspace.hasActor(*actor)) {
+                    continue;
+                }
+                // The first link to an actor is on a shortest path to
+                // it, so the path is done once toId is reached
+                workspace.reachActor(*actor, current, *movie);
+                if (*actor == toId) {
+                    isFound = true;
+                    break;
+                }
+                ofNodes.push_back(*actor);
+            }
+        }
+    }
+    if (!isFound) {
+        return false;
+    }
+    walkBack(workspace, fromId, toId, actorIds, movieIds);
+    return true;
+}
+
+/*
+ * This method bounds the number of movies between
+ * two actors given by name using the landmarks.
+ *
+ * Parameters:
+ *  1) fromActor - The first actor
+ *  2) toActor - The second actor
+ *  3) lower - Set to the lower bound
+ *  4) upper - Set to the upper bound
+ *
+ */
+bool ActorGraph::distanceBounds(const string& fromActor,
+                                const string& toActor, unsigned int& lower,
+                                unsigned int& upper) {
+    unsigned int fromId = this->actorNames->find(fromActor);
+    unsigned int toId = this->actorNames->find(toActor);
+    if (fromId == NameTable::NO_ID || toId == NameTable::NO_ID) {
+        return false;
+    }
+    this->buildLandmarks().bounds(fromId, toId, lower, upper);
+    return true;
+}
+
+/*
+ * This method finds a shortest path between two
+ * actors given by id that only uses the movies of
+ * a range of years. It does so using a BFS that
+ * reads the movies of each actor from the year
+ * index. An actor without a movie in the range has
+ * no path, not even to itself.
+ *
+ * Parameters:
+ *  1) fromId - The actor from which to start
+ *  2) toId - The actor we want to end at
+ *  3) years - The years of the movies to use
+ *  4) actorIds - Filled with the actors on the path
+ *  5) movieIds - Filled with the movies between them
+ *
+ */
+bool ActorGraph::findPathInYears(unsigned int fromId, unsigned int toId,
+                                 const YearRange& years,
+                                 vector<unsigned int>& actorIds,
+                                 vector<unsigned int>& movieIds) {
+    actorIds.clear();
+    movieIds.clear();
+    const MovieYearIndex& index = this->buildYearIndex();
+    // The actor is not in the graph of these years, like an unknown one
+    if (index.moviesBegin(fromId, years) == index.moviesEnd(fromId, years)) {
+        return false;
+    }
+    SearchWorkspace& workspace = SearchWorkspace::forThread();
+    workspace.startSearch(this->ofCSR->numActors(), this->ofCSR->numMovies());
+    vector<unsigned int>& ofNodes = workspace.getFrontier();
+    ofNodes.push_back(fromId);
+    workspace.reachActor(fromId, fromId, CSRGraph::NO_ID);
+    for (size_t head = 0; head < ofNodes.size(); head++) {
+        unsigned int current = ofNodes[head];
+        if (current == toId) {
+            walkBack(workspace, fromId, toId, actorIds, movieIds);
+            return true;
+        }
+        // Only the movies of the range are between these bounds
+        const unsigned int* last = index.moviesEnd(current, years);
+        for (auto movie = index.moviesBegin(current, years); movie < last;
+             movie++) {
+            if (!workspace.visitMovie(*movie)) {
+                continue;
+            }
+            for (auto actor = this->ofCSR->actorsBegin(*movie);
+                 actor != this->ofCSR->actorsEnd(*movie); actor++) {
+                if (!workspace.hasActor(*actor)) {
+                    workspace.reachActor(*actor, current, *movie);
+                    ofNodes.push_back(*actor);
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/*
+ * This method finds the cheapest path between two
+ * actors given by id, where each movie costs its
+ * getMovieWeight. It does so using Dijkstra's
+ * algorithm with a binary heap of movies, so each
+ * movie is pushed once and no key is ever decreased.
+ *
+ * Parameters:
+ *  1) fromId - The actor from which to start
+ *  2) toId - The actor we want to end at
+ *  3) actorIds - Filled with the actors on the path
+ *  4) movieIds - Filled with the movies between them
+ *
+ */
+bool ActorGraph::findPathWeighted(unsigned int fromId, unsigned int toId,
+                                  vector<unsigned int>& actorIds,
+                                  vector<unsigned int>& movieIds) {
+    actorIds.clear();
+    movieIds.clear();
+    SearchWorkspace& workspace = SearchWorkspace::forThread();
+    workspace.startSearch(this->ofCSR->numActors(), this->ofCSR->numMovies());
+    // A min heap of the movies whose cast is not settled yet
+    vector<WeightedEntry>& heap = workspace.getHeap();
+    auto isFarther = greater<WeightedEntry>();
+    // The actors settled at the current distance
+    vector<unsigned int>& settled = workspace.getFrontier();
+    settled.push_back(fromId);
+    workspace.reachActor(fromId, fromId, CSRGraph::NO_ID);
+    uint64_t distance = 0;
+    bool found = fromId == toId;
+    while (!found) {
+        // Actors are settled closest first, so the first actor to
+        // reach a movie gives it its final distance: every movie is
+        // pushed once and never needs its key decreased
+        for (unsigned int actorId : settled) {
+            for (auto movie = this->ofCSR->moviesBegin(actorId);
+                 movie != this->ofCSR->moviesEnd(actorId); movie++) {
+                if (workspace.visitMovie(*movie)) {
+                    WeightedEntry entry = {
+                        distance + this->getMovieWeight(*movie), *movie,
+                        actorId};
+                    heap.push_back(entry);
+                    push_heap(heap.begin(), heap.end(), isFarther);
+                }
+            }
+        }
+        if (heap.empty()) {
+            return false;
+        }
+
+        // The whole cast of the closest movie is settled at its distance
+        pop_heap(heap.begin(), heap.end(), isFarther);
+        WeightedEntry closest = heap.back();
+        heap.pop_back();
+        distance = closest.distance;
+        settled.clear();
+        for (auto actor = this->ofCSR->actorsBegin(closest.movieId);
+             actor != this->ofCSR->actorsEnd(closest.movieId); actor++) {
+            if (!workspace.hasActor(*actor)) {
+                workspace.reachActor(*actor, closest.prevActor,
+                                     closest.movieId);
+                settled.push_back(*actor);
+                found = found || *actor == toId;
+            }
+        }
+    }
+
+    // Walk the previous links back to the start
+    walkBack(workspace, fromId, toId, actorIds, movieIds);
+    return true;
+}
+
+/*
+ * This method finds, for every pair of actors in
+ * a batch, the first year in which they became
+ * connected by any path. It adds the movies year by
+ * year to a disjoint-set forest of the actors.
+ *
+ * Parameters:
+ *  1) actorPairs - The (fromActor, toActor) pairs
+ *  2) years - Filled with one year per pair, in the
+ *             same order, or NO_YEAR if the actors
+ *             are unknown or never connected
+ *
+ */
+void ActorGraph::firstConnectionYears(
+    const vector<pair<string, string>>& actorPairs, vector<int>& years) {
+    years.assign(actorPairs.size(), NO_YEAR);
+    const CSRGraph& graph = *this->ofCSR;
+
+    // Each set starts with the unanswered pairs of its actor
+    vector<pair<unsigned int, unsigned int>> pairIds(actorPairs.size());
+    vector<vector<size_t>> pending(graph.numActors());
+    for (size_t i = 0; i < actorPairs.size(); i++) {
+        unsigned int fromId = this->actorNames->find(actorPairs[i].first);
+        unsigned int toId = this->actorNames->find(actorPairs[i].second);
+        // Edge case: One of the actors or both are not in the graph
+        if (fromId == NameTable::NO_ID || toId == NameTable::NO_ID) {
+            continue;
+        }
+        pairIds[i] = make_pair(fromId, toId);
+        if (fromId == toId) {
+            int first = INT_MAX;
+            for (auto movie = graph.moviesBegin(fromId);
+                 movie != graph.moviesEnd(fromId); movie++) {
+                first = min(first, graph.getMovieYear(*movie));
+            }
+            years[i] = first;
+            continue;
+        }
+        pending[fromId].push_back(i);
+        pending[toId].push_back(i);
+    }
+
+    // Add the movies oldest first
+    vector<unsigned int> movies(graph.numMovies());
+    for (unsigned int m = 0; m < movies.size(); m++) {
+        movies[m] = m;
+    }
+    stable_sort(movies.begin(), movies.end(),
+                [&graph](unsigned int a, unsigned int b) {
+                    return graph.getMovieYear(a) < graph.getMovieYear(b);
+                });
+    DisjointSets sets(graph.numActors());
+    for (unsigned int movieId : movies) {
+        int year = graph.getMovieYear(movieId);
+        const unsigned int* cast = graph.actorsBegin(movieId);
+        for (auto actor = cast + 1; actor != graph.actorsEnd(movieId);
+             actor++) {
+            unsigned int rootA = sets.find(*cast);
+            unsigned int rootB = sets.find(*actor);
+            if (rootA == rootB) {
+                continue;
+            }
+            unsigned int root = sets.unite(rootA, rootB);
+            vector<size_t>& kept = pending[root];
+            vector<size_t>& merged = pending[root == rootA ? rootB : rootA];
+            if (kept.size() < merged.size()) {
+                kept.swap(merged);
+            }
+            // A pair is connected now if it was split between the two
+            // sets, so it is enough to check the pairs of one of them
+            for (size_t i : merged) {
+                if (years[i] != NO_YEAR) {
+                    continue;
+                }
+                if (sets.find(pairIds[i].first) ==
+                    sets.find(pairIds[i].second)) {
+                    years[i] = year;
+                } else {
+                    kept.push_back(i);
+                }
+            }
+            vector<size_t>().swap(merged);
+        }
+    }
+}
+
+/*
+ * This method predicts the actors a query actor
+ * is most likely to work with next: the actors
+ * they have not worked with yet who have worked
+ * the most with their collaborators, or whose
+ * collaborators overlap the most with theirs (see
+ * LinkPredictor). Nothing is predicted for an
+ * unknown actor.
+ *
+ * Parameters:
+ *  1) queryActor - The name of the query actor
+ *  2) predictionNames - Filled with the names of
+ *                       the predictions, best first
+ *  3) numPrediction - The most actors to predict
+ *  4) score - How the actors are ranked
+ *
  */
 void ActorGraph::predictLink(const string& queryActor,
                              vector<string>& predictionNames,
-                             unsigned int numPrediction) {
-    return;
+                             unsigned int numPrediction, LinkScore score) {
+    predictionNames.clear();
+    unsigned int queryId = this->actorNames->find(queryActor);
+    if (queryId == NameTable::NO_ID) {
+        return;
+    }
+    vector<unsigned int> predictionIds;
+    if (this->ofCompressed != nullptr) {
+        // The other scores need the collaborator graph
+        if (score == COMMON_NEIGHBORS) {
+            LinkPredictor::forThread().predict(*this->ofCompressed,
+                                               *this->actorNames, queryId,
+                                               numPrediction, predictionIds);
+        }
+    } else if (score == COMMON_NEIGHBORS && this->ofCollaborators != nullptr) {
+        LinkPredictor::forThread().predict(*this->ofCollaborators,
+                                           *this->actorNames, queryId,
+                                           numPrediction, predictionIds);
+    } else if (score == COMMON_NEIGHBORS) {
+        LinkPredictor::forThread().predict(*this->ofCSR, *this->actorNames,
+                                           queryId, numPrediction,
+                                           predictionIds);
+    } else {
+        LinkPredictor::forThread().predictBySets(
+            this->getCollaborators(), *this->actorNames, queryId, score,
+            numPrediction, predictionIds);
+    }
+    for (unsigned int actorId : predictionIds) {
+        predictionNames.push_back(this->actorNames->getName(actorId));
+    }
+}
+
+/*
+ * This method builds the actor to actor projection
+ * of the graph, unless it was already built, and
+ * returns it.
+ *
+ * Parameters:
+ *  1) numThreads - The number of threads to build
+ *                  it with
+ *
+ */
+const CollaboratorGraph& ActorGraph::buildCollaborators(
+    unsigned int numThreads) {
+    call_once(this->collaboratorsOnce, [this, numThreads]() {
+        this->ofCollaborators = new CollaboratorGraph(*this->ofCSR, numThreads);
+    });
+    return *this->ofCollaborators;
+}
+
+/*
+ * This method returns the movies of every actor
+ * sorted by year, building them the first time
+ * they are asked for.
+ *
+ * Parameters:
+ *  1) numThreads - The number of threads to build
+ *                  them with
+ *
+ */
+const MovieYearIndex& ActorGraph::buildYearIndex(unsigned int numThreads) {
+    call_once(this->yearIndexOnce, [this, numThreads]() {
+        this->ofYearIndex = new MovieYearIndex(*this->ofCSR, numThreads);
+    });
+    return *this->ofYearIndex;
+}
+
+/*
+ * This method reads the distance labels of the
+ * actors from a file written by saveLabels.
+ *
+ * Parameters:
+ *  1) filename - The name of the file to read
+ *
+ */
+bool ActorGraph::loadLabels(const char* filename) {
+    PrunedLabelIndex* ofRead = new PrunedLabelIndex();
+    if (!ofRead->read(filename, *this->ofCSR)) {
+        delete ofRead;
+        return false;
+    }
+    delete this->ofLabels;
+    this->ofLabels = ofRead;
+    return true;
+}
+
+/*
+ * This method returns the distance labels of the
+ * actors, building them the first time they are
+ * asked for unless they were read.
+ *
+ * Parameters:
+ *  1) numThreads - The number of threads to build
+ *                  them with
+ *
+ */
+const PrunedLabelIndex& ActorGraph::buildLabels(unsigned int numThreads) {
+    call_once(this->labelsOnce, [this, numThreads]() {
+        if (this->ofLabels == nullptr) {
+            this->ofLabels = new PrunedLabelIndex();
+            this->ofLabels->build(*this->ofCSR, numThreads);
+        }
+    });
+    return *this->ofLabels;
+}
+
+/*
+ * This method writes the distance labels of the
+ * actors to a file.
+ *
+ * Parameters:
+ *  1) filename - The name of the file to write
+ *
+ */
+bool ActorGraph::saveLabels(const char* filename) {
+    return this->buildLabels().write(filename);
+}
+
+/*
+ * This method returns the landmark distance
+ * oracle, building it the first time it is asked
+ * for.
+ *
+ * Parameters:
+ *  1) numLandmarks - The number of landmarks
+ *  2) choice - How to choose the landmarks
+ *  3) numThreads - The number of threads to build
+ *                  it with
+ *
+ */
+const LandmarkOracle& ActorGraph::buildLandmarks(unsigned int numLandmarks,
+                                                 LandmarkChoice choice,
+                                                 unsigned int numThreads) {
+    call_once(this->landmarksOnce, [=]() {
+        this->ofLandmarks =
+            new LandmarkOracle(*this->ofCSR, numLandmarks, choice, numThreads);
+    });
+    return *this->ofLandmarks;
 }
 
 /*
@@ -276,35 +1572,21 @@ void ActorGraph::predictLink(const string& queryActor,
  *
  */
 ActorGraph::~ActorGraph() {
-    // Use iterators to iterate through hast table.
-    auto startOfActorTable = this->ofActors->begin();
-    auto endOfActorTable = this->ofActors->end();
-    // Keep a list of all the movie edges
-    unordered_set<MovieNode*>* ofAllMovies = new unordered_set<MovieNode*>();
-    // Loop through actor hash table
-    while (startOfActorTable != endOfActorTable) {
-        // Get actor vertex
-        auto currentActor = startOfActorTable->second;
-        // Get list of edges
-        auto actorMovies = currentActor->inMovies();
-        // Add movie edge to hashtbale
-        for (unsigned int i = 0; i < actorMovies->size(); i++) {
-            ofAllMovies->insert(actorMovies->at(i));
-        }
-        // Delete current actor vertex, move onto next element
-        delete currentActor;
-        startOfActorTable++;
-    }
-    // Iterators to iterate through movie hash table
-    auto startOfMovieTable = ofAllMovies->begin();
-    auto endOfMovieTable = ofAllMovies->end();
-    // While there are still elements in the hash table
-    while (startOfMovieTable != endOfMovieTable) {
-        // Delete each element in the hash table
-        delete (*startOfMovieTable);
-        startOfMovieTable++;
-    }
-    // Delete movie and actor hashtables
-    delete ofAllMovies;
-    delete this->ofActors;
+    // Every node and edge list goes with the arena's few blocks
+    delete this->ofArena;
+    // Delete the lists of nodes and the name tables
+    delete this->ofActorIds;
+    delete this->ofMovieIds;
+    delete this->actorNames;
+    delete this->movieNames;
+    delete this->ofCollaborators;
+    delete this->ofYearIndex;
+    delete this->ofLabels;
+    delete this->ofLandmarks;
+    delete this->ofComponents;
+    delete this->ofCompressed;
+    delete this->ofCastBitsets;
+    delete this->ofCSR;
+    // The tables and the CSR arrays may point into the snapshot
+    delete this->ofSnapshot;
 }
@@ -17,14 +17,48 @@
 #ifndef ACTORGRAPH_HPP
 #define ACTORGRAPH_HPP
 
+#include <climits>
 #include <iostream>
-#include <unordered_map>
+#include <mutex>
 #include <vector>
+#include "ActorComponents.hpp"
 #include "ActorNode.hpp"
+#include "Arena.hpp"
+#include "BaconNumbers.hpp"
+#include "CSRGraph.hpp"
+#include "CastBitsets.hpp"
+#include "CollaboratorGraph.hpp"
+#include "CompressedGraph.hpp"
+#include "DistanceDistribution.hpp"
+#include "GraphSnapshot.hpp"
+#include "LandmarkOracle.hpp"
+#include "LinkPredictor.hpp"
 #include "MovieNode.hpp"
+#include "MovieYearIndex.hpp"
+#include "NameTable.hpp"
+#include "PrunedLabelIndex.hpp"
+#include "VertexOrder.hpp"
 
 using namespace std;
 
+/* The ways BFS can search for a shortest path */
+enum PathSearch {
+    // One BFS from the first actor, see findPath
+    FORWARD_SEARCH,
+    // One BFS from each actor, see findPathBidirectional
+    BIDIRECTIONAL_SEARCH,
+    // One BFS over the collaborator graph, see findPathProjected
+    PROJECTED_SEARCH,
+    // Cheapest path by movie weight, see findPathWeighted
+    WEIGHTED_SEARCH,
+    // One BFS with bitmap frontiers, see findPathHybrid
+    HYBRID_SEARCH,
+    // A walk between two labels, see findPathIndexed
+    INDEXED_SEARCH,
+    // One BFS pruned by landmark bounds, see findPathLandmarks
+    LANDMARK_SEARCH
+};
+
 /**
  * The ActorGraph class allows the user to create a
  * a graph which is made up of actor nodes and
@@ -34,14 +68,130 @@ using namespace std;
  * actors and their movies.
  *
  * Instance variables:
- *  1) ofActors - A hashtable of Actor nodes ordered
- *                by their name
+ *  1) actorNames - The interned names of the actors
+ *
+ *  2) movieNames - The interned "title#@year" names
+ *                  of the movies
+ *
+ *  3) ofActorIds - The actor nodes indexed by their id,
+ *                  kept only while a file is read
+ *
+ *  4) ofMovieIds - The movie nodes indexed by their id,
+ *                  kept only while a file is read
+ *
+ *  5) ofCSR - The frozen copy of the graph that the
+ *             searches run on
+ *
+ *  6) ofSnapshot - The snapshot the graph was loaded
+ *                  from, if any
+ *
+ *  7) ofArena - The arena the nodes and their edges
+ *               are stored in, emptied once frozen
+ *
+ *  8) ofCollaborators - The actor to actor projection,
+ *                       built when asked for or the
+ *                       first time a score needs it
+ *
+ *  9) collaboratorsOnce - Makes sure the projection is
+ *                         built only once
+ *
+ *  10) ofYearIndex - The movies of every actor sorted
+ *                    by year, built the first time a
+ *                    search is limited to some years
+ *
+ *  11) yearIndexOnce - Makes sure the index is built
+ *                      only once
+ *
+ *  12) ofLabels - The distance labels of the actors,
+ *                 read or built before the first
+ *                 indexed search
+ *
+ *  13) labelsOnce - Makes sure the labels are built
+ *                   only once
+ *
+ *  14) ofLandmarks - The distances to a few landmark
+ *                    actors, built before the first
+ *                    search that bounds distances
+ *
+ *  15) landmarksOnce - Makes sure the landmarks are
+ *                      built only once
+ *
+ *  16) ofComponents - The connected components of the
+ *                     actors, labeled once the graph
+ *                     is loaded
+ *
+ *  17) ofCompressed - The compressed copy of the graph
+ *                     that replaces ofCSR once the
+ *                     graph is compressed
+ *
+ *  18) ofCastBitsets - The casts of the largest movies
+ *                      as bitsets, built once the graph
+ *                      is loaded
  */
 class ActorGraph {
   protected:
-    unordered_map<string, ActorNode*>* ofActors;
+    NameTable* actorNames;
+    NameTable* movieNames;
+    vector<ActorNode*>* ofActorIds;
+    vector<MovieNode*>* ofMovieIds;
+    CSRGraph* ofCSR;
+    GraphSnapshot* ofSnapshot;
+    Arena* ofArena;
+    CollaboratorGraph* ofCollaborators;
+    once_flag collaboratorsOnce;
+    MovieYearIndex* ofYearIndex;
+    once_flag yearIndexOnce;
+    PrunedLabelIndex* ofLabels;
+    once_flag labelsOnce;
+    LandmarkOracle* ofLandmarks;
+    once_flag landmarksOnce;
+    ActorComponents* ofComponents;
+    CompressedGraph* ofCompressed;
+    CastBitsets* ofCastBitsets;
+
+    /*
+     * This method links an actor and a movie read
+     * from the same row, making their nodes if they
+     * have not been seen before.
+     *
+     * Parameters:
+     *  1) actorId - The id of the row's actor
+     *  2) movieId - The id of the row's movie
+     *
+     */
+    void linkRow(unsigned int actorId, unsigned int movieId);
+
+    /*
+     * This method makes the nodes of a frozen graph
+     * again from its CSR arrays, or its compressed
+     * lists, so that the rows of another file can be
+     * linked to them. A compressed graph is no longer
+     * compressed afterwards.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    void thaw();
+
+    /*
+     * This method freezes the nodes of the graph
+     * into the contiguous CSR arrays used by the
+     * searches, and labels their components. It is
+     * called once the whole file has been read, and
+     * frees the nodes once they are frozen.
+     *
+     * Parameters:
+     *  1) numThreads - The number of threads labeling
+     *                  the components
+     *
+     */
+    void freeze(unsigned int numThreads);
 
   public:
+    // Year reported for actors who are never connected
+    static const int NO_YEAR = INT_MIN;
+
     /*
      * This is the contructor method for the graph.
      * Its purpose is to initialize the necessary
@@ -58,13 +208,98 @@ class ActorGraph {
      * and makes a graph based on its contents.
      * It assumes that each line of the file has
      * an actor, the movies they played in, and
-     * the year the movie was released.
+     * the year the movie was released. The rows of a
+     * cast file are added to the graph read so far,
+     * which must be done before the collaborators,
+     * year index, labels or landmarks are built, and
+     * are read on one thread unless the graph is
+     * empty. The file may also be a snapshot (see
+     * saveSnapshot), which replaces the graph.
      *
      * Parameters:
      *  1) filename - The name of the file
+     *  2) numThreads - The number of threads reading
+     *                  the file; the graph is the same
+     *                  for any number
+     *
+     */
+    bool buildGraphFromFile(const char* filename, unsigned int numThreads = 1);
+
+    /*
+     * This method loads a graph from a snapshot
+     * written by saveSnapshot. The snapshot is mapped
+     * and used in place, so no node is created.
+     * Returns false if it cannot be used.
+     *
+     * Parameters:
+     *  1) filename - The name of the snapshot file
+     *  2) numThreads - The number of threads labeling
+     *                  the components
+     *
+     */
+    bool loadSnapshot(const char* filename, unsigned int numThreads = 1);
+
+    /*
+     * This method writes a snapshot of the graph,
+     * which buildGraphFromFile and loadSnapshot can
+     * load much faster than the cast file. Returns
+     * false if the file could not be written.
+     *
+     * Parameters:
+     *  1) filename - The name of the snapshot file
+     *
+     */
+    bool saveSnapshot(const char* filename);
+
+    /*
+     * This method renumbers the actors and movies so
+     * that co-stars sit close together in the CSR
+     * arrays, which makes the searches touch fewer
+     * cache lines. The names keep their meaning but
+     * get new ids. It must be called before the
+     * collaborators, year index, labels or landmarks
+     * are built, since they hold the old ids.
+     *
+     * Parameters:
+     *  1) ordering - Which order to give the ids, see
+     *                VertexOrdering
+     *  2) numThreads - The number of threads labeling
+     *                  the components
+     *
+     */
+    void reorder(VertexOrdering ordering, unsigned int numThreads = 1);
+
+    /*
+     * This method keeps the casts of the movies with
+     * at least minCast actors as bitsets, replacing
+     * any kept before, so that findPath can reach
+     * them a word at a time. The graph keeps no
+     * bitsets until this is called, since they change
+     * the order in which equally short paths are
+     * found. It must not be called while other
+     * threads search.
+     *
+     * Parameters:
+     *  1) minCast - The fewest actors a cast needs to
+     *               be kept as a bitset
+     *
+     */
+    const CastBitsets& buildCastBitsets(unsigned int minCast);
+
+    /*
+     * This method swaps the CSR arrays for a compressed
+     * copy of them. Afterwards BFS searches forward over
+     * the compressed lists whatever search is asked
+     * for, predictLink only scores by common
+     * neighbours, and nothing else that needs the CSR
+     * arrays, such as a batch of searches, may be used.
+     * It must be called after any reorder.
+     *
+     * Parameters:
+     *  NONE
      *
      */
-    bool buildGraphFromFile(const char* filename);
+    void compress();
 
     /*
      * This method reads in the name of two actors
@@ -75,6 +310,12 @@ class ActorGraph {
      * Parameters:
      *  1) fromActor - The vertex from which to start
      *  2) toActor - The vertex we want to end at
+     *  3) shortestPath - The string the path is written to
+     *  4) search - How to search, see PathSearch
+     *  5) years - Only the movies of these years may be
+     *             used; a limited range always uses a
+     *             forward search, see findPathInYears.
+     *             A compressed graph ignores it.
      *
      * Sources used:
      *  1) CSE 100 Lecture slides
@@ -86,17 +327,488 @@ class ActorGraph {
      * Edge Cases:
      *  1) The actors do not exists - return
      *  2) The input is empty - return
+     *  3) The actors are in different components - return
      *
      */
     void BFS(const string& fromActor, const string& toActor,
-             string& shortestPath);
+             string& shortestPath, PathSearch search = FORWARD_SEARCH,
+             const YearRange& years = ALL_YEARS);
+
+    /*
+     * This method finds a shortest path for every pair
+     * of actors in a batch. Pairs are grouped by their
+     * first actor, and up to 64 first actors are searched
+     * at once by a multi source BFS, so a batch costs far
+     * fewer passes over the graph than one BFS per pair.
+     * Pairs without a path get an empty string.
+     *
+     * Parameters:
+     *  1) actorPairs - The (fromActor, toActor) pairs
+     *  2) shortestPaths - Filled with one path per pair,
+     *                     in the same order
+     *  3) numThreads - The number of threads that take
+     *                  batches of first actors in turn
+     *
+     */
+    void BFS(const vector<pair<string, string>>& actorPairs,
+             vector<string>& shortestPaths, unsigned int numThreads = 1);
+
+    /*
+     * This method finds a shortest path between two
+     * actors given by id. It does so using a BFS over
+     * the CSR arrays, so it never looks at a name.
+     * The casts kept as bitsets (see CastBitsets) are
+     * reached a word at a time. Returns false if there
+     * is no path.
+     *
+     * Parameters:
+     *  1) fromId - The actor from which to start
+     *  2) toId - The actor we want to end at
+     *  3) actorIds - Filled with the actors on the path
+     *  4) movieIds - Filled with the movies between them
+     *
+     */
+    bool findPath(unsigned int fromId, unsigned int toId,
+                  vector<unsigned int>& actorIds,
+                  vector<unsigned int>& movieIds);
+
+    /*
+     * This method finds a shortest path between two
+     * actors given by id by growing one BFS from each
+     * end. Each round expands a whole level of the side
+     * with the smaller frontier, and the search stops
+     * as soon as an actor is reached by both sides.
+     * Returns false if there is no path.
+     *
+     * Parameters:
+     *  1) fromId - The actor from which to start
+     *  2) toId - The actor we want to end at
+     *  3) actorIds - Filled with the actors on the path
+     *  4) movieIds - Filled with the movies between them
+     *
+     */
+    bool findPathBidirectional(unsigned int fromId, unsigned int toId,
+                               vector<unsigned int>& actorIds,
+                               vector<unsigned int>& movieIds);
+
+    /*
+     * This method finds a shortest path between two
+     * actors given by id. It does so using a BFS over
+     * the collaborator graph, which goes from actor to
+     * actor without the movies, and then picks a movie
+     * for each step of the path. The collaborator graph
+     * must have been built. Returns false if there is
+     * no path.
+     *
+     * Parameters:
+     *  1) fromId - The actor from which to start
+     *  2) toId - The actor we want to end at
+     *  3) actorIds - Filled with the actors on the path
+     *  4) movieIds - Filled with the movies between them
+     *
+     */
+    bool findPathProjected(unsigned int fromId, unsigned int toId,
+                           vector<unsigned int>& actorIds,
+                           vector<unsigned int>& movieIds);
+
+    /*
+     * This method finds a shortest path between two
+     * actors given by id. It does so using a BFS over
+     * the compressed lists, decoding each list as it
+     * is reached. Returns false if there is no path.
+     *
+     * Parameters:
+     *  1) fromId - The actor from which to start
+     *  2) toId - The actor we want to end at
+     *  3) actorIds - Filled with the actors on the path
+     *  4) movieIds - Filled with the movies between them
+     *
+     */
+    bool findPathCompressed(unsigned int fromId, unsigned int toId,
+                            vector<unsigned int>& actorIds,
+                            vector<unsigned int>& movieIds);
+
+    /*
+     * This method finds a shortest path between two
+     * actors given by id. It does so using a BFS that
+     * keeps its frontiers as bitmaps and expands each
+     * step top down or bottom up, whichever should
+     * check fewer edges (see HybridBFS). Returns false
+     * if there is no path.
+     *
+     * Parameters:
+     *  1) fromId - The actor from which to start
+     *  2) toId - The actor we want to end at
+     *  3) actorIds - Filled with the actors on the path
+     *  4) movieIds - Filled with the movies between them
+     *
+     */
+    bool findPathHybrid(unsigned int fromId, unsigned int toId,
+                        vector<unsigned int>& actorIds,
+                        vector<unsigned int>& movieIds);
 
     /*
-     * This method tries to predict a link between actors.
-     * Not implemented.
+     * This method finds the number of movies between
+     * an actor and every actor of the graph, using the
+     * same BFS as findPathHybrid.
+     *
+     * Parameters:
+     *  1) sourceId - The actor to start from
+     *  2) distances - Filled with the distance of every
+     *                 actor by id, HybridBFS::NO_LEVEL
+     *                 for those not connected
+     *
+     */
+    void actorDistances(unsigned int sourceId, vector<unsigned int>& distances);
+
+    /*
+     * This method finds the number of movies between
+     * a center actor and every actor of the graph, with
+     * one BFS whose levels are spread over threads.
+     * Returns false if the center is unknown or the
+     * graph is compressed.
+     *
+     * Parameters:
+     *  1) centerActor - The name of the actor at the
+     *                   center
+     *  2) numbers - Filled with the distance of every
+     *               actor, their histogram and the
+     *               farthest actors
+     *  3) numThreads - The number of threads to use
+     *
+     */
+    bool baconNumbers(const string& centerActor, BaconNumbers& numbers,
+                      unsigned int numThreads = 1);
+
+    /*
+     * This method estimates how many pairs of actors
+     * are each number of movies apart, over the whole
+     * graph, with a HyperLogLog counter per actor.
+     * Returns false if the graph is compressed.
+     *
+     * Parameters:
+     *  1) distribution - Filled with the estimates; its
+     *                    counters size is kept
+     *  2) numThreads - The number of threads to use
+     *
+     */
+    bool distanceDistribution(DistanceDistribution& distribution,
+                              unsigned int numThreads = 1);
+
+    /*
+     * This method finds a shortest path between two
+     * actors given by id from their distance labels,
+     * walking from each of them to the best hub they
+     * share. The labels are built if they were not
+     * read. Actors the labels do not connect but the
+     * components do are farther apart than the labels
+     * hold, and are searched by findPath. Returns
+     * false if there is no path.
+     *
+     * Parameters:
+     *  1) fromId - The actor from which to start
+     *  2) toId - The actor we want to end at
+     *  3) actorIds - Filled with the actors on the path
+     *  4) movieIds - Filled with the movies between them
+     *
+     */
+    bool findPathIndexed(unsigned int fromId, unsigned int toId,
+                         vector<unsigned int>& actorIds,
+                         vector<unsigned int>& movieIds);
+
+    /*
+     * This method finds a shortest path as long as
+     * the one of findPath, but does not expand the
+     * actors that the landmark bounds show are too far
+     * from the second actor to be on a shortest path,
+     * and stops as soon as the second actor is reached.
+     * Equal paths may be chosen another way than by
+     * findPath, whose cast bitsets reach the actors in
+     * another order. The landmarks are built if they
+     * were not. Returns false if there is no path.
+     *
+     * Parameters:
+     *  1) fromId - The actor from which to start
+     *  2) toId - The actor we want to end at
+     *  3) actorIds - Filled with the actors on the path
+     *  4) movieIds - Filled with the movies between them
+     *
+     */
+    bool findPathLandmarks(unsigned int fromId, unsigned int toId,
+                           vector<unsigned int>& actorIds,
+                           vector<unsigned int>& movieIds);
+
+    /*
+     * This method bounds the number of movies between
+     * two actors given by name using the landmarks,
+     * which are built if they were not. Returns false
+     * if either actor is not in the graph.
+     *
+     * Parameters:
+     *  1) fromActor - The first actor
+     *  2) toActor - The second actor
+     *  3) lower - Set to the lower bound, or
+     *             LandmarkOracle::NO_DISTANCE if the
+     *             actors are not connected
+     *  4) upper - Set to the upper bound, or
+     *             LandmarkOracle::NO_DISTANCE if it
+     *             is not known
+     *
+     */
+    bool distanceBounds(const string& fromActor, const string& toActor,
+                        unsigned int& lower, unsigned int& upper);
+
+    /*
+     * This method finds a shortest path between two
+     * actors given by id that only uses the movies of
+     * a range of years. It does so using a BFS that
+     * reads the movies of each actor from the year
+     * index, where those of the range are found by
+     * binary search, so the other movies are never
+     * looked at. Returns false if there is no path.
+     * An actor without a movie in the range is not in
+     * the graph of those years, so it has no path,
+     * not even to itself.
+     *
+     * Parameters:
+     *  1) fromId - The actor from which to start
+     *  2) toId - The actor we want to end at
+     *  3) years - The years of the movies to use
+     *  4) actorIds - Filled with the actors on the path
+     *  5) movieIds - Filled with the movies between them
+     *
+     */
+    bool findPathInYears(unsigned int fromId, unsigned int toId,
+                         const YearRange& years,
+                         vector<unsigned int>& actorIds,
+                         vector<unsigned int>& movieIds);
+
+    /*
+     * This method finds the cheapest path between two
+     * actors given by id, where each movie costs its
+     * getMovieWeight, so that recent collaborations are
+     * preferred. It does so using Dijkstra's algorithm
+     * with a binary heap of movies: a movie gets its
+     * final distance from the first actor to reach it,
+     * so it is pushed once and no key is ever decreased,
+     * and popping it settles its whole cast. Returns
+     * false if there is no path.
+     *
+     * Parameters:
+     *  1) fromId - The actor from which to start
+     *  2) toId - The actor we want to end at
+     *  3) actorIds - Filled with the actors on the path
+     *  4) movieIds - Filled with the movies between them
+     *
+     */
+    bool findPathWeighted(unsigned int fromId, unsigned int toId,
+                          vector<unsigned int>& actorIds,
+                          vector<unsigned int>& movieIds);
+
+    /*
+     * This method finds, for every pair of actors in
+     * a batch, the first year in which they became
+     * connected by any path. It adds the movies year by
+     * year to a disjoint-set forest of the actors, and
+     * each set keeps the pairs it holds one actor of,
+     * so that merging two sets only checks the pairs of
+     * the smaller one. An actor is connected to itself
+     * from the year of their first movie.
+     *
+     * Parameters:
+     *  1) actorPairs - The (fromActor, toActor) pairs
+     *  2) years - Filled with one year per pair, in the
+     *             same order, or NO_YEAR if the actors
+     *             are unknown or never connected
+     *
+     */
+    void firstConnectionYears(const vector<pair<string, string>>& actorPairs,
+                              vector<int>& years);
+
+    /*
+     * This method writes a path in the
+     * (actor)--[movie#@year]-->(actor) format.
+     *
+     * Parameters:
+     *  1) actorIds - The actors on the path, in order
+     *  2) movieIds - The movies linking each actor to
+     *                the next one on the path
+     *  3) shortestPath - The string the path is written to
+     *
+     */
+    void writePath(const vector<unsigned int>& actorIds,
+                   const vector<unsigned int>& movieIds,
+                   string& shortestPath);
+
+    /* Returns the id of an actor, or NameTable::NO_ID if it is unknown */
+    unsigned int getActorId(const string& actorName) {
+        return this->actorNames->find(actorName);
+    }
+
+    /* Returns the interned name of the actor with the given id */
+    const char* getActorName(unsigned int actorId) const {
+        return this->actorNames->getName(actorId);
+    }
+
+    /* Returns the interned "title#@year" name of the movie with the id */
+    const char* getMovieName(unsigned int movieId) const {
+        return this->movieNames->getName(movieId);
+    }
+
+    /* Returns the release year of the movie with the given id */
+    int getMovieYear(unsigned int movieId) {
+        if (this->ofCompressed != nullptr) {
+            return this->ofCompressed->getMovieYear(movieId);
+        }
+        return this->ofCSR->getMovieYear(movieId);
+    }
+
+    /* Returns the cost of a movie: 1 + (newest year - its year) */
+    unsigned int getMovieWeight(unsigned int movieId) {
+        if (this->ofCompressed != nullptr) {
+            return 1 + (this->ofCompressed->getLatestYear() -
+                        this->ofCompressed->getMovieYear(movieId));
+        }
+        return 1 + (this->ofCSR->getLatestYear() -
+                    this->ofCSR->getMovieYear(movieId));
+    }
+
+    /* Returns the number of actors in the graph */
+    unsigned int numActors() { return this->actorNames->size(); }
+
+    /* Returns the number of movies in the graph */
+    unsigned int numMovies() { return this->movieNames->size(); }
+
+    /*
+     * This method predicts the actors a query actor
+     * is most likely to work with next: the actors
+     * they have not worked with yet who have worked
+     * the most with their collaborators, or whose
+     * collaborators overlap the most with theirs (see
+     * LinkPredictor). Nothing is predicted for an
+     * unknown actor.
+     *
+     * Parameters:
+     *  1) queryActor - The name of the query actor
+     *  2) predictionNames - Filled with the names of
+     *                       the predictions, best first
+     *  3) numPrediction - The most actors to predict
+     *  4) score - How the actors are ranked
+     *
      */
     void predictLink(const string& queryActor, vector<string>& predictionNames,
-                     unsigned int numPrediction);
+                     unsigned int numPrediction,
+                     LinkScore score = COMMON_NEIGHBORS);
+
+    /*
+     * This method builds the actor to actor projection
+     * of the graph, unless it was already built, and
+     * returns it. Once it is built, COMMON_NEIGHBORS
+     * predictions read the shared movie counts from it
+     * instead of walking the movies. It should be built
+     * before queries start on other threads.
+     *
+     * Parameters:
+     *  1) numThreads - The number of threads to build
+     *                  it with
+     *
+     */
+    const CollaboratorGraph& buildCollaborators(unsigned int numThreads);
+
+    /*
+     * This method returns the actor to actor
+     * projection of the graph, building it the
+     * first time it is asked for.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    const CollaboratorGraph& getCollaborators() {
+        return this->buildCollaborators(1);
+    }
+
+    /* Returns the frozen copy of the graph the searches run on */
+    const CSRGraph& getCSR() const { return *this->ofCSR; }
+
+    /* Returns the casts kept as bitsets, see buildCastBitsets */
+    const CastBitsets& getCastBitsets() const {
+        return *this->ofCastBitsets;
+    }
+
+    /* Returns the compressed copy of the graph, or nullptr */
+    const CompressedGraph* getCompressed() const { return this->ofCompressed; }
+
+    /* Returns the connected components of the actors */
+    const ActorComponents& getComponents() const {
+        return *this->ofComponents;
+    }
+
+    /*
+     * This method returns the movies of every actor
+     * sorted by year, building them the first time
+     * they are asked for.
+     *
+     * Parameters:
+     *  1) numThreads - The number of threads to build
+     *                  them with
+     *
+     */
+    const MovieYearIndex& buildYearIndex(unsigned int numThreads = 1);
+
+    /*
+     * This method reads the distance labels of the
+     * actors from a file written by saveLabels. It
+     * must be called before the labels are built.
+     * Returns false if the file cannot be read or was
+     * written for another graph.
+     *
+     * Parameters:
+     *  1) filename - The name of the file to read
+     *
+     */
+    bool loadLabels(const char* filename);
+
+    /*
+     * This method returns the distance labels of the
+     * actors, building them the first time they are
+     * asked for unless they were read.
+     *
+     * Parameters:
+     *  1) numThreads - The number of threads to build
+     *                  them with
+     *
+     */
+    const PrunedLabelIndex& buildLabels(unsigned int numThreads = 1);
+
+    /*
+     * This method writes the distance labels of the
+     * actors to a file, building them first if they
+     * are not yet. Returns false if the file cannot be
+     * written.
+     *
+     * Parameters:
+     *  1) filename - The name of the file to write
+     *
+     */
+    bool saveLabels(const char* filename);
+
+    /*
+     * This method returns the landmark distance
+     * oracle, building it the first time it is asked
+     * for. Later calls return the same oracle whatever
+     * they ask for.
+     *
+     * Parameters:
+     *  1) numLandmarks - The number of landmarks
+     *  2) choice - How to choose the landmarks
+     *  3) numThreads - The number of threads to build
+     *                  it with
+     *
+     */
+    const LandmarkOracle& buildLandmarks(
+        unsigned int numLandmarks = LandmarkOracle::DEFAULT_LANDMARKS,
+        LandmarkChoice choice = DEGREE_LANDMARKS, unsigned int numThreads = 1);
 
     /*
      * This is the destructor method. It makes sure
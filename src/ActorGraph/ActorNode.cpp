@@ -1,17 +1,16 @@
 /**
  * The ActorNode class allows the user to create a
  * a node which represents an actor. It contains
- * the actor's name, a pointer to a previous
- * actor node, and a vector of edges made up
- * of movies.
+ * the actor's name, its id and a vector of
+ * edges made up of movies.
  *
  * Instance variables:
- *  1) actorName - The name of the actor
+ *  1) actorName - The interned name of the actor
  *
  *  2) ofMovies - The vector containing all of
  *                the edges.
  *
- *  3) ofPrevious - The previous actor node
+ *  3) id - The dense id of the actor
  */
 
 #include "ActorNode.hpp"
@@ -25,12 +24,16 @@ using namespace std;
  * instance variables to make a actor node.
  *
  * Parameters:
- *  1) actorName - The name of the actor
+ *  1) actorName - The interned name of the actor,
+ *                which must outlive the node
+ *  2) id - The dense id of the actor
+ *  3) arena - The arena the edges are stored in
  *
  */
-ActorNode::ActorNode(string actorName) {
+ActorNode::ActorNode(const char* actorName, unsigned int id, Arena& arena)
+    : ofMovies(ArenaAllocator<MovieNode*>(arena)) {
     this->actorName = actorName;
-    this->ofMovies = new vector<MovieNode*>();
+    this->id = id;
 }
 
 /*
@@ -41,71 +44,38 @@ ActorNode::ActorNode(string actorName) {
  *  NONE
  *
  */
-string ActorNode::getActorName() { return this->actorName; }
+const char* ActorNode::getActorName() { return this->actorName; }
 
 /*
- * The purpose of this method is to add an edge
- * to the actor node.
- *
- * Parameters:
- *  1) ofMovie - The node representing the edge
- *
- */
-void ActorNode::addMovie(MovieNode* ofMovie) {
-    // Add movie to list of edges
-    this->ofMovies->push_back(ofMovie);
-}
-
-/*
- * The purpose of this method is to return a
- * vector which contains all of the edges
- * of the actor node.
+ * The purpose of this method is to return
+ * the dense id of the actor.
  *
  * Parameters:
  *  NONE
  *
  */
-vector<MovieNode*>* ActorNode::inMovies() { return this->ofMovies; }
+unsigned int ActorNode::getId() { return this->id; }
 
 /*
- * The purpose of this method is to set the
- * previous node of a actor node. Its used
- * to link paths together.
+ * The purpose of this method is to add an edge
+ * to the actor node.
  *
  * Parameters:
- *  1) ofPrevious - The actor node and the edge
- *                  that connects both verticies.
+ *  1) ofMovie - The node representing the edge
  *
  */
-void ActorNode::setPrevious(pair<ActorNode*, MovieNode*> ofPrevious) {
-    this->ofPrevious = ofPrevious;
+void ActorNode::addMovie(MovieNode* ofMovie) {
+    // Add movie to list of edges
+    this->ofMovies.push_back(ofMovie);
 }
 
 /*
  * The purpose of this method is to return a
- * pair which represents the previous node
- * of the current actor node
- *
- * Parameters:
- *  NONE
- *
- */
-pair<ActorNode*, MovieNode*> ActorNode::getPrevious() {
-    return this->ofPrevious;
-}
-
-/*
- * The purpose of this method is to free up
- * all of the memory used by the actor node
- * in the graph.
+ * vector which contains all of the edges
+ * of the actor node.
  *
  * Parameters:
  *  NONE
  *
  */
-ActorNode::~ActorNode() {
-    // Clear vector of all pointers
-    this->ofMovies->clear();
-    // Delete vector
-    delete this->ofMovies;
-}
\ No newline at end of file
+ActorNode::MovieList* ActorNode::inMovies() { return &this->ofMovies; }
@@ -21,6 +21,7 @@
 
 #include <string>
 #include <vector>
+#include "Arena.hpp"
 
 using namespace std;
 
@@ -29,23 +30,27 @@ class MovieNode;
 /**
  * The ActorNode class allows the user to create a
  * a node which represents an actor. It contains
- * the actor's name, a pointer to a previous
- * actor node, and a vector of edges made up
- * of movies.
+ * the actor's name, its id and a vector of
+ * edges made up of movies.
  *
  * Instance variables:
- *  1) actorName - The name of the actor
+ *  1) actorName - The interned name of the actor
  *
  *  2) ofMovies - The vector containing all of
  *                the edges.
  *
- *  3) ofPrevious - The previous actor node
+ *  3) id - The dense id of the actor, used to
+ *          index the frozen CSR graph
  */
 class ActorNode {
+  public:
+    // The edges of a node, stored in the graph's arena
+    typedef vector<MovieNode*, ArenaAllocator<MovieNode*>> MovieList;
+
   protected:
-    string actorName;
-    vector<MovieNode*>* ofMovies;
-    pair<ActorNode*, MovieNode*> ofPrevious;
+    const char* actorName;
+    unsigned int id;
+    MovieList ofMovies;
 
   public:
     /*
@@ -54,10 +59,13 @@ class ActorNode {
      * instance variables to make a actor node.
      *
      * Parameters:
-     *  1) actorName - The name of the actor
+     *  1) actorName - The interned name of the actor,
+     *                which must outlive the node
+     *  2) id - The dense id of the actor
+     *  3) arena - The arena the edges are stored in
      *
      */
-    ActorNode(string actorName);
+    ActorNode(const char* actorName, unsigned int id, Arena& arena);
 
     /*
      * The purpose of this method is to return
@@ -67,62 +75,38 @@ class ActorNode {
      *  NONE
      *
      */
-    string getActorName();
+    const char* getActorName();
 
     /*
-     * The purpose of this method is to add an edge
-     * to the actor node.
-     *
-     * Parameters:
-     *  1) ofMovie - The node representing the edge
-     *
-     */
-    void addMovie(MovieNode* ofMovie);
-
-    /*
-     * The purpose of this method is to return a
-     * vector which contains all of the edges
-     * of the actor node.
+     * The purpose of this method is to return
+     * the dense id of the actor.
      *
      * Parameters:
      *  NONE
      *
      */
-    vector<MovieNode*>* inMovies();
+    unsigned int getId();
 
     /*
-     * The purpose of this method is to set the
-     * previous node of a actor node. Its used
-     * to link paths together.
+     * The purpose of this method is to add an edge
+     * to the actor node.
      *
      * Parameters:
-     *  1) ofPrevious - The actor node and the edge
-     *                  that connects both verticies.
+     *  1) ofMovie - The node representing the edge
      *
      */
-    void setPrevious(pair<ActorNode*, MovieNode*> ofPrevious);
+    void addMovie(MovieNode* ofMovie);
 
     /*
      * The purpose of this method is to return a
-     * pair which represents the previous node
-     * of the current actor node
-     *
-     * Parameters:
-     *  NONE
-     *
-     */
-    pair<ActorNode*, MovieNode*> getPrevious();
-
-    /*
-     * The purpose of this method is to free up
-     * all of the memory used by the actor node
-     * in the graph.
+     * vector which contains all of the edges
+     * of the actor node.
      *
      * Parameters:
      *  NONE
      *
      */
-    ~ActorNode();
+    MovieList* inMovies();
 };
 
 #endif  // ACTORNODE_HPP
\ No newline at end of file
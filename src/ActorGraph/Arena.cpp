@@ -0,0 +1,79 @@
+/**
+ * The Arena class hands out memory from large blocks
+ * and frees all of them at once.
+ *
+ * Instance variables:
+ *  1) blocks - Every block, to be freed at the end
+ *
+ *  2) next - The first free byte of the current block
+ *
+ *  3) end - One past the last byte of the current block
+ *
+ *  4) blockSize - The size of the next block
+ *
+ *  5) freeLists - The released pieces of each power of
+ *                 two size
+ *
+ *  6) reserved - The number of bytes in all blocks
+ */
+
+#include "Arena.hpp"
+#include <cstdlib>
+
+using namespace std;
+
+const size_t Arena::FIRST_BLOCK_SIZE;
+const size_t Arena::MAX_BLOCK_SIZE;
+
+/*
+ * This is the contructor method for the arena.
+ * No memory is allocated until it is used.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+Arena::Arena()
+    : next(nullptr), end(nullptr), blockSize(FIRST_BLOCK_SIZE), reserved(0) {
+    for (unsigned int i = 0; i < sizeof(size_t) * 8; i++) {
+        this->freeLists[i] = nullptr;
+    }
+}
+
+/*
+ * This method allocates a new block which can
+ * hold at least the given number of bytes.
+ *
+ * Parameters:
+ *  1) bytes - The size of the allocation that did
+ *             not fit in the current block
+ *
+ */
+void Arena::grow(size_t bytes) {
+    size_t size = this->blockSize;
+    while (size < bytes) {
+        size *= 2;
+    }
+    char* block = (char*)malloc(size);
+    if (block == nullptr) {
+        throw bad_alloc();
+    }
+    this->blocks.push_back(block);
+    this->next = block;
+    this->end = block + size;
+    this->reserved += size;
+    if (this->blockSize < MAX_BLOCK_SIZE) {
+        this->blockSize *= 2;
+    }
+}
+
+/*
+ * This is the destructor method. It frees every
+ * block without running any destructor.
+ *
+ */
+Arena::~Arena() {
+    for (unsigned int i = 0; i < this->blocks.size(); i++) {
+        free(this->blocks[i]);
+    }
+}
@@ -0,0 +1,201 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Description of File:
+ *  This file defines a monotonic arena that the nodes
+ *  of the graph and their edge lists are carved from.
+ *  Allocating is a pointer bump, and everything is
+ *  freed at once when the arena is destroyed.
+ */
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * The Arena class hands out memory from large blocks.
+ * Memory is never given back to the system before
+ * the arena is destroyed, and no destructor is run
+ * then, so only objects that own nothing outside the
+ * arena may live in it. Released power of two sized
+ * pieces, such as the old buffer of a growing vector,
+ * are kept on a free list for later allocations of
+ * the same size.
+ *
+ * Instance variables:
+ *  1) blocks - Every block, to be freed at the end
+ *
+ *  2) next - The first free byte of the current block
+ *
+ *  3) end - One past the last byte of the current block
+ *
+ *  4) blockSize - The size of the next block
+ *
+ *  5) freeLists - The released pieces of each power of
+ *                 two size, linked through their first
+ *                 bytes
+ *
+ *  6) reserved - The number of bytes in all blocks
+ */
+class Arena {
+  protected:
+    vector<char*> blocks;
+    char* next;
+    char* end;
+    size_t blockSize;
+    void* freeLists[sizeof(size_t) * 8];
+    size_t reserved;
+
+    /*
+     * This method allocates a new block which can
+     * hold at least the given number of bytes.
+     *
+     * Parameters:
+     *  1) bytes - The size of the allocation that did
+     *             not fit in the current block
+     *
+     */
+    void grow(size_t bytes);
+
+    /* Returns whether released pieces of a size are kept for reuse */
+    static bool isReusable(size_t bytes) {
+        return bytes >= sizeof(void*) && (bytes & (bytes - 1)) == 0;
+    }
+
+  public:
+    // Size of the first block; each next one doubles up to the maximum
+    static const size_t FIRST_BLOCK_SIZE = 1 << 16;
+    static const size_t MAX_BLOCK_SIZE = 1 << 24;
+
+    /*
+     * This is the contructor method for the arena.
+     * No memory is allocated until it is used.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    Arena();
+
+    // The blocks are freed once, by the destructor
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /*
+     * The purpose of this method is to return room
+     * for the given number of bytes.
+     *
+     * Parameters:
+     *  1) bytes - The number of bytes needed
+     *  2) alignment - A power of two the address must
+     *                 be a multiple of
+     *
+     */
+    void* allocate(size_t bytes, size_t alignment = alignof(max_align_t)) {
+        // Released pieces are only known to be pointer aligned
+        if (isReusable(bytes) && alignment <= sizeof(void*)) {
+            void*& freeList = this->freeLists[__builtin_ctzl(bytes)];
+            if (freeList != nullptr) {
+                void* piece = freeList;
+                freeList = *(void**)piece;
+                return piece;
+            }
+        }
+        size_t padding = -(size_t)this->next & (alignment - 1);
+        if (bytes + padding > (size_t)(this->end - this->next)) {
+            this->grow(bytes + alignment);
+            padding = -(size_t)this->next & (alignment - 1);
+        }
+        void* piece = this->next + padding;
+        this->next += padding + bytes;
+        return piece;
+    }
+
+    /*
+     * The purpose of this method is to hand back
+     * memory that is no longer used. Only power of
+     * two sized pieces are reused; anything else
+     * stays unused until the arena is destroyed.
+     *
+     * Parameters:
+     *  1) piece - Memory returned by allocate
+     *  2) bytes - The size it was allocated with
+     *
+     */
+    void release(void* piece, size_t bytes) {
+        if (isReusable(bytes) && (size_t)piece % sizeof(void*) == 0) {
+            void*& freeList = this->freeLists[__builtin_ctzl(bytes)];
+            *(void**)piece = freeList;
+            freeList = piece;
+        }
+    }
+
+    /* Constructs an object in the arena and returns it */
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        return new (this->allocate(sizeof(T), alignof(T)))
+            T(std::forward<Args>(args)...);
+    }
+
+    /* Returns the number of bytes the arena got from the system */
+    size_t memoryUsage() const { return this->reserved; }
+
+    /*
+     * This is the destructor method. It frees every
+     * block without running any destructor.
+     *
+     */
+    ~Arena();
+};
+
+/**
+ * The ArenaAllocator class lets standard containers
+ * take their memory from an arena.
+ *
+ * Instance variables:
+ *  1) arena - The arena the memory comes from
+ */
+template <typename T>
+class ArenaAllocator {
+  public:
+    typedef T value_type;
+
+    Arena* arena;
+
+    /* Makes an allocator that uses the given arena */
+    explicit ArenaAllocator(Arena& arena) : arena(&arena) {}
+
+    /* Makes an allocator for T that uses the same arena */
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    /* Returns room for count objects of type T */
+    T* allocate(size_t count) {
+        return (T*)this->arena->allocate(count * sizeof(T), alignof(T));
+    }
+
+    /* Hands back room for count objects of type T */
+    void deallocate(T* objects, size_t count) {
+        this->arena->release(objects, count * sizeof(T));
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.arena == b.arena;
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.arena != b.arena;
+}
+
+#endif  // ARENA_HPP
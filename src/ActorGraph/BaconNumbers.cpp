@@ -0,0 +1,147 @@
+/**
+ * The BaconNumbers class runs a BFS from a center
+ * actor one level at a time, with the actors of a
+ * level split into tasks that threads take in turn.
+ *
+ * Instance variables:
+ *  1) centerId - The actor the distances are from
+ *
+ *  2) distances - The number of movies between the
+ *                 center and every actor by id
+ *
+ *  3) histogram - The number of actors at each
+ *                 distance from the center
+ *
+ *  4) farthest - The actors at the largest distance
+ *                from the center, ascending
+ *
+ *  5) numReached - The number of actors connected to
+ *                  the center, counting the center
+ */
+
+#include "BaconNumbers.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include "Parallel.hpp"
+
+using namespace std;
+
+const unsigned int BaconNumbers::NO_DISTANCE;
+const size_t BaconNumbers::ACTORS_PER_TASK;
+
+/*
+ * This function sets the bit of a node in a bitmap
+ * that several threads share. Returns true if this
+ * call set it, false if it was already set. The bit
+ * is read first so a node claimed long ago costs no
+ * atomic write.
+ *
+ * Parameters:
+ *  1) seen - The bitmap of the claimed nodes
+ *  2) id - The node to claim
+ *
+ */
+static inline bool claim(vector<atomic<uint64_t>>& seen, unsigned int id) {
+    uint64_t bit = 1ull << (id & 63);
+    atomic<uint64_t>& word = seen[id >> 6];
+    if (word.load(memory_order_relaxed) & bit) {
+        return false;
+    }
+    return !(word.fetch_or(bit, memory_order_relaxed) & bit);
+}
+
+/*
+ * This is the contructor method for the numbers.
+ * They are empty until the first run.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+BaconNumbers::BaconNumbers() {
+    this->centerId = CSRGraph::NO_ID;
+    this->numReached = 0;
+}
+
+/*
+ * This method finds the distance of every actor
+ * of a graph from a center actor.
+ *
+ * Parameters:
+ *  1) graph - The graph to search
+ *  2) centerId - The actor to start from
+ *  3) numThreads - The number of threads to use
+ *
+ */
+void BaconNumbers::run(const CSRGraph& graph, unsigned int centerId,
+                       unsigned int numThreads) {
+    unsigned int numActors = graph.numActors();
+    this->centerId = centerId;
+    this->distances.assign(numActors, NO_DISTANCE);
+    this->histogram.clear();
+    this->farthest.clear();
+    this->numReached = 0;
+    if (centerId >= numActors) {
+        return;
+    }
+    vector<atomic<uint64_t>> actorSeen((numActors + 63) / 64);
+    vector<atomic<uint64_t>> movieSeen((graph.numMovies() + 63) / 64);
+    for (size_t w = 0; w < actorSeen.size(); w++) {
+        actorSeen[w].store(0, memory_order_relaxed);
+    }
+    for (size_t w = 0; w < movieSeen.size(); w++) {
+        movieSeen[w].store(0, memory_order_relaxed);
+    }
+
+    claim(actorSeen, centerId);
+    this->distances[centerId] = 0;
+    vector<unsigned int> frontier(1, centerId);
+    vector<vector<unsigned int>> parts;
+    for (unsigned int level = 0; !frontier.empty(); level++) {
+        this->histogram.push_back(frontier.size());
+        this->numReached += frontier.size();
+
+        // Each task expands a slice of the level into its own part
+        size_t numTasks =
+            (frontier.size() + ACTORS_PER_TASK - 1) / ACTORS_PER_TASK;
+        parts.resize(max(parts.size(), numTasks));
+        parallelFor(numThreads, numTasks, [&](size_t task) {
+            vector<unsigned int>& next = parts[task];
+            next.clear();
+            size_t last = min(frontier.size(), (task + 1) * ACTORS_PER_TASK);
+            for (size_t i = task * ACTORS_PER_TASK; i < last; i++) {
+                unsigned int actor = frontier[i];
+                for (auto movie = graph.moviesBegin(actor);
+                     movie != graph.moviesEnd(actor); movie++) {
+                    if (!claim(movieSeen, *movie)) {
+                        continue;
+                    }
+                    for (auto costar = graph.actorsBegin(*movie);
+                         costar != graph.actorsEnd(*movie); costar++) {
+                        if (claim(actorSeen, *costar)) {
+                            this->distances[*costar] = level + 1;
+                            next.push_back(*costar);
+                        }
+                    }
+                }
+            }
+        });
+
+        // The last level found anything is the farthest one
+        size_t nextSize = 0;
+        for (size_t t = 0; t < numTasks; t++) {
+            nextSize += parts[t].size();
+        }
+        if (nextSize == 0) {
+            this->farthest.swap(frontier);
+            break;
+        }
+        frontier.clear();
+        frontier.reserve(nextSize);
+        for (size_t t = 0; t < numTasks; t++) {
+            frontier.insert(frontier.end(), parts[t].begin(), parts[t].end());
+        }
+    }
+    sort(this->farthest.begin(), this->farthest.end());
+}
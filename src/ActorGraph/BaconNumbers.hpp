@@ -0,0 +1,119 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Sources used:
+ *  1) Leiserson and Schardl, "A Work-Efficient Parallel
+ *     Breadth-First Search Algorithm", SPAA 2010
+ *
+ * Description of File:
+ *  This file defines the degrees of separation of
+ *  every actor from one center actor, the way Bacon
+ *  numbers count the movies between an actor and
+ *  Kevin Bacon, found with one BFS whose levels are
+ *  spread over several threads.
+ */
+
+#ifndef BACONNUMBERS_HPP
+#define BACONNUMBERS_HPP
+
+#include <cstddef>
+#include <vector>
+#include "CSRGraph.hpp"
+
+using namespace std;
+
+/**
+ * The BaconNumbers class runs a BFS from a center
+ * actor one level at a time. The actors of a level
+ * are split into tasks that threads take in turn,
+ * and each task expands its actors through their
+ * movies into a list of its own. A movie or actor is
+ * claimed by setting its bit in a shared bitmap, so
+ * each is expanded by one task only. The lists of
+ * the tasks make up the next level once every task
+ * is done. Which task reaches an actor depends on
+ * the threads, but its level does not.
+ *
+ * Instance variables:
+ *  1) centerId - The actor the distances are from
+ *
+ *  2) distances - The number of movies between the
+ *                 center and every actor by id
+ *
+ *  3) histogram - The number of actors at each
+ *                 distance from the center
+ *
+ *  4) farthest - The actors at the largest distance
+ *                from the center, ascending
+ *
+ *  5) numReached - The number of actors connected to
+ *                  the center, counting the center
+ */
+class BaconNumbers {
+  protected:
+    unsigned int centerId;
+    vector<unsigned int> distances;
+    vector<size_t> histogram;
+    vector<unsigned int> farthest;
+    size_t numReached;
+
+  public:
+    // Distance of an actor not connected to the center
+    static const unsigned int NO_DISTANCE = 0xFFFFFFFFu;
+    // Number of actors of a level each thread takes at a time
+    static const size_t ACTORS_PER_TASK = 256;
+
+    /*
+     * This is the contructor method for the numbers.
+     * They are empty until the first run.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    BaconNumbers();
+
+    /*
+     * This method finds the distance of every actor
+     * of a graph from a center actor.
+     *
+     * Parameters:
+     *  1) graph - The graph to search
+     *  2) centerId - The actor to start from
+     *  3) numThreads - The number of threads to use
+     *
+     */
+    void run(const CSRGraph& graph, unsigned int centerId,
+             unsigned int numThreads = 1);
+
+    /* Returns the actor the distances are from */
+    unsigned int getCenter() const { return this->centerId; }
+
+    /* Returns the distance of an actor, or NO_DISTANCE */
+    unsigned int getDistance(unsigned int actorId) const {
+        return this->distances[actorId];
+    }
+
+    /* Returns the distance of every actor by id */
+    const vector<unsigned int>& getDistances() const {
+        return this->distances;
+    }
+
+    /* Returns the number of actors at each distance */
+    const vector<size_t>& getHistogram() const { return this->histogram; }
+
+    /* Returns the largest distance of a connected actor */
+    unsigned int getMaxDistance() const {
+        return this->histogram.empty() ? 0 : this->histogram.size() - 1;
+    }
+
+    /* Returns the actors at the largest distance, ascending */
+    const vector<unsigned int>& getFarthest() const { return this->farthest; }
+
+    /* Returns the number of actors connected to the center */
+    size_t getNumReached() const { return this->numReached; }
+};
+
+#endif  // BACONNUMBERS_HPP
@@ -0,0 +1,304 @@
+/**
+ * The CSRGraph class freezes a built actor graph into
+ * two CSR arrays: actor -> movies and movie -> actors.
+ * Actors and movies are both identified by a dense id
+ * which is the index of the node in the vectors given
+ * to the constructor.
+ *
+ * Instance variables:
+ *  1) actorCount - The number of actors
+ *
+ *  2) movieCount - The number of movies
+ *
+ *  3) actorOffsets - Start of each actor's movies
+ *
+ *  4) actorMovies - The movie ids of every actor
+ *
+ *  5) movieOffsets - Start of each movie's actors
+ *
+ *  6) movieActors - The actor ids of every movie
+ *
+ *  7) movieYears - The release year of every movie
+ *
+ *  8) ownedIds - Storage of the id arrays
+ *
+ *  9) ownedYears - Storage of the years
+ *
+ *  10) latestYear - The year of the newest movie
+ */
+
+#include "CSRGraph.hpp"
+#include <algorithm>
+#include "Checksum.hpp"
+
+using namespace std;
+
+const unsigned int CSRGraph::NO_ID;
+
+/*
+ * This is the contructor method for the CSR graph.
+ * It copies the edges of every node into the
+ * contiguous arrays. The id of each node must be
+ * its index in the given vector.
+ *
+ * Parameters:
+ *  1) actors - The actor nodes ordered by id
+ *  2) movies - The movie nodes ordered by id
+ *  3) years - The release year of each movie
+ *
+ */
+CSRGraph::CSRGraph(const vector<ActorNode*>& actors,
+                   const vector<MovieNode*>& movies, const vector<int>& years)
+    : ownedYears(years) {
+    this->actorCount = actors.size();
+    this->movieCount = movies.size();
+
+    // Count the edges first so the arrays are allocated once
+    size_t numEdges = 0;
+    for (unsigned int a = 0; a < actors.size(); a++) {
+        numEdges += actors[a]->inMovies()->size();
+    }
+    this->ownedIds.reserve(actors.size() + movies.size() + 2 + 2 * numEdges);
+    vector<unsigned int>& ids = this->ownedIds;
+
+    // Copy the movie edges of each actor, after their offsets
+    ids.push_back(0);
+    size_t count = 0;
+    for (unsigned int a = 0; a < actors.size(); a++) {
+        count += actors[a]->inMovies()->size();
+        ids.push_back(count);
+    }
+    for (unsigned int a = 0; a < actors.size(); a++) {
+        auto ofMovies = actors[a]->inMovies();
+        for (unsigned int i = 0; i < ofMovies->size(); i++) {
+            ids.push_back(ofMovies->at(i)->getId());
+        }
+    }
+
+    // Copy the actors linked by each movie, after their offsets
+    ids.push_back(0);
+    count = 0;
+    for (unsigned int m = 0; m < movies.size(); m++) {
+        count += movies[m]->actorsInMovie()->size();
+        ids.push_back(count);
+    }
+    for (unsigned int m = 0; m < movies.size(); m++) {
+        auto ofActors = movies[m]->actorsInMovie();
+        for (unsigned int i = 0; i < ofActors->size(); i++) {
+            ids.push_back(ofActors->at(i)->getId());
+        }
+    }
+
+    // The storage is complete, so it will not move any more
+    this->actorOffsets = ids.data();
+    this->actorMovies = this->actorOffsets + actors.size() + 1;
+    this->movieOffsets = this->actorMovies + numEdges;
+    this->movieActors = this->movieOffsets + movies.size() + 1;
+    this->movieYears = this->ownedYears.data();
+    this->findLatestYear();
+}
+
+/*
+ * This is the contructor method for a CSR graph
+ * whose arrays are stored elsewhere, such as in a
+ * snapshot. Nothing is copied, so the arrays must
+ * outlive the graph.
+ *
+ * Parameters:
+ *  1) numActors - The number of actors
+ *  2) numMovies - The number of movies
+ *  3) actorOffsets - The numActors + 1 offsets
+ *                    into actorMovies
+ *  4) actorMovies - The movies of every actor
+ *  5) movieOffsets - The numMovies + 1 offsets
+ *                    into movieActors
+ *  6) movieActors - The actors of every movie
+ *  7) movieYears - The year of every movie
+ *
+ */
+CSRGraph::CSRGraph(unsigned int numActors, unsigned int numMovies,
+                   const unsigned int* actorOffsets,
+                   const unsigned int* actorMovies,
+                   const unsigned int* movieOffsets,
+                   const unsigned int* movieActors, const int* movieYears) {
+    this->actorCount = numActors;
+    this->movieCount = numMovies;
+    this->actorOffsets = actorOffsets;
+    this->actorMovies = actorMovies;
+    this->movieOffsets = movieOffsets;
+    this->movieActors = movieActors;
+    this->movieYears = movieYears;
+    this->findLatestYear();
+}
+
+/*
+ * This is the contructor method for a renumbered
+ * copy of a CSR graph. New actor i is old actor
+ * actorOrder[i], and likewise for the movies. The
+ * lists of every node are sorted by the new ids.
+ *
+ * Parameters:
+ *  1) graph - The graph to copy
+ *  2) actorOrder - The old id of each new actor
+ *  3) movieOrder - The old id of each new movie
+ *
+ */
+CSRGraph::CSRGraph(const CSRGraph& graph,
+                   const vector<unsigned int>& actorOrder,
+                   const vector<unsigned int>& movieOrder) {
+    this->actorCount = graph.numActors();
+    this->movieCount = graph.numMovies();
+    size_t numEdges = graph.numEdges();
+    vector<unsigned int> actorRanks(this->actorCount);
+    for (unsigned int a = 0; a < this->actorCount; a++) {
+        actorRanks[actorOrder[a]] = a;
+    }
+    vector<unsigned int> movieRanks(this->movieCount);
+    for (unsigned int m = 0; m < this->movieCount; m++) {
+        movieRanks[movieOrder[m]] = m;
+    }
+    this->ownedIds.reserve(this->actorCount + this->movieCount + 2 +
+                           2 * numEdges);
+    vector<unsigned int>& ids = this->ownedIds;
+
+    // Copy the renumbered movies of each actor, after their offsets
+    ids.push_back(0);
+    for (unsigned int a = 0; a < this->actorCount; a++) {
+        unsigned int old = actorOrder[a];
+        size_t count = graph.moviesEnd(old) - graph.moviesBegin(old);
+        ids.push_back(ids.back() + count);
+    }
+    for (unsigned int a = 0; a < this->actorCount; a++) {
+        unsigned int old = actorOrder[a];
+        size_t first = ids.size();
+        for (auto movie = graph.moviesBegin(old); movie != graph.moviesEnd(old);
+             movie++) {
+            ids.push_back(movieRanks[*movie]);
+        }
+        sort(ids.begin() + first, ids.end());
+    }
+
+    // Copy the renumbered actors of each movie, after their offsets
+    ids.push_back(0);
+    for (unsigned int m = 0; m < this->movieCount; m++) {
+        unsigned int old = movieOrder[m];
+        size_t count = graph.actorsEnd(old) - graph.actorsBegin(old);
+        ids.push_back(ids.back() + count);
+    }
+    for (unsigned int m = 0; m < this->movieCount; m++) {
+        unsigned int old = movieOrder[m];
+        size_t first = ids.size();
+        for (auto actor = graph.actorsBegin(old); actor != graph.actorsEnd(old);
+             actor++) {
+            ids.push_back(actorRanks[*actor]);
+        }
+        sort(ids.begin() + first, ids.end());
+        this->ownedYears.push_back(graph.getMovieYear(old));
+    }
+
+    this->actorOffsets = ids.data();
+    this->actorMovies = this->actorOffsets + this->actorCount + 1;
+    this->movieOffsets = this->actorMovies + numEdges;
+    this->movieActors = this->movieOffsets + this->movieCount + 1;
+    this->movieYears = this->ownedYears.data();
+    this->findLatestYear();
+}
+
+/*
+ * The purpose of this method is to set latestYear
+ * from the years of the movies.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+void CSRGraph::findLatestYear() {
+    this->latestYear = 0;
+    if (this->movieCount > 0) {
+        this->latestYear =
+            *max_element(this->movieYears, this->movieYears + this->movieCount);
+    }
+}
+
+/*
+ * The purpose of this method is to return the
+ * first movie of an actor that another actor was
+ * also in, or NO_ID if they share none.
+ *
+ * Parameters:
+ *  1) actorId - The actor whose movies are tried
+ *  2) otherId - The other actor
+ *
+ */
+unsigned int CSRGraph::sharedMovie(unsigned int actorId,
+                                   unsigned int otherId) const {
+    for (auto movie = this->moviesBegin(actorId);
+         movie != this->moviesEnd(actorId); movie++) {
+        if (find(this->actorsBegin(*movie), this->actorsEnd(*movie),
+                 otherId) != this->actorsEnd(*movie)) {
+            return *movie;
+        }
+    }
+    return NO_ID;
+}
+
+/*
+ * The purpose of this method is to return the
+ * number of co-star slots of an actor, which is
+ * the size of the casts of their movies not
+ * counting the actor.
+ *
+ * Parameters:
+ *  1) actorId - The actor to count for
+ *
+ */
+size_t CSRGraph::numCoStars(unsigned int actorId) const {
+    size_t count = 0;
+    for (auto movie = this->moviesBegin(actorId);
+         movie != this->moviesEnd(actorId); movie++) {
+        count += this->actorsEnd(*movie) - this->actorsBegin(*movie) - 1;
+    }
+    return count;
+}
+
+/*
+ * The purpose of this method is to return a
+ * checksum of the edges of the graph, which tells
+ * apart graphs whose actors or movies have other
+ * ids. Years are left out.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+uint64_t CSRGraph::fingerprint() const {
+    Checksum checksum;
+    checksum.add((const char*)this->actorOffsets,
+                 sizeof(unsigned int) * ((size_t)this->actorCount + 1));
+    checksum.add((const char*)this->actorMovies,
+                 sizeof(unsigned int) * this->numEdges());
+    checksum.add((const char*)this->movieOffsets,
+                 sizeof(unsigned int) * ((size_t)this->movieCount + 1));
+    checksum.add((const char*)this->movieActors,
+                 sizeof(unsigned int) * this->numEdges());
+    // Only whole words are hashed, so finish the last one
+    if ((this->actorCount + this->movieCount) % 2 == 1) {
+        unsigned int padding = 0;
+        checksum.add((const char*)&padding, sizeof(padding));
+    }
+    return checksum.finish();
+}
+
+/*
+ * The purpose of this method is to return the
+ * number of bytes used by the CSR arrays, not
+ * counting arrays mapped from elsewhere.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+size_t CSRGraph::memoryUsage() const {
+    return sizeof(unsigned int) * this->ownedIds.capacity() +
+           sizeof(int) * this->ownedYears.capacity();
+}
@@ -0,0 +1,251 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Sources used:
+ *  1) Stepik: Introduction to Data Structures (Fall 2016)
+ *     by Moshiri and Izhikevich (available at stepik.org)
+ *
+ * Description of File:
+ *  This file defines a compact, read only copy of the
+ *  actor/movie graph. The adjacency of every actor and
+ *  every movie is stored in compressed sparse row (CSR)
+ *  form so that a search walks contiguous arrays of
+ *  integer ids instead of chasing node pointers.
+ *  The arrays can also be mapped from a snapshot.
+ */
+
+#ifndef CSRGRAPH_HPP
+#define CSRGRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ActorNode.hpp"
+#include "MovieNode.hpp"
+
+using namespace std;
+
+/**
+ * The CSRGraph class freezes a built actor graph into
+ * two CSR arrays: actor -> movies and movie -> actors.
+ * Actors and movies are both identified by a dense id
+ * which is the index of the node in the vectors given
+ * to the constructor. The neighbours of an actor are
+ * kept in the same order as its list of movie edges.
+ *
+ * Instance variables:
+ *  1) actorCount - The number of actors
+ *
+ *  2) movieCount - The number of movies
+ *
+ *  3) actorOffsets - actorMovies[actorOffsets[a] ..
+ *                    actorOffsets[a + 1]) are the
+ *                    movies of actor a
+ *
+ *  4) actorMovies - The movie ids of every actor,
+ *                   stored back to back
+ *
+ *  5) movieOffsets - movieActors[movieOffsets[m] ..
+ *                    movieOffsets[m + 1]) are the
+ *                    actors of movie m
+ *
+ *  6) movieActors - The actor ids of every movie,
+ *                   stored back to back
+ *
+ *  7) movieYears - The release year of every movie
+ *
+ *  8) ownedIds - The storage of the four id arrays
+ *                when they are not mapped
+ *
+ *  9) ownedYears - The storage of movieYears when
+ *                  it is not mapped
+ *
+ *  10) latestYear - The year of the newest movie
+ */
+class CSRGraph {
+  protected:
+    unsigned int actorCount;
+    unsigned int movieCount;
+    const unsigned int* actorOffsets;
+    const unsigned int* actorMovies;
+    const unsigned int* movieOffsets;
+    const unsigned int* movieActors;
+    const int* movieYears;
+    vector<unsigned int> ownedIds;
+    vector<int> ownedYears;
+    int latestYear;
+
+    /*
+     * The purpose of this method is to set latestYear
+     * from the years of the movies.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    void findLatestYear();
+
+  public:
+    // Id used to mark an actor or a movie that does not exist
+    static const unsigned int NO_ID = 0xFFFFFFFFu;
+
+    /*
+     * This is the contructor method for the CSR graph.
+     * It copies the edges of every node into the
+     * contiguous arrays. The id of each node must be
+     * its index in the given vector.
+     *
+     * Parameters:
+     *  1) actors - The actor nodes ordered by id
+     *  2) movies - The movie nodes ordered by id
+     *  3) years - The release year of each movie
+     *
+     */
+    CSRGraph(const vector<ActorNode*>& actors,
+             const vector<MovieNode*>& movies, const vector<int>& years);
+
+    /*
+     * This is the contructor method for a CSR graph
+     * whose arrays are stored elsewhere, such as in a
+     * snapshot. Nothing is copied, so the arrays must
+     * outlive the graph.
+     *
+     * Parameters:
+     *  1) numActors - The number of actors
+     *  2) numMovies - The number of movies
+     *  3) actorOffsets - The numActors + 1 offsets
+     *                    into actorMovies
+     *  4) actorMovies - The movies of every actor
+     *  5) movieOffsets - The numMovies + 1 offsets
+     *                    into movieActors
+     *  6) movieActors - The actors of every movie
+     *  7) movieYears - The year of every movie
+     *
+     */
+    CSRGraph(unsigned int numActors, unsigned int numMovies,
+             const unsigned int* actorOffsets, const unsigned int* actorMovies,
+             const unsigned int* movieOffsets, const unsigned int* movieActors,
+             const int* movieYears);
+
+    /*
+     * This is the contructor method for a renumbered
+     * copy of a CSR graph. New actor i is old actor
+     * actorOrder[i], and likewise for the movies. The
+     * lists of every node are sorted by the new ids.
+     *
+     * Parameters:
+     *  1) graph - The graph to copy
+     *  2) actorOrder - The old id of each new actor
+     *  3) movieOrder - The old id of each new movie
+     *
+     */
+    CSRGraph(const CSRGraph& graph, const vector<unsigned int>& actorOrder,
+             const vector<unsigned int>& movieOrder);
+
+    // The arrays may point into the graph's own storage
+    CSRGraph(const CSRGraph&) = delete;
+    CSRGraph& operator=(const CSRGraph&) = delete;
+
+    /* Returns the number of actors in the graph */
+    unsigned int numActors() const { return this->actorCount; }
+
+    /* Returns the number of movies in the graph */
+    unsigned int numMovies() const { return this->movieCount; }
+
+    /* Returns the number of actor-movie edges in the graph */
+    size_t numEdges() const { return this->actorOffsets[this->actorCount]; }
+
+    /* Returns a pointer to the first movie id of an actor */
+    const unsigned int* moviesBegin(unsigned int actorId) const {
+        return this->actorMovies + this->actorOffsets[actorId];
+    }
+
+    /* Returns a pointer one past the last movie id of an actor */
+    const unsigned int* moviesEnd(unsigned int actorId) const {
+        return this->actorMovies + this->actorOffsets[actorId + 1];
+    }
+
+    /* Returns a pointer to the first actor id of a movie */
+    const unsigned int* actorsBegin(unsigned int movieId) const {
+        return this->movieActors + this->movieOffsets[movieId];
+    }
+
+    /* Returns a pointer one past the last actor id of a movie */
+    const unsigned int* actorsEnd(unsigned int movieId) const {
+        return this->movieActors + this->movieOffsets[movieId + 1];
+    }
+
+    /* Returns the release year of a movie */
+    int getMovieYear(unsigned int movieId) const {
+        return this->movieYears[movieId];
+    }
+
+    /*
+     * The purpose of this method is to return the
+     * first movie of an actor that another actor was
+     * also in, or NO_ID if they share none.
+     *
+     * Parameters:
+     *  1) actorId - The actor whose movies are tried
+     *  2) otherId - The other actor
+     *
+     */
+    unsigned int sharedMovie(unsigned int actorId, unsigned int otherId) const;
+
+    /*
+     * The purpose of this method is to return the
+     * number of co-star slots of an actor, which is
+     * the size of the casts of their movies not
+     * counting the actor.
+     *
+     * Parameters:
+     *  1) actorId - The actor to count for
+     *
+     */
+    size_t numCoStars(unsigned int actorId) const;
+
+    /* Returns the year of the newest movie, 0 if there are none */
+    int getLatestYear() const { return this->latestYear; }
+
+    /* Returns the offsets of the movies of every actor */
+    const unsigned int* getActorOffsets() const { return this->actorOffsets; }
+
+    /* Returns the movies of every actor, back to back */
+    const unsigned int* getActorMovies() const { return this->actorMovies; }
+
+    /* Returns the offsets of the actors of every movie */
+    const unsigned int* getMovieOffsets() const { return this->movieOffsets; }
+
+    /* Returns the actors of every movie, back to back */
+    const unsigned int* getMovieActors() const { return this->movieActors; }
+
+    /* Returns the release year of every movie */
+    const int* getMovieYears() const { return this->movieYears; }
+
+    /*
+     * The purpose of this method is to return a
+     * checksum of the edges of the graph, which tells
+     * apart graphs whose actors or movies have other
+     * ids. Years are left out.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    uint64_t fingerprint() const;
+
+    /*
+     * The purpose of this method is to return the
+     * number of bytes used by the CSR arrays, not
+     * counting arrays mapped from elsewhere.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    size_t memoryUsage() const;
+};
+
+#endif  // CSRGRAPH_HPP
@@ -0,0 +1,94 @@
+/**
+ * The CastBitsets class keeps a bitset of the cast of
+ * every movie with at least minCast actors, spanning
+ * the words from its first to its last actor.
+ *
+ * Instance variables:
+ *  1) minCast - The fewest actors of a kept cast
+ *
+ *  2) movieIds - The movies with a bitset, ascending
+ *
+ *  3) firstWords - The first word of each bitset
+ *
+ *  4) starts - The start of each bitset in words
+ *
+ *  5) words - The words of every bitset
+ */
+
+#include "CastBitsets.hpp"
+#include <algorithm>
+
+using namespace std;
+
+const unsigned int CastBitsets::NO_BITSET;
+const unsigned int CastBitsets::DEFAULT_MIN_CAST;
+
+/*
+ * This is the contructor method for the bitsets.
+ * It builds the bitset of every large enough cast.
+ *
+ * Parameters:
+ *  1) graph - The graph whose casts are kept
+ *  2) minCast - The fewest actors a movie needs
+ *
+ */
+CastBitsets::CastBitsets(const CSRGraph& graph, unsigned int minCast) {
+    this->minCast = minCast;
+    this->starts.push_back(0);
+    for (unsigned int m = 0; m < graph.numMovies(); m++) {
+        size_t castSize = graph.actorsEnd(m) - graph.actorsBegin(m);
+        if (castSize == 0 || castSize < minCast) {
+            continue;
+        }
+        unsigned int first =
+            *min_element(graph.actorsBegin(m), graph.actorsEnd(m)) / 64;
+        unsigned int last =
+            *max_element(graph.actorsBegin(m), graph.actorsEnd(m)) / 64;
+        // A sparse cast is read faster as a list
+        if (last - first + 1 > castSize) {
+            continue;
+        }
+        size_t start = this->words.size();
+        this->words.resize(start + last - first + 1, 0);
+        for (auto actor = graph.actorsBegin(m); actor != graph.actorsEnd(m);
+             actor++) {
+            this->words[start + *actor / 64 - first] |= 1ull << (*actor % 64);
+        }
+        this->movieIds.push_back(m);
+        this->firstWords.push_back(first);
+        this->starts.push_back(this->words.size());
+    }
+}
+
+/*
+ * The purpose of this method is to return the
+ * index of the bitset of a movie, or NO_BITSET
+ * if its cast is not kept as one.
+ *
+ * Parameters:
+ *  1) movieId - The movie to look for
+ *
+ */
+unsigned int CastBitsets::find(unsigned int movieId) const {
+    auto found =
+        lower_bound(this->movieIds.begin(), this->movieIds.end(), movieId);
+    if (found == this->movieIds.end() || *found != movieId) {
+        return NO_BITSET;
+    }
+    return (unsigned int)(found - this->movieIds.begin());
+}
+
+/*
+ * The purpose of this method is to return the
+ * number of bytes used by the bitsets.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+size_t CastBitsets::memoryUsage() const {
+    return sizeof(unsigned int) *
+               (this->movieIds.capacity() + this->firstWords.capacity()) +
+           sizeof(size_t) * this->starts.capacity() +
+           sizeof(uint64_t) * this->words.capacity();
+}
@@ -0,0 +1,117 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Description of File:
+ *  This file defines the casts of the largest movies
+ *  kept as bitsets over the actor ids, so a search
+ *  can reach a whole cast a 64 bit word at a time
+ *  instead of checking every actor one by one.
+ */
+
+#ifndef CASTBITSETS_HPP
+#define CASTBITSETS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CSRGraph.hpp"
+
+using namespace std;
+
+/**
+ * The CastBitsets class keeps a bitset of the cast of
+ * every movie with at least minCast actors. A bitset
+ * only spans the words from the first to the last
+ * actor of the cast, and is only kept when it has no
+ * more words than the cast has actors, so scanning it
+ * is never more work than reading the cast.
+ *
+ * Instance variables:
+ *  1) minCast - The fewest actors a movie needs for
+ *               its cast to be kept as a bitset
+ *
+ *  2) movieIds - The movies with a bitset, ascending
+ *
+ *  3) firstWords - The index of the first word of
+ *                  each bitset among all the words
+ *                  of a bitset of every actor
+ *
+ *  4) starts - The start of each bitset in words,
+ *              followed by the number of words
+ *
+ *  5) words - The words of every bitset, back to back
+ */
+class CastBitsets {
+  protected:
+    unsigned int minCast;
+    vector<unsigned int> movieIds;
+    vector<unsigned int> firstWords;
+    vector<size_t> starts;
+    vector<uint64_t> words;
+
+  public:
+    // Index returned for a movie without a bitset
+    static const unsigned int NO_BITSET = 0xFFFFFFFFu;
+    // Fewest actors kept by default, which no cast reaches, so a
+    // graph keeps no bitsets until they are asked for
+    static const unsigned int DEFAULT_MIN_CAST = 0xFFFFFFFFu;
+
+    /*
+     * This is the contructor method for the bitsets.
+     * It builds the bitset of every large enough cast.
+     *
+     * Parameters:
+     *  1) graph - The graph whose casts are kept
+     *  2) minCast - The fewest actors a movie needs
+     *               for its cast to be kept
+     *
+     */
+    CastBitsets(const CSRGraph& graph,
+                unsigned int minCast = DEFAULT_MIN_CAST);
+
+    /* Returns the fewest actors a kept cast has */
+    unsigned int getMinCast() const { return this->minCast; }
+
+    /* Returns the number of casts kept as bitsets */
+    unsigned int size() const { return (unsigned int)this->movieIds.size(); }
+
+    /*
+     * The purpose of this method is to return the
+     * index of the bitset of a movie, or NO_BITSET
+     * if its cast is not kept as one.
+     *
+     * Parameters:
+     *  1) movieId - The movie to look for
+     *
+     */
+    unsigned int find(unsigned int movieId) const;
+
+    /* Returns the index of the first word of a bitset over all actors */
+    unsigned int getFirstWord(unsigned int bitset) const {
+        return this->firstWords[bitset];
+    }
+
+    /* Returns the number of words of a bitset */
+    size_t getNumWords(unsigned int bitset) const {
+        return this->starts[bitset + 1] - this->starts[bitset];
+    }
+
+    /* Returns the words of a bitset */
+    const uint64_t* getWords(unsigned int bitset) const {
+        return this->words.data() + this->starts[bitset];
+    }
+
+    /*
+     * The purpose of this method is to return the
+     * number of bytes used by the bitsets.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    size_t memoryUsage() const;
+};
+
+#endif  // CASTBITSETS_HPP
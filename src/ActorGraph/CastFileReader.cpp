@@ -0,0 +1,243 @@
+/**
+ * The CastFileReader class maps a cast file of
+ * ActorName <tab> MovieName <tab> Year rows and hands
+ * them out one at a time.
+ *
+ * Instance variables:
+ *  1) data - The start of the mapped file
+ *
+ *  2) size - The number of bytes in the file
+ *
+ *  3) position - The offset of the next line to read
+ *
+ *  4) opened - Whether the file could be mapped
+ *
+ *  5) ownedData - The bytes of a file that cannot be
+ *                 mapped, such as a pipe
+ */
+
+#include "CastFileReader.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+using namespace std;
+
+/*
+ * This is the contructor method for the reader.
+ * It maps the whole file and skips its header. A
+ * pipe or other file that cannot be mapped is read
+ * into memory instead.
+ *
+ * Parameters:
+ *  1) filename - The name of the cast file
+ *
+ */
+CastFileReader::CastFileReader(const char* filename) {
+    this->data = nullptr;
+    this->size = 0;
+    this->position = 0;
+    this->opened = false;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info;
+    bool hasInfo = fstat(fd, &info) == 0;
+    if (hasInfo && !S_ISREG(info.st_mode)) {
+        // A pipe has no size to map, so read it until it ends
+        char buffer[1 << 16];
+        ssize_t count;
+        while ((count = read(fd, buffer, sizeof(buffer))) > 0) {
+            this->ownedData.insert(this->ownedData.end(), buffer,
+                                   buffer + count);
+        }
+        this->opened = count == 0;
+        if (this->opened && !this->ownedData.empty()) {
+            this->data = this->ownedData.data();
+            this->size = this->ownedData.size();
+        }
+    } else if (hasInfo) {
+        this->opened = true;
+        this->size = info.st_size;
+    }
+    // An empty file has nothing to map
+    if (this->opened && this->size > 0 && this->ownedData.empty()) {
+        void* mapping =
+            mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            this->opened = false;
+            this->size = 0;
+        } else {
+            this->data = (const char*)mapping;
+            madvise(mapping, this->size, MADV_SEQUENTIAL);
+        }
+    }
+    // The mapping stays valid once the file is closed
+    close(fd);
+
+    // skip the header of the file
+    if (this->data != nullptr) {
+        const char* end = (const char*)memchr(this->data, '\n', this->size);
+        this->position = end == nullptr ? this->size : end - this->data + 1;
+    }
+}
+
+/*
+ * The purpose of this method is to read the next
+ * well formed row of the file. Returns false once
+ * the end of the file is reached.
+ *
+ * Parameters:
+ *  1) row - Filled with the fields of the row
+ *
+ */
+bool CastFileReader::nextRow(CastRow& row) {
+    return this->nextRow(this->position, this->size, row);
+}
+
+/*
+ * The purpose of this method is to read the next
+ * well formed row in a range of the file. It does
+ * not change the reader, so several threads can
+ * read disjoint ranges at once.
+ *
+ * Parameters:
+ *  1) position - The offset of the next line, moved
+ *                past the row that is read
+ *  2) end - The offset the range ends at
+ *  3) row - Filled with the fields of the row
+ *
+ */
+bool CastFileReader::nextRow(size_t& position, size_t end,
+                             CastRow& row) const {
+    while (position < end) {
+        const char* line = this->data + position;
+        size_t remaining = end - position;
+        const char* lineEnd = (const char*)memchr(line, '\n', remaining);
+        size_t length = lineEnd == nullptr ? remaining : lineEnd - line;
+        position += length + 1;
+        // if format is wrong, skip current line
+        if (parseRow(line, length, row)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * The purpose of this method is to split the rows
+ * after the header into byte ranges of about the
+ * same size. Every range ends at a line boundary.
+ *
+ * Parameters:
+ *  1) count - The number of ranges wanted
+ *  2) ranges - Filled with the [begin, end) offsets
+ *              of the ranges, in file order
+ *
+ */
+void CastFileReader::splitRows(unsigned int count,
+                               vector<pair<size_t, size_t>>& ranges) const {
+    ranges.clear();
+    size_t begin = this->position;
+    size_t step = (this->size - begin) / max(count, 1u) + 1;
+    while (begin < this->size) {
+        // Move the cut forward to the start of the next line
+        size_t end = min(this->size, begin + step);
+        if (end < this->size) {
+            const char* lineEnd = (const char*)memchr(
+                this->data + end, '\n', this->size - end);
+            end = lineEnd == nullptr ? this->size : lineEnd - this->data + 1;
+        }
+        ranges.push_back(make_pair(begin, end));
+        begin = end;
+    }
+}
+
+/*
+ * The purpose of this method is to parse a row
+ * the same way buildGraphFromFile always has: the
+ * line is split at tabs, a trailing tab does not
+ * start a new field, and the year is read like
+ * stoi would read it. Returns false if the row
+ * is malformed.
+ *
+ * Parameters:
+ *  1) line - The first character of the line
+ *  2) length - The length of the line without
+ *              its new line
+ *  3) row - Filled with the fields of the row
+ *
+ */
+bool CastFileReader::parseRow(const char* line, size_t length, CastRow& row) {
+    // Find the two tabs between the three fields
+    const char* end = line + length;
+    const char* firstTab = (const char*)memchr(line, '\t', length);
+    if (firstTab == nullptr) {
+        return false;
+    }
+    const char* secondTab =
+        (const char*)memchr(firstTab + 1, '\t', end - firstTab - 1);
+    if (secondTab == nullptr) {
+        return false;
+    }
+    const char* yearStart = secondTab + 1;
+    // A fourth field makes the row malformed, unless it is empty and
+    // only made by a trailing tab
+    const char* thirdTab =
+        (const char*)memchr(yearStart, '\t', end - yearStart);
+    if (thirdTab != nullptr && thirdTab + 1 != end) {
+        return false;
+    }
+    const char* yearEnd = thirdTab == nullptr ? end : thirdTab;
+    // A tab right before the end does not start a field
+    if (yearStart == yearEnd) {
+        return false;
+    }
+
+    // Read the year like stoi: spaces, a sign, then digits
+    const char* digit = yearStart;
+    while (digit < yearEnd && (*digit == ' ' || (*digit >= '\t' &&
+                                                 *digit <= '\r'))) {
+        digit++;
+    }
+    bool negative = false;
+    if (digit < yearEnd && (*digit == '-' || *digit == '+')) {
+        negative = *digit == '-';
+        digit++;
+    }
+    if (digit == yearEnd || *digit < '0' || *digit > '9') {
+        return false;
+    }
+    long long year = 0;
+    while (digit < yearEnd && *digit >= '0' && *digit <= '9') {
+        year = year * 10 + (*digit - '0');
+        if (year > (long long)INT_MAX + 1) {
+            return false;
+        }
+        digit++;
+    }
+    year = negative ? -year : year;
+    if (year > INT_MAX || year < INT_MIN) {
+        return false;
+    }
+
+    row.actor = line;
+    row.actorLength = firstTab - line;
+    row.title = firstTab + 1;
+    row.titleLength = secondTab - firstTab - 1;
+    row.year = (int)year;
+    return true;
+}
+
+/* The destructor unmaps the file */
+CastFileReader::~CastFileReader() {
+    if (this->data != nullptr && this->ownedData.empty()) {
+        munmap((void*)this->data, this->size);
+    }
+}
@@ -0,0 +1,148 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Description of File:
+ *  This file defines a reader for the tab separated
+ *  cast file. The file is memory mapped and scanned
+ *  in place, so reading a row allocates nothing: the
+ *  fields of a row point straight into the mapping.
+ */
+
+#ifndef CASTFILEREADER_HPP
+#define CASTFILEREADER_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * A CastRow is one well formed row of the cast file.
+ * The actor and title point into the mapped file and
+ * are only valid while the reader is alive.
+ */
+struct CastRow {
+    const char* actor;
+    size_t actorLength;
+    const char* title;
+    size_t titleLength;
+    int year;
+};
+
+/**
+ * The CastFileReader class maps a cast file of
+ * ActorName <tab> MovieName <tab> Year rows and hands
+ * them out one at a time. The first line is the header
+ * and is skipped. Rows that do not have exactly three
+ * fields, or whose year is not a number, are skipped.
+ *
+ * Instance variables:
+ *  1) data - The start of the mapped file
+ *
+ *  2) size - The number of bytes in the file
+ *
+ *  3) position - The offset of the next line to read
+ *
+ *  4) opened - Whether the file could be mapped
+ *
+ *  5) ownedData - The bytes of a file that cannot be
+ *                 mapped, such as a pipe
+ */
+class CastFileReader {
+  protected:
+    const char* data;
+    size_t size;
+    size_t position;
+    bool opened;
+    vector<char> ownedData;
+
+  public:
+    /*
+     * This is the contructor method for the reader.
+     * It maps the whole file and skips its header. A
+     * pipe or other file that cannot be mapped is read
+     * into memory instead.
+     *
+     * Parameters:
+     *  1) filename - The name of the cast file
+     *
+     */
+    explicit CastFileReader(const char* filename);
+
+    /* Returns the first byte of the mapped file */
+    const char* getData() const { return this->data; }
+
+    /* Returns the number of bytes in the file */
+    size_t getSize() const { return this->size; }
+
+    /* Returns false if the file could not be opened */
+    bool isOpen() const { return this->opened; }
+
+    /*
+     * The purpose of this method is to read the next
+     * well formed row of the file. Returns false once
+     * the end of the file is reached.
+     *
+     * Parameters:
+     *  1) row - Filled with the fields of the row
+     *
+     */
+    bool nextRow(CastRow& row);
+
+    /*
+     * The purpose of this method is to read the next
+     * well formed row in a range of the file. It does
+     * not change the reader, so several threads can
+     * read disjoint ranges at once.
+     *
+     * Parameters:
+     *  1) position - The offset of the next line, moved
+     *                past the row that is read
+     *  2) end - The offset the range ends at
+     *  3) row - Filled with the fields of the row
+     *
+     */
+    bool nextRow(size_t& position, size_t end, CastRow& row) const;
+
+    /*
+     * The purpose of this method is to split the rows
+     * after the header into byte ranges of about the
+     * same size. Every range ends at a line boundary.
+     *
+     * Parameters:
+     *  1) count - The number of ranges wanted
+     *  2) ranges - Filled with the [begin, end) offsets
+     *              of the ranges, in file order
+     *
+     */
+    void splitRows(unsigned int count,
+                   vector<pair<size_t, size_t>>& ranges) const;
+
+    /*
+     * The purpose of this method is to parse a row
+     * the same way buildGraphFromFile always has: the
+     * line is split at tabs, a trailing tab does not
+     * start a new field, and the year is read like
+     * stoi would read it. Returns false if the row
+     * is malformed.
+     *
+     * Parameters:
+     *  1) line - The first character of the line
+     *  2) length - The length of the line without
+     *              its new line
+     *  3) row - Filled with the fields of the row
+     *
+     */
+    static bool parseRow(const char* line, size_t length, CastRow& row);
+
+    /* The destructor unmaps the file */
+    ~CastFileReader();
+
+    CastFileReader(const CastFileReader&) = delete;
+    CastFileReader& operator=(const CastFileReader&) = delete;
+};
+
+#endif  // CASTFILEREADER_HPP
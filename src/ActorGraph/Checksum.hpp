@@ -0,0 +1,102 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Description of File:
+ *  This file defines a fast checksum of a stream of
+ *  bytes, used to check snapshots and to tell graphs
+ *  apart.
+ */
+
+#ifndef CHECKSUM_HPP
+#define CHECKSUM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+/**
+ * The Checksum class hashes a stream of bytes 8 at
+ * a time over four independent lanes, so that it
+ * runs at close to memory speed.
+ *
+ * Instance variables:
+ *  1) lanes - The hash of every fourth word
+ *
+ *  2) numWords - The number of words hashed so far
+ *
+ *  3) pending - The bytes of an unfinished word
+ *
+ *  4) numPending - The number of bytes in pending
+ */
+class Checksum {
+  protected:
+    uint64_t lanes[4];
+    uint64_t numWords;
+    char pending[8];
+    unsigned int numPending;
+
+    /* Returns a lane with one more word mixed in */
+    static uint64_t mix(uint64_t lane, uint64_t word) {
+        lane ^= word * 0x9E3779B97F4A7C15ull;
+        lane = (lane << 27) | (lane >> 37);
+        return lane * 0xC2B2AE3D27D4EB4Full + 0x165667B19E3779F9ull;
+    }
+
+    /* Mixes the next word into its lane */
+    void addWord(const char* bytes) {
+        uint64_t word;
+        memcpy(&word, bytes, sizeof(word));
+        uint64_t& lane = this->lanes[this->numWords & 3];
+        lane = mix(lane, word);
+        this->numWords++;
+    }
+
+  public:
+    Checksum() : lanes{1, 2, 3, 4}, numWords(0), numPending(0) {}
+
+    /* Hashes the next bytes of the stream */
+    void add(const char* bytes, size_t count) {
+        // Finish the word left over by the last call
+        while (this->numPending > 0 && count > 0) {
+            this->pending[this->numPending++] = *bytes++;
+            count--;
+            if (this->numPending == sizeof(uint64_t)) {
+                this->addWord(this->pending);
+                this->numPending = 0;
+            }
+        }
+        // Whole rounds of four words are the common case
+        while ((this->numWords & 3) == 0 && count >= 4 * sizeof(uint64_t)) {
+            uint64_t words[4];
+            memcpy(words, bytes, sizeof(words));
+            for (unsigned int l = 0; l < 4; l++) {
+                this->lanes[l] = mix(this->lanes[l], words[l]);
+            }
+            this->numWords += 4;
+            bytes += sizeof(words);
+            count -= sizeof(words);
+        }
+        while (count >= sizeof(uint64_t)) {
+            this->addWord(bytes);
+            bytes += sizeof(uint64_t);
+            count -= sizeof(uint64_t);
+        }
+        memcpy(this->pending + this->numPending, bytes, count);
+        this->numPending += count;
+    }
+
+    /* Returns the checksum of a stream of whole words */
+    uint64_t finish() const {
+        uint64_t hash = this->numWords;
+        for (unsigned int l = 0; l < 4; l++) {
+            hash = mix(hash, this->lanes[l]);
+        }
+        return hash;
+    }
+};
+
+#endif  // CHECKSUM_HPP
@@ -0,0 +1,120 @@
+/**
+ * The CollaboratorGraph class stores the distinct
+ * collaborators of every actor, sorted by id, and
+ * what each pair of actors did together.
+ *
+ * Instance variables:
+ *  1) offsets - Start of each actor's collaborators
+ *
+ *  2) collaborators - The collaborators of every
+ *                     actor, stored back to back
+ *
+ *  3) collaborations - The collaboration behind each
+ *                      entry of collaborators
+ */
+
+#include "CollaboratorGraph.hpp"
+#include <algorithm>
+#include <utility>
+#include "Parallel.hpp"
+
+using namespace std;
+
+// Number of actors projected by one task of the build
+static const unsigned int ACTORS_PER_TASK = 4096;
+
+/* Returns a year clamped to the range of a Collaboration year */
+static int16_t clampYear(int year) {
+    return (int16_t)max(-32768, min(32767, year));
+}
+
+/*
+ * This is the contructor method for the graph.
+ * It projects the actor/movie graph on its actors.
+ *
+ * Parameters:
+ *  1) graph - The actor/movie graph
+ *  2) numThreads - The number of threads to use
+ *
+ */
+CollaboratorGraph::CollaboratorGraph(const CSRGraph& graph,
+                                     unsigned int numThreads) {
+    // Each task projects a range of actors into its own lists
+    struct Task {
+        vector<unsigned int> degrees;
+        vector<unsigned int> collaborators;
+        vector<Collaboration> collaborations;
+    };
+    unsigned int numActors = graph.numActors();
+    vector<Task> tasks((numActors + ACTORS_PER_TASK - 1) / ACTORS_PER_TASK);
+    parallelFor(numThreads, tasks.size(), [&](size_t t) {
+        Task& task = tasks[t];
+        // Every (collaborator, year) of an actor; sorting them groups
+        // the movies of each collaborator, earliest year first
+        vector<pair<unsigned int, int>> links;
+        unsigned int last = min(numActors, (unsigned int)(t + 1) *
+                                               ACTORS_PER_TASK);
+        for (unsigned int a = t * ACTORS_PER_TASK; a < last; a++) {
+            links.clear();
+            for (auto movie = graph.moviesBegin(a);
+                 movie != graph.moviesEnd(a); movie++) {
+                int year = graph.getMovieYear(*movie);
+                for (auto actor = graph.actorsBegin(*movie);
+                     actor != graph.actorsEnd(*movie); actor++) {
+                    if (*actor != a) {
+                        links.push_back(make_pair(*actor, year));
+                    }
+                }
+            }
+            sort(links.begin(), links.end());
+            size_t before = task.collaborators.size();
+            for (size_t i = 0; i < links.size(); i++) {
+                if (i == 0 || links[i].first != links[i - 1].first) {
+                    task.collaborators.push_back(links[i].first);
+                    Collaboration collaboration = {
+                        0, clampYear(links[i].second), 0};
+                    task.collaborations.push_back(collaboration);
+                }
+                task.collaborations.back().sharedMovies++;
+                task.collaborations.back().lastYear =
+                    clampYear(links[i].second);
+            }
+            task.degrees.push_back(task.collaborators.size() - before);
+        }
+    });
+
+    // Lay the lists of the tasks out back to back
+    vector<size_t> taskStarts(tasks.size());
+    this->offsets.reserve(numActors + 1);
+    this->offsets.push_back(0);
+    for (unsigned int t = 0; t < tasks.size(); t++) {
+        taskStarts[t] = this->offsets.back();
+        for (unsigned int degree : tasks[t].degrees) {
+            this->offsets.push_back(this->offsets.back() + degree);
+        }
+    }
+    this->collaborators.resize(this->offsets.back());
+    this->collaborations.resize(this->offsets.back());
+    parallelFor(numThreads, tasks.size(), [&](size_t t) {
+        copy(tasks[t].collaborators.begin(), tasks[t].collaborators.end(),
+             this->collaborators.begin() + taskStarts[t]);
+        copy(tasks[t].collaborations.begin(), tasks[t].collaborations.end(),
+             this->collaborations.begin() + taskStarts[t]);
+        vector<unsigned int>().swap(tasks[t].collaborators);
+        vector<Collaboration>().swap(tasks[t].collaborations);
+    });
+}
+
+/*
+ * The purpose of this method is to return the
+ * number of bytes used by the graph.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+size_t CollaboratorGraph::memoryUsage() const {
+    return sizeof(size_t) * this->offsets.capacity() +
+           sizeof(unsigned int) * this->collaborators.capacity() +
+           sizeof(Collaboration) * this->collaborations.capacity();
+}
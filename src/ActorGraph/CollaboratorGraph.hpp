@@ -0,0 +1,109 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Description of File:
+ *  This file defines the collaborator graph: the
+ *  actor to actor projection of the actor/movie
+ *  graph, where two actors are linked once if they
+ *  were in at least one movie together. Each link
+ *  knows how many movies the two actors shared and
+ *  the years of the first and the last one.
+ */
+
+#ifndef COLLABORATORGRAPH_HPP
+#define COLLABORATORGRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CSRGraph.hpp"
+
+using namespace std;
+
+/* What two linked actors did together */
+struct Collaboration {
+    // Number of movies the two actors were both in
+    uint32_t sharedMovies;
+    // Years of their first and last shared movie, clamped to 16 bits
+    int16_t firstYear;
+    int16_t lastYear;
+};
+
+/**
+ * The CollaboratorGraph class stores the distinct
+ * collaborators of every actor in CSR form, sorted by
+ * id, so that two actors' collaborators can be
+ * intersected with intersectSorted. Searches can use
+ * it to go from actor to actor without the movies.
+ *
+ * Instance variables:
+ *  1) offsets - collaborators[offsets[a] ..
+ *               offsets[a + 1]) are the
+ *               collaborators of actor a
+ *
+ *  2) collaborators - The collaborators of every
+ *                     actor, stored back to back
+ *
+ *  3) collaborations - The collaboration behind each
+ *                      entry of collaborators
+ */
+class CollaboratorGraph {
+  protected:
+    vector<size_t> offsets;
+    vector<unsigned int> collaborators;
+    vector<Collaboration> collaborations;
+
+  public:
+    /*
+     * This is the contructor method for the graph.
+     * It projects the actor/movie graph on its actors.
+     *
+     * Parameters:
+     *  1) graph - The actor/movie graph
+     *  2) numThreads - The number of threads to use
+     *
+     */
+    CollaboratorGraph(const CSRGraph& graph, unsigned int numThreads = 1);
+
+    /* Returns the number of actors in the graph */
+    unsigned int numActors() const {
+        return (unsigned int)this->offsets.size() - 1;
+    }
+
+    /* Returns the number of links, counting each direction once */
+    size_t numLinks() const { return this->collaborators.size(); }
+
+    /* Returns the number of collaborators of an actor */
+    unsigned int degree(unsigned int actorId) const {
+        return this->offsets[actorId + 1] - this->offsets[actorId];
+    }
+
+    /* Returns a pointer to the first collaborator of an actor */
+    const unsigned int* begin(unsigned int actorId) const {
+        return this->collaborators.data() + this->offsets[actorId];
+    }
+
+    /* Returns a pointer one past the last collaborator of an actor */
+    const unsigned int* end(unsigned int actorId) const {
+        return this->collaborators.data() + this->offsets[actorId + 1];
+    }
+
+    /* Returns the collaboration with the first collaborator of an actor */
+    const Collaboration* collaborationsBegin(unsigned int actorId) const {
+        return this->collaborations.data() + this->offsets[actorId];
+    }
+
+    /*
+     * The purpose of this method is to return the
+     * number of bytes used by the graph.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    size_t memoryUsage() const;
+};
+
+#endif  // COLLABORATORGRAPH_HPP
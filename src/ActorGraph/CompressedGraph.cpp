@@ -0,0 +1,298 @@
+/**
+ * The CompressedGraph class keeps the same two lists
+ * as CSRGraph in Stream VByte form: a varint length,
+ * a control byte for every four ids, and the bytes
+ * of the gaps between the ids.
+ *
+ * Instance variables:
+ *  1) actorCount - The number of actors
+ *
+ *  2) movieCount - The number of movies
+ *
+ *  3) edgeCount - The number of actor-movie edges
+ *
+ *  4) actorLists - The movies of every actor
+ *
+ *  5) actorIndex - The start of every INDEX_STEP-th
+ *                  actor's list
+ *
+ *  6) movieLists - The actors of every movie
+ *
+ *  7) movieIndex - The start of every INDEX_STEP-th
+ *                  movie's list
+ *
+ *  8) movieYears - The release year of every movie
+ *
+ *  9) latestYear - The year of the newest movie
+ *
+ *  10) maxMovies - The most movies of any actor
+ *
+ *  11) maxCast - The most actors of any movie
+ */
+
+#include "CompressedGraph.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define HAVE_X86_SIMD 1
+#endif
+
+using namespace std;
+
+const unsigned int CompressedGraph::INDEX_STEP;
+
+// Bytes after the last list, so a group can always be loaded whole
+static const size_t PADDING = 16;
+
+/**
+ * The StreamVByteTables struct holds what is known
+ * about each of the 256 control bytes.
+ *
+ * Instance variables:
+ *  1) lengths - The number of bytes of the four gaps
+ *
+ *  2) shuffles - Moves the bytes of the four gaps
+ *                into four 32 bit lanes, zeroing the
+ *                bytes the gaps do not have
+ */
+struct StreamVByteTables {
+    uint8_t lengths[256];
+    uint8_t shuffles[256][16];
+
+    StreamVByteTables() {
+        for (unsigned int control = 0; control < 256; control++) {
+            unsigned int offset = 0;
+            for (unsigned int lane = 0; lane < 4; lane++) {
+                unsigned int length = ((control >> (2 * lane)) & 3) + 1;
+                for (unsigned int byte = 0; byte < 4; byte++) {
+                    this->shuffles[control][4 * lane + byte] =
+                        byte < length ? offset + byte : 0x80;
+                }
+                offset += length;
+            }
+            this->lengths[control] = offset;
+        }
+    }
+};
+
+static const StreamVByteTables TABLES;
+
+/* Returns the number of bytes a gap needs, minus one */
+static inline unsigned int codeOf(unsigned int gap) {
+    return (gap > 0xFF) + (gap > 0xFFFF) + (gap > 0xFFFFFF);
+}
+
+/*
+ * This function appends a list of ids to the lists,
+ * sorting it first.
+ *
+ * Parameters:
+ *  1) begin - The first id of the list
+ *  2) end - One past the last id of the list
+ *  3) sorted - Scratch space for the sorted ids
+ *  4) lists - The lists to append to
+ *
+ */
+static void encodeList(const unsigned int* begin, const unsigned int* end,
+                       vector<unsigned int>& sorted, vector<uint8_t>& lists) {
+    sorted.assign(begin, end);
+    sort(sorted.begin(), sorted.end());
+    // The length, seven bits at a time
+    size_t count = sorted.size();
+    while (count >= 0x80) {
+        lists.push_back((uint8_t)(count | 0x80));
+        count >>= 7;
+    }
+    lists.push_back((uint8_t)count);
+    // The control bytes, then the gaps
+    size_t controls = lists.size();
+    lists.resize(controls + (sorted.size() + 3) / 4, 0);
+    unsigned int previous = 0;
+    for (size_t i = 0; i < sorted.size(); i++) {
+        unsigned int gap = sorted[i] - previous;
+        unsigned int code = codeOf(gap);
+        lists[controls + i / 4] |= code << (2 * (i % 4));
+        for (unsigned int byte = 0; byte <= code; byte++) {
+            lists.push_back((uint8_t)(gap >> (8 * byte)));
+        }
+        previous = sorted[i];
+    }
+}
+
+/* Reads the varint length of a list, moving past it */
+static inline unsigned int readLength(const uint8_t*& list) {
+    unsigned int count = 0;
+    for (unsigned int shift = 0;; shift += 7) {
+        uint8_t byte = *list++;
+        count |= (unsigned int)(byte & 0x7F) << shift;
+        if (byte < 0x80) {
+            return count;
+        }
+    }
+}
+
+/* Returns the bytes of the gaps of the last, partial group */
+static inline unsigned int tailLength(uint8_t control, unsigned int count) {
+    unsigned int length = 0;
+    for (unsigned int lane = 0; lane < count; lane++) {
+        length += ((control >> (2 * lane)) & 3) + 1;
+    }
+    return length;
+}
+
+#ifdef HAVE_X86_SIMD
+/*
+ * This function decodes whole groups of four gaps
+ * with SSSE3, adding up the gaps into ids. Returns
+ * the first byte after the gaps of the groups.
+ *
+ * Parameters:
+ *  1) controls - The control byte of each group
+ *  2) data - The bytes of the gaps
+ *  3) numGroups - The number of groups to decode
+ *  4) ids - Filled with four ids per group
+ *
+ */
+__attribute__((target("ssse3"))) static const uint8_t* decodeGroupsSSSE3(
+    const uint8_t* controls, const uint8_t* data, size_t numGroups,
+    unsigned int* ids) {
+    __m128i previous = _mm_setzero_si128();
+    for (size_t group = 0; group < numGroups; group++) {
+        uint8_t control = controls[group];
+        __m128i gaps = _mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i*)data),
+            _mm_loadu_si128((const __m128i*)TABLES.shuffles[control]));
+        data += TABLES.lengths[control];
+        // Prefix sum of the four lanes, then add the last id so far
+        gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 4));
+        gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 8));
+        gaps = _mm_add_epi32(gaps, previous);
+        _mm_storeu_si128((__m128i*)(ids + 4 * group), gaps);
+        previous = _mm_shuffle_epi32(gaps, 0xFF);
+    }
+    return data;
+}
+#endif
+
+/*
+ * This is the contructor method for the compressed
+ * graph. It encodes the lists of a CSR graph.
+ *
+ * Parameters:
+ *  1) graph - The graph to compress
+ *
+ */
+CompressedGraph::CompressedGraph(const CSRGraph& graph)
+    : movieYears(graph.getMovieYears(),
+                 graph.getMovieYears() + graph.numMovies()) {
+    this->actorCount = graph.numActors();
+    this->movieCount = graph.numMovies();
+    this->edgeCount = graph.numEdges();
+    this->latestYear = graph.getLatestYear();
+    this->maxMovies = 0;
+    this->maxCast = 0;
+    vector<unsigned int> sorted;
+
+    for (unsigned int a = 0; a < this->actorCount; a++) {
+        if (a % INDEX_STEP == 0) {
+            this->actorIndex.push_back(this->actorLists.size());
+        }
+        encodeList(graph.moviesBegin(a), graph.moviesEnd(a), sorted,
+                   this->actorLists);
+        this->maxMovies = max(this->maxMovies, (unsigned int)sorted.size());
+    }
+    this->actorLists.resize(this->actorLists.size() + PADDING, 0);
+    this->actorLists.shrink_to_fit();
+
+    for (unsigned int m = 0; m < this->movieCount; m++) {
+        if (m % INDEX_STEP == 0) {
+            this->movieIndex.push_back(this->movieLists.size());
+        }
+        encodeList(graph.actorsBegin(m), graph.actorsEnd(m), sorted,
+                   this->movieLists);
+        this->maxCast = max(this->maxCast, (unsigned int)sorted.size());
+    }
+    this->movieLists.resize(this->movieLists.size() + PADDING, 0);
+    this->movieLists.shrink_to_fit();
+}
+
+/*
+ * The purpose of this method is to return the
+ * start of the list of a node.
+ *
+ * Parameters:
+ *  1) lists - The lists of the nodes
+ *  2) index - The start of every INDEX_STEP-th list
+ *  3) id - The node whose list is wanted
+ *
+ */
+const uint8_t* CompressedGraph::findList(const vector<uint8_t>& lists,
+                                         const vector<uint64_t>& index,
+                                         unsigned int id) {
+    const uint8_t* list = lists.data() + index[id / INDEX_STEP];
+    // Skip the lists before it, using only their control bytes
+    for (unsigned int skip = id % INDEX_STEP; skip > 0; skip--) {
+        unsigned int count = readLength(list);
+        const uint8_t* controls = list;
+        list += (count + 3) / 4;
+        for (unsigned int group = 0; group < count / 4; group++) {
+            list += TABLES.lengths[controls[group]];
+        }
+        if (count % 4 != 0) {
+            list += tailLength(controls[count / 4], count % 4);
+        }
+    }
+    return list;
+}
+
+/*
+ * The purpose of this method is to decode a list
+ * into ids. Returns the number of ids.
+ *
+ * Parameters:
+ *  1) list - The start of the list
+ *  2) ids - Filled with the ids, ascending
+ *
+ */
+unsigned int CompressedGraph::decode(const uint8_t* list, unsigned int* ids) {
+    unsigned int count = readLength(list);
+    const uint8_t* controls = list;
+    const uint8_t* data = list + (count + 3) / 4;
+    unsigned int i = 0;
+    unsigned int previous = 0;
+#ifdef HAVE_X86_SIMD
+    static const bool hasSSSE3 = __builtin_cpu_supports("ssse3");
+    if (hasSSSE3 && count >= 4) {
+        data = decodeGroupsSSSE3(controls, data, count / 4, ids);
+        i = count / 4 * 4;
+        previous = ids[i - 1];
+    }
+#endif
+    for (; i < count; i++) {
+        unsigned int code = (controls[i / 4] >> (2 * (i % 4))) & 3;
+        unsigned int gap = 0;
+        for (unsigned int byte = 0; byte <= code; byte++) {
+            gap |= (unsigned int)data[byte] << (8 * byte);
+        }
+        data += code + 1;
+        previous += gap;
+        ids[i] = previous;
+    }
+    return count;
+}
+
+/*
+ * The purpose of this method is to return the
+ * number of bytes used by the compressed graph.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+size_t CompressedGraph::memoryUsage() const {
+    return this->actorLists.capacity() + this->movieLists.capacity() +
+           sizeof(uint64_t) *
+               (this->actorIndex.capacity() + this->movieIndex.capacity()) +
+           sizeof(int) * this->movieYears.capacity();
+}
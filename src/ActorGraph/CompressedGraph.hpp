@@ -0,0 +1,194 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Sources used:
+ *  1) Lemire, Kurz and Rupp, "Stream VByte: Faster
+ *     Byte-Oriented Integer Compression", Information
+ *     Processing Letters 2018
+ *
+ * Description of File:
+ *  This file defines a compressed, read only copy of
+ *  the actor/movie graph for graphs too large to keep
+ *  as plain id arrays. Each list of neighbours is
+ *  sorted and stored as the gaps between its ids, in
+ *  as few bytes as each gap needs. On x86-64 the
+ *  lists are decoded four ids at a time with SSSE3
+ *  when the CPU has it.
+ */
+
+#ifndef COMPRESSEDGRAPH_HPP
+#define COMPRESSEDGRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CSRGraph.hpp"
+
+using namespace std;
+
+/**
+ * The CompressedGraph class keeps the same two lists
+ * as CSRGraph, actor -> movies and movie -> actors,
+ * in Stream VByte form. A list starts with its length
+ * as a varint, followed by one control byte for every
+ * four ids, which holds the number of bytes of each
+ * gap, and then the bytes of the gaps. The first gap
+ * of a list is its first id.
+ *
+ * Only the start of every INDEX_STEP-th list is kept,
+ * and the lists in between are found by skipping the
+ * ones before them, which the control bytes allow
+ * without decoding any id.
+ *
+ * Instance variables:
+ *  1) actorCount - The number of actors
+ *
+ *  2) movieCount - The number of movies
+ *
+ *  3) edgeCount - The number of actor-movie edges
+ *
+ *  4) actorLists - The movies of every actor, back
+ *                  to back, and then some padding
+ *
+ *  5) actorIndex - The start in actorLists of every
+ *                  INDEX_STEP-th actor's list
+ *
+ *  6) movieLists - The actors of every movie, back
+ *                  to back, and then some padding
+ *
+ *  7) movieIndex - The start in movieLists of every
+ *                  INDEX_STEP-th movie's list
+ *
+ *  8) movieYears - The release year of every movie
+ *
+ *  9) latestYear - The year of the newest movie
+ *
+ *  10) maxMovies - The most movies of any actor
+ *
+ *  11) maxCast - The most actors of any movie
+ */
+class CompressedGraph {
+  protected:
+    unsigned int actorCount;
+    unsigned int movieCount;
+    size_t edgeCount;
+    vector<uint8_t> actorLists;
+    vector<uint64_t> actorIndex;
+    vector<uint8_t> movieLists;
+    vector<uint64_t> movieIndex;
+    vector<int> movieYears;
+    int latestYear;
+    unsigned int maxMovies;
+    unsigned int maxCast;
+
+    /*
+     * The purpose of this method is to return the
+     * start of the list of a node.
+     *
+     * Parameters:
+     *  1) lists - The lists of the nodes
+     *  2) index - The start of every INDEX_STEP-th list
+     *  3) id - The node whose list is wanted
+     *
+     */
+    static const uint8_t* findList(const vector<uint8_t>& lists,
+                                   const vector<uint64_t>& index,
+                                   unsigned int id);
+
+    /*
+     * The purpose of this method is to decode a list
+     * into ids. Returns the number of ids.
+     *
+     * Parameters:
+     *  1) list - The start of the list
+     *  2) ids - Filled with the ids, ascending
+     *
+     */
+    static unsigned int decode(const uint8_t* list, unsigned int* ids);
+
+  public:
+    // Number of lists per kept start
+    static const unsigned int INDEX_STEP = 4;
+
+    /*
+     * This is the contructor method for the compressed
+     * graph. It encodes the lists of a CSR graph, which
+     * can be deleted afterwards.
+     *
+     * Parameters:
+     *  1) graph - The graph to compress
+     *
+     */
+    explicit CompressedGraph(const CSRGraph& graph);
+
+    /* Returns the number of actors in the graph */
+    unsigned int numActors() const { return this->actorCount; }
+
+    /* Returns the number of movies in the graph */
+    unsigned int numMovies() const { return this->movieCount; }
+
+    /* Returns the number of actor-movie edges in the graph */
+    size_t numEdges() const { return this->edgeCount; }
+
+    /* Returns the most movies of any actor */
+    unsigned int getMaxMovies() const { return this->maxMovies; }
+
+    /* Returns the most actors of any movie */
+    unsigned int getMaxCast() const { return this->maxCast; }
+
+    /*
+     * The purpose of this method is to decode the
+     * movies of an actor, sorted by id. Returns the
+     * number of movies.
+     *
+     * Parameters:
+     *  1) actorId - The actor whose movies are wanted
+     *  2) movieIds - Filled with the movies; must have
+     *                room for getMaxMovies() ids
+     *
+     */
+    unsigned int getMovies(unsigned int actorId,
+                           unsigned int* movieIds) const {
+        return decode(findList(this->actorLists, this->actorIndex, actorId),
+                      movieIds);
+    }
+
+    /*
+     * The purpose of this method is to decode the
+     * actors of a movie, sorted by id. Returns the
+     * number of actors.
+     *
+     * Parameters:
+     *  1) movieId - The movie whose actors are wanted
+     *  2) actorIds - Filled with the actors; must have
+     *                room for getMaxCast() ids
+     *
+     */
+    unsigned int getActors(unsigned int movieId,
+                           unsigned int* actorIds) const {
+        return decode(findList(this->movieLists, this->movieIndex, movieId),
+                      actorIds);
+    }
+
+    /* Returns the release year of a movie */
+    int getMovieYear(unsigned int movieId) const {
+        return this->movieYears[movieId];
+    }
+
+    /* Returns the year of the newest movie, 0 if there are none */
+    int getLatestYear() const { return this->latestYear; }
+
+    /*
+     * The purpose of this method is to return the
+     * number of bytes used by the compressed graph.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    size_t memoryUsage() const;
+};
+
+#endif  // COMPRESSEDGRAPH_HPP
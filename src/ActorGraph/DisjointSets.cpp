@@ -0,0 +1,78 @@
+/**
+ * The DisjointSets class keeps a forest where each
+ * tree is one set and its root names the set.
+ *
+ * Instance variables:
+ *  1) parents - The parent of each element
+ *
+ *  2) ranks - An upper bound on the height of the
+ *             tree of each root
+ */
+
+#include "DisjointSets.hpp"
+
+using namespace std;
+
+/*
+ * This is the contructor method for the forest.
+ * Every element starts in a set of its own.
+ *
+ * Parameters:
+ *  1) size - The number of elements
+ *
+ */
+DisjointSets::DisjointSets(unsigned int size)
+    : parents(size), ranks(size, 0) {
+    for (unsigned int i = 0; i < size; i++) {
+        this->parents[i] = i;
+    }
+}
+
+/*
+ * The purpose of this method is to return the
+ * root of the set of an element. Every element on
+ * the way is pointed straight at the root.
+ *
+ * Parameters:
+ *  1) element - The element to look up
+ *
+ */
+unsigned int DisjointSets::find(unsigned int element) {
+    unsigned int root = element;
+    while (this->parents[root] != root) {
+        root = this->parents[root];
+    }
+    // Second pass: compress the path to the root
+    while (this->parents[element] != root) {
+        unsigned int next = this->parents[element];
+        this->parents[element] = root;
+        element = next;
+    }
+    return root;
+}
+
+/*
+ * The purpose of this method is to merge the sets
+ * of two roots, and return the root of the merged
+ * set.
+ *
+ * Parameters:
+ *  1) rootA - The root of the first set
+ *  2) rootB - The root of the second set
+ *
+ */
+unsigned int DisjointSets::unite(unsigned int rootA, unsigned int rootB) {
+    if (rootA == rootB) {
+        return rootA;
+    }
+    // The lower tree goes under the higher one
+    if (this->ranks[rootA] < this->ranks[rootB]) {
+        this->parents[rootA] = rootB;
+        return rootB;
+    }
+    this->parents[rootB] = rootA;
+    if (this->ranks[rootA] == this->ranks[rootB]) {
+        this->ranks[rootA]++;
+    }
+    return rootA;
+}
@@ -0,0 +1,79 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Sources used:
+ *  1) Stepik: Introduction to Data Structures (Fall 2016)
+ *     by Moshiri and Izhikevich (available at stepik.org)
+ *     Section: 3.6 - Disjoint Sets
+ *
+ * Description of File:
+ *  This file defines a disjoint-set forest over dense
+ *  ids, used to follow how the actors become connected
+ *  as the movies are added one by one.
+ */
+
+#ifndef DISJOINTSETS_HPP
+#define DISJOINTSETS_HPP
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ * The DisjointSets class keeps a forest where each
+ * tree is one set and its root names the set. Finds
+ * compress the path they walk, and unions hang the
+ * tree of lower rank under the other, so every
+ * operation takes nearly constant amortized time.
+ *
+ * Instance variables:
+ *  1) parents - The parent of each element, itself
+ *               for a root
+ *
+ *  2) ranks - An upper bound on the height of the
+ *             tree of each root
+ */
+class DisjointSets {
+  protected:
+    vector<unsigned int> parents;
+    vector<uint8_t> ranks;
+
+  public:
+    /*
+     * This is the contructor method for the forest.
+     * Every element starts in a set of its own.
+     *
+     * Parameters:
+     *  1) size - The number of elements
+     *
+     */
+    DisjointSets(unsigned int size);
+
+    /*
+     * The purpose of this method is to return the
+     * root of the set of an element. Every element on
+     * the way is pointed straight at the root.
+     *
+     * Parameters:
+     *  1) element - The element to look up
+     *
+     */
+    unsigned int find(unsigned int element);
+
+    /*
+     * The purpose of this method is to merge the sets
+     * of two roots, and return the root of the merged
+     * set.
+     *
+     * Parameters:
+     *  1) rootA - The root of the first set
+     *  2) rootB - The root of the second set
+     *
+     */
+    unsigned int unite(unsigned int rootA, unsigned int rootB);
+};
+
+#endif  // DISJOINTSETS_HPP
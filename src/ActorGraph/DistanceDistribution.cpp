@@ -0,0 +1,425 @@
+/**
+ * The DistanceDistribution class estimates the
+ * neighbourhood function N(t) with a HyperLogLog
+ * counter per actor and per movie, merged one movie
+ * further every iteration.
+ *
+ * Instance variables:
+ *  1) log2Registers - The log2 of the number of
+ *                     registers of each counter
+ *
+ *  2) seed - Picks the hash of the actor ids
+ *
+ *  3) actorRegisters - The registers of the counter
+ *                      of every actor
+ *
+ *  4) movieRegisters - The registers of the counter
+ *                      of every movie
+ *
+ *  5) neighbourhood - The estimate of N(t)
+ *
+ *  6) numActors - The number of actors of the graph
+ */
+
+#include "DistanceDistribution.hpp"
+#include <algorithm>
+#include <cmath>
+#include "Parallel.hpp"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define HAVE_X86_SIMD 1
+#endif
+
+using namespace std;
+
+const unsigned int DistanceDistribution::MIN_LOG2_REGISTERS;
+const unsigned int DistanceDistribution::MAX_LOG2_REGISTERS;
+const unsigned int DistanceDistribution::DEFAULT_LOG2_REGISTERS;
+const unsigned int DistanceDistribution::EFFECTIVE_PERCENT;
+
+// Number of actors or movies each thread takes at a time
+static const size_t NODES_PER_TASK = 1024;
+
+/*
+ * This function mixes the bits of an actor id, so
+ * that every bit of the result is as likely to be
+ * set as not.
+ *
+ * Parameters:
+ *  1) id - The id to hash
+ *  2) seed - Picks one hash among many
+ *
+ */
+static inline uint64_t hashId(unsigned int id, uint64_t seed) {
+    uint64_t hash = id + (seed + 1) * 0x9E3779B97F4A7C15ull;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+    return hash ^ (hash >> 31);
+}
+
+#ifndef HAVE_X86_SIMD
+/*
+ * This function merges one counter into another,
+ * one register at a time. Returns true if any
+ * register of into grew.
+ *
+ * Parameters:
+ *  1) into - The registers to merge into
+ *  2) from - The registers to merge
+ *  3) numRegisters - The number of registers
+ *
+ */
+static bool mergeScalar(uint8_t* into, const uint8_t* from,
+                        size_t numRegisters) {
+    bool changed = false;
+    for (size_t r = 0; r < numRegisters; r++) {
+        if (from[r] > into[r]) {
+            into[r] = from[r];
+            changed = true;
+        }
+    }
+    return changed;
+}
+#else
+/*
+ * This function merges 16 registers at a time with
+ * SSE2, which every x86-64 CPU has.
+ *
+ * Parameters:
+ *  Same as mergeScalar, with a multiple of 16
+ *  registers
+ *
+ */
+static bool mergeSSE2(uint8_t* into, const uint8_t* from,
+                      size_t numRegisters) {
+    __m128i grown = _mm_setzero_si128();
+    for (size_t r = 0; r < numRegisters; r += 16) {
+        __m128i old = _mm_loadu_si128((const __m128i*)(into + r));
+        __m128i merged =
+            _mm_max_epu8(old, _mm_loadu_si128((const __m128i*)(from + r)));
+        grown = _mm_or_si128(grown, _mm_xor_si128(merged, old));
+        _mm_storeu_si128((__m128i*)(into + r), merged);
+    }
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(grown, _mm_setzero_si128())) !=
+           0xFFFF;
+}
+
+/*
+ * This function merges 32 registers at a time with
+ * AVX2. It is only called when the CPU has AVX2.
+ *
+ * Parameters:
+ *  Same as mergeScalar, with a multiple of 32
+ *  registers
+ *
+ */
+__attribute__((target("avx2"))) static bool mergeAVX2(uint8_t* into,
+                                                      const uint8_t* from,
+                                                      size_t numRegisters) {
+    __m256i grown = _mm256_setzero_si256();
+    for (size_t r = 0; r < numRegisters; r += 32) {
+        __m256i old = _mm256_loadu_si256((const __m256i*)(into + r));
+        __m256i merged = _mm256_max_epu8(
+            old, _mm256_loadu_si256((const __m256i*)(from + r)));
+        grown = _mm256_or_si256(grown, _mm256_xor_si256(merged, old));
+        _mm256_storeu_si256((__m256i*)(into + r), merged);
+    }
+    return !_mm256_testz_si256(grown, grown);
+}
+#endif
+
+/*
+ * This function merges one counter into another,
+ * taking the max of each register. Returns true if
+ * any register of into grew.
+ *
+ * Parameters:
+ *  1) into - The registers to merge into
+ *  2) from - The registers to merge
+ *  3) numRegisters - The number of registers, a
+ *                    power of two of at least 16
+ *
+ */
+static inline bool mergeRegisters(uint8_t* into, const uint8_t* from,
+                                  size_t numRegisters) {
+#ifdef HAVE_X86_SIMD
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    if (hasAVX2 && numRegisters >= 32) {
+        return mergeAVX2(into, from, numRegisters);
+    }
+    return mergeSSE2(into, from, numRegisters);
+#else
+    return mergeScalar(into, from, numRegisters);
+#endif
+}
+
+/*
+ * This is the contructor method for the
+ * distribution. It is empty until the first run.
+ *
+ * Parameters:
+ *  1) log2Registers - The log2 of the number of
+ *                     registers of each counter,
+ *                     from MIN_LOG2_REGISTERS to
+ *                     MAX_LOG2_REGISTERS
+ *  2) seed - Picks the hash of the actor ids, so
+ *            runs with different seeds are
+ *            independent estimates
+ *
+ */
+DistanceDistribution::DistanceDistribution(unsigned int log2Registers,
+                                           uint64_t seed) {
+    this->log2Registers = min(MAX_LOG2_REGISTERS,
+                              max(MIN_LOG2_REGISTERS, log2Registers));
+    this->seed = seed;
+    this->numActors = 0;
+}
+
+/*
+ * The purpose of this method is to return the
+ * estimate of the number of actors a counter holds.
+ * Small counts, which leave some registers empty,
+ * are estimated from the number of empty registers.
+ *
+ * Parameters:
+ *  1) registers - The registers of the counter
+ *
+ */
+double DistanceDistribution::estimate(const uint8_t* registers) const {
+    unsigned int numRegisters = this->getNumRegisters();
+    double sum = 0;
+    unsigned int numEmpty = 0;
+    for (unsigned int r = 0; r < numRegisters; r++) {
+        sum += ldexp(1.0, -(int)registers[r]);
+        numEmpty += registers[r] == 0;
+    }
+    double alpha = numRegisters == 16   ? 0.673
+                   : numRegisters == 32 ? 0.697
+                   : numRegisters == 64 ? 0.709
+                                        : 0.7213 / (1 + 1.079 / numRegisters);
+    double count = alpha * numRegisters * numRegisters / sum;
+    if (count <= 2.5 * numRegisters && numEmpty > 0) {
+        count = numRegisters * log((double)numRegisters / numEmpty);
+    }
+    return count;
+}
+
+/*
+ * This method estimates the neighbourhood function
+ * of a graph, iterating until no counter changes.
+ *
+ * Parameters:
+ *  1) graph - The graph to estimate
+ *  2) numThreads - The number of threads to use
+ *
+ */
+void DistanceDistribution::run(const CSRGraph& graph,
+                               unsigned int numThreads) {
+    size_t numRegisters = this->getNumRegisters();
+    this->numActors = graph.numActors();
+    unsigned int numMovies = graph.numMovies();
+    this->actorRegisters.assign(this->numActors * numRegisters, 0);
+    this->movieRegisters.assign(numMovies * numRegisters, 0);
+    this->neighbourhood.clear();
+    if (this->numActors == 0) {
+        return;
+    }
+
+    // Each actor's counter starts with the actor alone
+    unsigned int shift = 64 - this->log2Registers;
+    for (unsigned int a = 0; a < this->numActors; a++) {
+        uint64_t hash = hashId(a, this->seed);
+        uint64_t rest = hash << this->log2Registers;
+        unsigned int rank = rest == 0 ? shift + 1 : __builtin_clzll(rest) + 1;
+        this->actorRegisters[a * numRegisters + (hash >> shift)] = rank;
+    }
+    vector<double> estimates(this->numActors);
+    double total = 0;
+    for (unsigned int a = 0; a < this->numActors; a++) {
+        estimates[a] = this->estimate(&this->actorRegisters[a * numRegisters]);
+        total += estimates[a];
+    }
+    this->neighbourhood.push_back(total);
+
+    // Flags of the counters that grew in the last iteration
+    vector<uint8_t> actorGrew(this->numActors, 1);
+    vector<uint8_t> movieGrew(numMovies, 0);
+    size_t numActorTasks =
+        (this->numActors + NODES_PER_TASK - 1) / NODES_PER_TASK;
+    size_t numMovieTasks = (numMovies + NODES_PER_TASK - 1) / NODES_PER_TASK;
+    vector<uint8_t> taskGrew(numActorTasks);
+    while (true) {
+        // Each movie takes in the counters of its cast that grew
+        parallelFor(numThreads, numMovieTasks, [&](size_t task) {
+            unsigned int last =
+                min((size_t)numMovies, (task + 1) * NODES_PER_TASK);
+            for (unsigned int m = task * NODES_PER_TASK; m < last; m++) {
+                uint8_t* into = &this->movieRegisters[m * numRegisters];
+                bool grew = false;
+                for (auto actor = graph.actorsBegin(m);
+                     actor != graph.actorsEnd(m); actor++) {
+                    if (actorGrew[*actor]) {
+                        grew |= mergeRegisters(
+                            into, &this->actorRegisters[*actor * numRegisters],
+                            numRegisters);
+                    }
+                }
+                movieGrew[m] = grew;
+            }
+        });
+
+        // Then each actor takes in the counters of its movies that grew
+        parallelFor(numThreads, numActorTasks, [&](size_t task) {
+            unsigned int last =
+                min((size_t)this->numActors, (task + 1) * NODES_PER_TASK);
+            bool anyGrew = false;
+            for (unsigned int a = task * NODES_PER_TASK; a < last; a++) {
+                uint8_t* into = &this->actorRegisters[a * numRegisters];
+                bool grew = false;
+                for (auto movie = graph.moviesBegin(a);
+                     movie != graph.moviesEnd(a); movie++) {
+                    if (movieGrew[*movie]) {
+                        grew |= mergeRegisters(
+                            into, &this->movieRegisters[*movie * numRegisters],
+                            numRegisters);
+                    }
+                }
+                actorGrew[a] = grew;
+                if (grew) {
+                    estimates[a] = this->estimate(into);
+                    anyGrew = true;
+                }
+            }
+            taskGrew[task] = anyGrew;
+        });
+        if (find(taskGrew.begin(), taskGrew.end(), 1) == taskGrew.end()) {
+            break;
+        }
+
+        // The sum is taken in actor order so any thread count gives it.
+        // An estimate can dip where it switches to counting the empty
+        // registers, but N(t) never shrinks
+        total = 0;
+        for (unsigned int a = 0; a < this->numActors; a++) {
+            total += estimates[a];
+        }
+        this->neighbourhood.push_back(max(total, this->neighbourhood.back()));
+    }
+}
+
+/*
+ * The purpose of this method is to return the
+ * relative standard error of each estimate of N(t).
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+double DistanceDistribution::getRelativeError() const {
+    return 1.04 / sqrt((double)this->getNumRegisters());
+}
+
+/*
+ * The purpose of this method is to return the
+ * lower bound of N(t), two standard errors below
+ * the estimate, but never below the actors alone.
+ *
+ * Parameters:
+ *  1) t - The number of movies
+ *
+ */
+double DistanceDistribution::getLower(unsigned int t) const {
+    return max((double)this->numActors,
+               this->neighbourhood[t] * (1 - 2 * this->getRelativeError()));
+}
+
+/*
+ * The purpose of this method is to return the
+ * upper bound of N(t), two standard errors above
+ * the estimate, but never above every pair.
+ *
+ * Parameters:
+ *  1) t - The number of movies
+ *
+ */
+double DistanceDistribution::getUpper(unsigned int t) const {
+    return min((double)this->numActors * this->numActors,
+               this->neighbourhood[t] * (1 + 2 * this->getRelativeError()));
+}
+
+/*
+ * The purpose of this method is to return the
+ * estimated number of ordered pairs of distinct
+ * actors that are connected.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+double DistanceDistribution::getConnectedPairs() const {
+    if (this->neighbourhood.empty()) {
+        return 0;
+    }
+    return this->neighbourhood.back() - this->neighbourhood[0];
+}
+
+/*
+ * The purpose of this method is to return the
+ * estimated average number of movies between two
+ * distinct connected actors.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+double DistanceDistribution::getAverageDistance() const {
+    double connected = this->getConnectedPairs();
+    if (connected <= 0) {
+        return 0;
+    }
+    double sum = 0;
+    for (unsigned int t = 1; t < this->neighbourhood.size(); t++) {
+        sum += t * this->getPairs(t);
+    }
+    return sum / connected;
+}
+
+/*
+ * The purpose of this method is to return the
+ * smallest distance, interpolated between whole
+ * movies, within which a percent of the connected
+ * pairs of distinct actors are.
+ *
+ * Parameters:
+ *  1) percent - The percent of the pairs
+ *
+ */
+double DistanceDistribution::getEffectiveDiameter(unsigned int percent) const {
+    double connected = this->getConnectedPairs();
+    if (connected <= 0) {
+        return 0;
+    }
+    double wanted = connected * percent / 100;
+    double within = 0;
+    for (unsigned int t = 1; t < this->neighbourhood.size(); t++) {
+        double pairs = this->getPairs(t);
+        if (within + pairs >= wanted) {
+            return t - 1 + (wanted - within) / pairs;
+        }
+        within += pairs;
+    }
+    return this->getMaxDistance();
+}
+
+/*
+ * The purpose of this method is to return the
+ * number of bytes used by the counters.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+size_t DistanceDistribution::memoryUsage() const {
+    return this->actorRegisters.capacity() + this->movieRegisters.capacity();
+}
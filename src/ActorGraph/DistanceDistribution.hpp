@@ -0,0 +1,198 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Sources used:
+ *  1) Boldi, Rosa and Vigna, "HyperANF: Approximating
+ *     the Neighbourhood Function of Very Large Graphs
+ *     on a Budget", WWW 2011
+ *  2) Flajolet, Fusy, Gandouet and Meunier,
+ *     "HyperLogLog: the analysis of a near-optimal
+ *     cardinality estimation algorithm", AofA 2007
+ *
+ * Description of File:
+ *  This file defines an estimate of how many pairs
+ *  of actors are each number of movies apart, over
+ *  the whole graph, without a BFS from every actor.
+ *  Every actor keeps a small HyperLogLog counter of
+ *  the actors it reaches, and all the counters grow
+ *  by one movie per iteration.
+ */
+
+#ifndef DISTANCEDISTRIBUTION_HPP
+#define DISTANCEDISTRIBUTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CSRGraph.hpp"
+
+using namespace std;
+
+/**
+ * The DistanceDistribution class estimates the
+ * neighbourhood function N(t), the number of ordered
+ * pairs of actors at most t movies apart, counting
+ * each actor with itself. After iteration t the
+ * counter of an actor holds the actors within t
+ * movies of it: each movie first takes the union of
+ * the counters of its cast, then each actor takes
+ * the union of the counters of its movies. A union
+ * of two counters is the byte-wise max of their
+ * registers. Only the counters that changed in the
+ * last iteration are merged again, and the
+ * iterations stop once none changes.
+ *
+ * Each estimate of N(t) has a relative standard
+ * error of at most 1.04 / sqrt(registers), so the
+ * bounds given are two standard errors either way.
+ *
+ * Instance variables:
+ *  1) log2Registers - The log2 of the number of
+ *                     registers of each counter
+ *
+ *  2) seed - Picks the hash of the actor ids
+ *
+ *  3) actorRegisters - The registers of the counter
+ *                      of every actor, back to back
+ *
+ *  4) movieRegisters - The registers of the counter
+ *                      of every movie, back to back
+ *
+ *  5) neighbourhood - The estimate of N(t) for t
+ *                     from 0 to the last iteration
+ *
+ *  6) numActors - The number of actors of the graph
+ */
+class DistanceDistribution {
+  protected:
+    unsigned int log2Registers;
+    uint64_t seed;
+    vector<uint8_t> actorRegisters;
+    vector<uint8_t> movieRegisters;
+    vector<double> neighbourhood;
+    unsigned int numActors;
+
+    /*
+     * The purpose of this method is to return the
+     * estimate of the number of actors a counter holds.
+     *
+     * Parameters:
+     *  1) registers - The registers of the counter
+     *
+     */
+    double estimate(const uint8_t* registers) const;
+
+  public:
+    // Fewest and most registers a counter can have, as log2
+    static const unsigned int MIN_LOG2_REGISTERS = 4;
+    static const unsigned int MAX_LOG2_REGISTERS = 12;
+    // Registers of each counter when none is given, as log2
+    static const unsigned int DEFAULT_LOG2_REGISTERS = 7;
+    // Percent of the connected pairs the effective diameter covers
+    static const unsigned int EFFECTIVE_PERCENT = 90;
+
+    /*
+     * This is the contructor method for the
+     * distribution. It is empty until the first run.
+     *
+     * Parameters:
+     *  1) log2Registers - The log2 of the number of
+     *                     registers of each counter,
+     *                     from MIN_LOG2_REGISTERS to
+     *                     MAX_LOG2_REGISTERS
+     *  2) seed - Picks the hash of the actor ids, so
+     *            runs with different seeds are
+     *            independent estimates
+     *
+     */
+    DistanceDistribution(unsigned int log2Registers = DEFAULT_LOG2_REGISTERS,
+                         uint64_t seed = 0);
+
+    /*
+     * This method estimates the neighbourhood function
+     * of a graph, iterating until no counter changes.
+     *
+     * Parameters:
+     *  1) graph - The graph to estimate
+     *  2) numThreads - The number of threads to use
+     *
+     */
+    void run(const CSRGraph& graph, unsigned int numThreads = 1);
+
+    /* Returns the number of registers of each counter */
+    unsigned int getNumRegisters() const { return 1u << this->log2Registers; }
+
+    /* Returns the relative standard error of each estimate of N(t) */
+    double getRelativeError() const;
+
+    /* Returns the estimates of N(t), from t = 0 */
+    const vector<double>& getNeighbourhood() const {
+        return this->neighbourhood;
+    }
+
+    /* Returns the largest distance found between two actors */
+    unsigned int getMaxDistance() const {
+        return this->neighbourhood.empty() ? 0
+                                           : this->neighbourhood.size() - 1;
+    }
+
+    /* Returns the estimated number of ordered pairs exactly t apart */
+    double getPairs(unsigned int t) const {
+        return t == 0 ? this->neighbourhood[0]
+                      : this->neighbourhood[t] - this->neighbourhood[t - 1];
+    }
+
+    /* Returns the lower bound of N(t), two standard errors down */
+    double getLower(unsigned int t) const;
+
+    /* Returns the upper bound of N(t), two standard errors up */
+    double getUpper(unsigned int t) const;
+
+    /*
+     * The purpose of this method is to return the
+     * estimated number of ordered pairs of distinct
+     * actors that are connected.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    double getConnectedPairs() const;
+
+    /*
+     * The purpose of this method is to return the
+     * estimated average number of movies between two
+     * distinct connected actors.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    double getAverageDistance() const;
+
+    /*
+     * The purpose of this method is to return the
+     * smallest distance, interpolated between whole
+     * movies, within which a percent of the connected
+     * pairs of distinct actors are.
+     *
+     * Parameters:
+     *  1) percent - The percent of the pairs
+     *
+     */
+    double getEffectiveDiameter(unsigned int percent = EFFECTIVE_PERCENT) const;
+
+    /*
+     * The purpose of this method is to return the
+     * number of bytes used by the counters.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    size_t memoryUsage() const;
+};
+
+#endif  // DISTANCEDISTRIBUTION_HPP
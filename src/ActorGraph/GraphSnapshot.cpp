@@ -0,0 +1,335 @@
+/**
+ * The GraphSnapshot class writes snapshots and maps
+ * them back in. A snapshot is only read on a machine
+ * with the byte order it was written with, and is
+ * rejected if its version or checksum do not match.
+ *
+ * Instance variables:
+ *  1) data - The start of the mapped snapshot
+ *
+ *  2) size - The number of bytes in the snapshot
+ */
+
+#include "GraphSnapshot.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "Checksum.hpp"
+
+using namespace std;
+
+const uint32_t GraphSnapshot::VERSION;
+
+// The first bytes of every snapshot
+static const char MAGIC[8] = {'A', 'C', 'T', 'G', 'R', 'A', 'P', 'H'};
+
+// Reads back as a different number with the other byte order
+static const uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+/* Returns a size rounded up to a multiple of 8 bytes */
+static uint64_t roundUp(uint64_t size) { return (size + 7) & ~(uint64_t)7; }
+
+/* Writes bytes to a snapshot and adds them to its checksum */
+static void writeBytes(ofstream& out, Checksum& checksum,
+                       const void* bytes, size_t count) {
+    out.write((const char*)bytes, count);
+    checksum.add((const char*)bytes, count);
+}
+
+/* Pads a section of the given size to an 8 byte boundary */
+static void writePadding(ofstream& out, Checksum& checksum,
+                         uint64_t size) {
+    const char zeros[8] = {0};
+    writeBytes(out, checksum, zeros, roundUp(size) - size);
+}
+
+/*
+ * This function works out the sections of a name
+ * table: where each name starts once they are put
+ * back to back, and the open addressing index.
+ *
+ * Parameters:
+ *  1) table - The names to store
+ *  2) names - Filled with the counts and sizes
+ *  3) offsets - Filled with the start of each name
+ *  4) slots - Filled with the index
+ *
+ */
+static void indexNames(const NameTable& table, SnapshotNames& names,
+                       vector<uint64_t>& offsets, vector<unsigned int>& slots) {
+    names.count = table.size();
+    offsets.resize(names.count + 1);
+    uint64_t at = 0;
+    for (unsigned int id = 0; id < names.count; id++) {
+        offsets[id] = at;
+        at += strlen(table.getName(id)) + 1;
+    }
+    offsets[names.count] = at;
+    names.charsSize = at;
+
+    // At most half of the slots are used, so probes stay short
+    names.numSlots = 1;
+    while (names.numSlots < 2 * (uint64_t)names.count) {
+        names.numSlots *= 2;
+    }
+    slots.assign(names.numSlots, NameTable::NO_ID);
+    uint64_t mask = names.numSlots - 1;
+    for (unsigned int id = 0; id < names.count; id++) {
+        uint64_t length = offsets[id + 1] - offsets[id] - 1;
+        uint64_t slot = NameTable::hashName(table.getName(id), length) & mask;
+        while (slots[slot] != NameTable::NO_ID) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id;
+    }
+}
+
+/*
+ * This is the contructor method for a snapshot
+ * that has not been opened yet.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+GraphSnapshot::GraphSnapshot() : data(nullptr), size(0) {}
+
+/*
+ * This method fills in where every section of a
+ * snapshot goes, from its counts and sizes.
+ *
+ * Parameters:
+ *  1) header - The header to lay out
+ *
+ */
+void GraphSnapshot::layout(SnapshotHeader& header) {
+    uint64_t at = sizeof(SnapshotHeader);
+    auto place = [&at](uint64_t& sectionAt, uint64_t sectionSize) {
+        sectionAt = at;
+        at += roundUp(sectionSize);
+    };
+    place(header.actorOffsetsAt, 4 * ((uint64_t)header.numActors + 1));
+    place(header.actorMoviesAt, 4 * header.numEdges);
+    place(header.movieOffsetsAt, 4 * ((uint64_t)header.numMovies + 1));
+    place(header.movieActorsAt, 4 * header.numEdges);
+    place(header.movieYearsAt, 4 * (uint64_t)header.numMovies);
+    for (SnapshotNames* names : {&header.actorNames, &header.movieNames}) {
+        place(names->charsAt, names->charsSize);
+        place(names->offsetsAt, 8 * ((uint64_t)names->count + 1));
+        place(names->slotsAt, 4 * (uint64_t)names->numSlots);
+    }
+    header.fileSize = at;
+}
+
+/*
+ * The purpose of this method is to tell whether
+ * the bytes of a file start like a snapshot.
+ *
+ * Parameters:
+ *  1) data - The first bytes of the file
+ *  2) size - The number of bytes
+ *
+ */
+bool GraphSnapshot::isSnapshot(const char* data, size_t size) {
+    return size >= sizeof(MAGIC) && memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+/*
+ * The purpose of this method is to write the
+ * snapshot of a graph. Returns false if the file
+ * could not be written.
+ *
+ * Parameters:
+ *  1) filename - The name of the snapshot file
+ *  2) graph - The adjacency of the graph
+ *  3) actorNames - The names of the actors
+ *  4) movieNames - The names of the movies
+ *
+ */
+bool GraphSnapshot::write(const char* filename, const CSRGraph& graph,
+                          const NameTable& actorNames,
+                          const NameTable& movieNames) {
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.numActors = graph.numActors();
+    header.numMovies = graph.numMovies();
+    header.numEdges = graph.numEdges();
+    vector<uint64_t> actorOffsets;
+    vector<uint64_t> movieOffsets;
+    vector<unsigned int> actorSlots;
+    vector<unsigned int> movieSlots;
+    indexNames(actorNames, header.actorNames, actorOffsets, actorSlots);
+    indexNames(movieNames, header.movieNames, movieOffsets, movieSlots);
+    layout(header);
+
+    // The header goes in last, once the checksum is known
+    ofstream out(filename, ios::binary | ios::trunc);
+    out.write((const char*)&header, sizeof(header));
+    Checksum checksum;
+
+    // The sections, in the order layout places them
+    uint64_t sizes[] = {4 * ((uint64_t)header.numActors + 1),
+                        4 * header.numEdges,
+                        4 * ((uint64_t)header.numMovies + 1),
+                        4 * header.numEdges, 4 * (uint64_t)header.numMovies};
+    const void* arrays[] = {graph.getActorOffsets(), graph.getActorMovies(),
+                            graph.getMovieOffsets(), graph.getMovieActors(),
+                            graph.getMovieYears()};
+    for (unsigned int i = 0; i < 5; i++) {
+        writeBytes(out, checksum, arrays[i], sizes[i]);
+        writePadding(out, checksum, sizes[i]);
+    }
+    const NameTable* tables[] = {&actorNames, &movieNames};
+    const SnapshotNames* names[] = {&header.actorNames, &header.movieNames};
+    const vector<uint64_t>* offsets[] = {&actorOffsets, &movieOffsets};
+    const vector<unsigned int>* slots[] = {&actorSlots, &movieSlots};
+    for (unsigned int t = 0; t < 2; t++) {
+        for (unsigned int id = 0; id < names[t]->count; id++) {
+            writeBytes(out, checksum, tables[t]->getName(id),
+                       (*offsets[t])[id + 1] - (*offsets[t])[id]);
+        }
+        writePadding(out, checksum, names[t]->charsSize);
+        writeBytes(out, checksum, offsets[t]->data(),
+                   8 * offsets[t]->size());
+        writeBytes(out, checksum, slots[t]->data(), 4 * slots[t]->size());
+        writePadding(out, checksum, 4 * slots[t]->size());
+    }
+    if (!out || (uint64_t)out.tellp() != header.fileSize) {
+        return false;
+    }
+
+    header.checksum = checksum.finish();
+    out.seekp(0);
+    out.write((const char*)&header, sizeof(header));
+    out.close();
+    return !out.fail();
+}
+
+/*
+ * The purpose of this method is to map a snapshot
+ * and check it. Returns false, after saying why,
+ * if it cannot be used.
+ *
+ * Parameters:
+ *  1) filename - The name of the snapshot file
+ *
+ */
+bool GraphSnapshot::open(const char* filename) {
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        cerr << "Failed to read " << filename << endl;
+        return false;
+    }
+    struct stat info;
+    void* mapping = MAP_FAILED;
+    if (fstat(fd, &info) == 0 &&
+        (size_t)info.st_size >= sizeof(SnapshotHeader)) {
+        this->size = info.st_size;
+        mapping = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // The mapping stays valid once the file is closed
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        cerr << filename << " is not a valid graph snapshot" << endl;
+        this->size = 0;
+        return false;
+    }
+    this->data = (const char*)mapping;
+
+    // The sections must be exactly where this version puts them
+    SnapshotHeader expected = this->header();
+    layout(expected);
+    const SnapshotHeader& actual = this->header();
+    bool valid =
+        memcmp(actual.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+        actual.byteOrder == BYTE_ORDER_MARK && actual.version == VERSION &&
+        memcmp(&actual, &expected, sizeof(SnapshotHeader)) == 0 &&
+        actual.fileSize == this->size &&
+        actual.actorNames.count == actual.numActors &&
+        actual.movieNames.count == actual.numMovies;
+    for (const SnapshotNames* names :
+         {&actual.actorNames, &actual.movieNames}) {
+        valid = valid && names->numSlots > 0 &&
+                (names->numSlots & (names->numSlots - 1)) == 0;
+    }
+    if (!valid) {
+        cerr << filename << " is not a valid graph snapshot" << endl;
+    } else {
+        Checksum checksum;
+        checksum.add(this->data + sizeof(SnapshotHeader),
+                     this->size - sizeof(SnapshotHeader));
+        valid = checksum.finish() == actual.checksum;
+        if (!valid) {
+            cerr << filename << " is corrupt (checksum mismatch)" << endl;
+        }
+    }
+    if (!valid) {
+        munmap((void*)this->data, this->size);
+        this->data = nullptr;
+        this->size = 0;
+    }
+    return valid;
+}
+
+/*
+ * The purpose of this method is to make a CSR
+ * graph whose arrays are in the snapshot. The
+ * graph must not outlive the snapshot.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+CSRGraph* GraphSnapshot::makeGraph() const {
+    const SnapshotHeader& header = this->header();
+    return new CSRGraph(
+        header.numActors, header.numMovies,
+        (const unsigned int*)(this->data + header.actorOffsetsAt),
+        (const unsigned int*)(this->data + header.actorMoviesAt),
+        (const unsigned int*)(this->data + header.movieOffsetsAt),
+        (const unsigned int*)(this->data + header.movieActorsAt),
+        (const int*)(this->data + header.movieYearsAt));
+}
+
+/*
+ * The purpose of this method is to turn two name
+ * tables into views of the names in the snapshot.
+ * The tables must not outlive the snapshot.
+ *
+ * Parameters:
+ *  1) actorNames - Becomes the names of the actors
+ *  2) movieNames - Becomes the names of the movies
+ *
+ */
+void GraphSnapshot::mapNames(NameTable& actorNames,
+                             NameTable& movieNames) const {
+    NameTable* tables[] = {&actorNames, &movieNames};
+    const SnapshotNames* names[] = {&this->header().actorNames,
+                                    &this->header().movieNames};
+    for (unsigned int t = 0; t < 2; t++) {
+        tables[t]->map(this->data + names[t]->charsAt,
+                       (const uint64_t*)(this->data + names[t]->offsetsAt),
+                       names[t]->count,
+                       (const unsigned int*)(this->data + names[t]->slotsAt),
+                       names[t]->numSlots);
+    }
+}
+
+/*
+ * This is the destructor method. It unmaps the
+ * snapshot.
+ *
+ */
+GraphSnapshot::~GraphSnapshot() {
+    if (this->data != nullptr) {
+        munmap((void*)this->data, this->size);
+    }
+}
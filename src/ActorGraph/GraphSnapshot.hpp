@@ -0,0 +1,176 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Description of File:
+ *  This file defines the binary snapshot of a built
+ *  actor graph. A snapshot holds the name tables, the
+ *  CSR adjacency and the movie years laid out exactly
+ *  as they are used in memory, so loading one is a
+ *  single mmap with nothing to parse or construct.
+ */
+
+#ifndef GRAPHSNAPSHOT_HPP
+#define GRAPHSNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "CSRGraph.hpp"
+#include "NameTable.hpp"
+
+using namespace std;
+
+/* Where the sections of one name table are in a snapshot */
+struct SnapshotNames {
+    uint64_t charsAt;
+    uint64_t charsSize;
+    uint64_t offsetsAt;
+    uint64_t slotsAt;
+    uint32_t count;
+    uint32_t numSlots;
+};
+
+/*
+ * The header at the start of a snapshot. Every "At"
+ * field is the byte offset of a section, and every
+ * section starts on an 8 byte boundary.
+ */
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    // Checksum of every byte after the header
+    uint64_t checksum;
+    uint64_t fileSize;
+    uint32_t numActors;
+    uint32_t numMovies;
+    uint64_t numEdges;
+    uint64_t actorOffsetsAt;
+    uint64_t actorMoviesAt;
+    uint64_t movieOffsetsAt;
+    uint64_t movieActorsAt;
+    uint64_t movieYearsAt;
+    SnapshotNames actorNames;
+    SnapshotNames movieNames;
+};
+
+/**
+ * The GraphSnapshot class writes snapshots and maps
+ * them back in. A snapshot is only read on a machine
+ * with the byte order it was written with, and is
+ * rejected if its version or checksum do not match.
+ *
+ * Instance variables:
+ *  1) data - The start of the mapped snapshot
+ *
+ *  2) size - The number of bytes in the snapshot
+ */
+class GraphSnapshot {
+  protected:
+    const char* data;
+    size_t size;
+
+    /*
+     * This method fills in where every section of a
+     * snapshot goes, from its counts and sizes.
+     *
+     * Parameters:
+     *  1) header - The header to lay out
+     *
+     */
+    static void layout(SnapshotHeader& header);
+
+    /* Returns the header of the mapped snapshot */
+    const SnapshotHeader& header() const {
+        return *(const SnapshotHeader*)this->data;
+    }
+
+  public:
+    // Number of the current snapshot format
+    static const uint32_t VERSION = 1;
+
+    /*
+     * This is the contructor method for a snapshot
+     * that has not been opened yet.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    GraphSnapshot();
+
+    // The mapping is released once, by the destructor
+    GraphSnapshot(const GraphSnapshot&) = delete;
+    GraphSnapshot& operator=(const GraphSnapshot&) = delete;
+
+    /*
+     * The purpose of this method is to tell whether
+     * the bytes of a file start like a snapshot.
+     *
+     * Parameters:
+     *  1) data - The first bytes of the file
+     *  2) size - The number of bytes
+     *
+     */
+    static bool isSnapshot(const char* data, size_t size);
+
+    /*
+     * The purpose of this method is to write the
+     * snapshot of a graph. Returns false if the file
+     * could not be written.
+     *
+     * Parameters:
+     *  1) filename - The name of the snapshot file
+     *  2) graph - The adjacency of the graph
+     *  3) actorNames - The names of the actors
+     *  4) movieNames - The names of the movies
+     *
+     */
+    static bool write(const char* filename, const CSRGraph& graph,
+                      const NameTable& actorNames,
+                      const NameTable& movieNames);
+
+    /*
+     * The purpose of this method is to map a snapshot
+     * and check it. Returns false, after saying why,
+     * if it cannot be used.
+     *
+     * Parameters:
+     *  1) filename - The name of the snapshot file
+     *
+     */
+    bool open(const char* filename);
+
+    /*
+     * The purpose of this method is to make a CSR
+     * graph whose arrays are in the snapshot. The
+     * graph must not outlive the snapshot.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    CSRGraph* makeGraph() const;
+
+    /*
+     * The purpose of this method is to turn two name
+     * tables into views of the names in the snapshot.
+     * The tables must not outlive the snapshot.
+     *
+     * Parameters:
+     *  1) actorNames - Becomes the names of the actors
+     *  2) movieNames - Becomes the names of the movies
+     *
+     */
+    void mapNames(NameTable& actorNames, NameTable& movieNames) const;
+
+    /*
+     * This is the destructor method. It unmaps the
+     * snapshot.
+     *
+     */
+    ~GraphSnapshot();
+};
+
+#endif  // GRAPHSNAPSHOT_HPP
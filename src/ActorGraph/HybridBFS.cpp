@@ -0,0 +1,294 @@
+/**
+ * The HybridBFS class runs a BFS from one actor,
+ * expanding each step either top down or bottom up.
+ *
+ * Instance variables:
+ *  1) actorSeen - The bitmap of the reached actors
+ *
+ *  2) movieSeen - The bitmap of the reached movies
+ *
+ *  3) actorFrontier - The actors reached on the last level
+ *
+ *  4) movieFrontier - The movies reached on the last step
+ *
+ *  5) actorNext - The actors reached on the level being built
+ *
+ *  6) levels - The level of each reached actor
+ *
+ *  7) prevMovies - The movie each reached actor was reached
+ *                  through
+ *
+ *  8) movieParents - The actor each reached movie was reached
+ *                    from
+ *
+ *  9) numTopDown - The number of top down steps
+ *
+ *  10) numBottomUp - The number of bottom up steps
+ */
+
+#include "HybridBFS.hpp"
+#include <algorithm>
+
+using namespace std;
+
+const unsigned int HybridBFS::NO_LEVEL;
+const unsigned int HybridBFS::ALPHA;
+const unsigned int HybridBFS::BETA;
+
+/* Returns bit i of a bitmap */
+static inline bool testBit(const vector<uint64_t>& bits, unsigned int i) {
+    return (bits[i >> 6] >> (i & 63)) & 1;
+}
+
+/* Sets bit i of a bitmap */
+static inline void setBit(vector<uint64_t>& bits, unsigned int i) {
+    bits[i >> 6] |= uint64_t(1) << (i & 63);
+}
+
+/*
+ * This function calls visit(i) for every i below
+ * size whose bit is set in a bitmap, or clear if
+ * flip is true, in increasing order.
+ *
+ * Parameters:
+ *  1) bits - The bitmap
+ *  2) size - The number of bits in use
+ *  3) flip - Whether to visit the clear bits instead
+ *  4) visit - What to do with each bit
+ *
+ */
+template <typename Visit>
+static void forEachBit(const vector<uint64_t>& bits, unsigned int size,
+                       bool flip, const Visit& visit) {
+    size_t numWords = (size + 63) / 64;
+    for (size_t w = 0; w < numWords; w++) {
+        uint64_t word = flip ? ~bits[w] : bits[w];
+        while (word != 0) {
+            unsigned int i = w * 64 + __builtin_ctzll(word);
+            if (i >= size) {
+                return;
+            }
+            visit(i);
+            word &= word - 1;
+        }
+    }
+}
+
+/*
+ * This function decides the direction of a step.
+ * A top down step turns bottom up once the frontier
+ * has more than 1 / ALPHA of the edges left to check,
+ * and a bottom up step stays so until the frontier
+ * has fewer than 1 / BETA of the nodes.
+ *
+ * Parameters:
+ *  1) bottomUp - The direction of the last such step
+ *  2) frontierEdges - The edges out of the frontier
+ *  3) unseenEdges - The edges into the nodes not yet
+ *                   reached
+ *  4) frontierSize - The number of frontier nodes
+ *  5) numNodes - The number of nodes on the side of
+ *                the frontier
+ *
+ */
+static bool goBottomUp(bool bottomUp, size_t frontierEdges,
+                       size_t unseenEdges, size_t frontierSize,
+                       size_t numNodes) {
+    if (!bottomUp) {
+        return frontierEdges > unseenEdges / HybridBFS::ALPHA;
+    }
+    return frontierSize >= numNodes / HybridBFS::BETA;
+}
+
+/*
+ * This is the contructor method for the search.
+ * The arrays are sized by the first search.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+HybridBFS::HybridBFS() {
+    this->numTopDown = 0;
+    this->numBottomUp = 0;
+}
+
+/*
+ * This method runs the BFS from a source. It stops
+ * after the level that reaches the target, or once
+ * every reachable actor has been reached if there
+ * is no target.
+ *
+ * Parameters:
+ *  1) graph - The graph to search
+ *  2) sourceId - The actor to start from
+ *  3) targetId - The actor to stop at, or
+ *                CSRGraph::NO_ID to reach them all
+ *
+ */
+void HybridBFS::run(const CSRGraph& graph, unsigned int sourceId,
+                    unsigned int targetId) {
+    unsigned int numActors = graph.numActors();
+    unsigned int numMovies = graph.numMovies();
+    size_t actorWords = (numActors + 63) / 64;
+    size_t movieWords = (numMovies + 63) / 64;
+    this->actorSeen.assign(actorWords, 0);
+    this->actorFrontier.assign(actorWords, 0);
+    this->actorNext.assign(actorWords, 0);
+    this->movieSeen.assign(movieWords, 0);
+    this->movieFrontier.assign(movieWords, 0);
+    // Only read for reached nodes, so they need no clearing
+    if (this->levels.size() < numActors) {
+        this->levels.resize(numActors);
+        this->prevMovies.resize(numActors);
+    }
+    if (this->movieParents.size() < numMovies) {
+        this->movieParents.resize(numMovies);
+    }
+    this->numTopDown = 0;
+    this->numBottomUp = 0;
+
+    setBit(this->actorSeen, sourceId);
+    setBit(this->actorFrontier, sourceId);
+    this->levels[sourceId] = 0;
+    this->prevMovies[sourceId] = CSRGraph::NO_ID;
+    size_t frontierActors = 1;
+    size_t frontierEdges =
+        graph.moviesEnd(sourceId) - graph.moviesBegin(sourceId);
+    // Each edge is counted once from each side
+    size_t unseenMovieEdges = graph.numEdges();
+    size_t unseenActorEdges = graph.numEdges() - frontierEdges;
+    bool moviesBottomUp = false;
+    bool actorsBottomUp = false;
+
+    for (unsigned int level = 1; frontierActors > 0; level++) {
+        if (targetId != CSRGraph::NO_ID && this->hasActor(targetId)) {
+            return;
+        }
+
+        // Step 1: from the actor frontier to the movie frontier
+        moviesBottomUp = goBottomUp(moviesBottomUp, frontierEdges,
+                                    unseenMovieEdges, frontierActors,
+                                    numActors);
+        fill(this->movieFrontier.begin(), this->movieFrontier.end(), 0);
+        size_t frontierMovies = 0;
+        frontierEdges = 0;
+        auto reachMovie = [&](unsigned int movieId, unsigned int actorId) {
+            setBit(this->movieSeen, movieId);
+            setBit(this->movieFrontier, movieId);
+            this->movieParents[movieId] = actorId;
+            frontierMovies++;
+            frontierEdges +=
+                graph.actorsEnd(movieId) - graph.actorsBegin(movieId);
+        };
+        if (moviesBottomUp) {
+            this->numBottomUp++;
+            forEachBit(this->movieSeen, numMovies, true, [&](unsigned int m) {
+                for (auto actor = graph.actorsBegin(m);
+                     actor != graph.actorsEnd(m); actor++) {
+                    if (testBit(this->actorFrontier, *actor)) {
+                        reachMovie(m, *actor);
+                        break;
+                    }
+                }
+            });
+        } else {
+            this->numTopDown++;
+            forEachBit(this->actorFrontier, numActors, false,
+                       [&](unsigned int a) {
+                           for (auto movie = graph.moviesBegin(a);
+                                movie != graph.moviesEnd(a); movie++) {
+                               if (!testBit(this->movieSeen, *movie)) {
+                                   reachMovie(*movie, a);
+                               }
+                           }
+                       });
+        }
+        unseenMovieEdges -= frontierEdges;
+
+        // Step 2: from the movie frontier to the next actor frontier
+        actorsBottomUp = goBottomUp(actorsBottomUp, frontierEdges,
+                                    unseenActorEdges, frontierMovies,
+                                    numMovies);
+        fill(this->actorNext.begin(), this->actorNext.end(), 0);
+        frontierActors = 0;
+        frontierEdges = 0;
+        auto reachActor = [&](unsigned int actorId, unsigned int movieId) {
+            setBit(this->actorSeen, actorId);
+            setBit(this->actorNext, actorId);
+            this->levels[actorId] = level;
+            this->prevMovies[actorId] = movieId;
+            frontierActors++;
+            frontierEdges +=
+                graph.moviesEnd(actorId) - graph.moviesBegin(actorId);
+        };
+        if (actorsBottomUp) {
+            this->numBottomUp++;
+            forEachBit(this->actorSeen, numActors, true, [&](unsigned int a) {
+                for (auto movie = graph.moviesBegin(a);
+                     movie != graph.moviesEnd(a); movie++) {
+                    if (testBit(this->movieFrontier, *movie)) {
+                        reachActor(a, *movie);
+                        break;
+                    }
+                }
+            });
+        } else {
+            this->numTopDown++;
+            forEachBit(this->movieFrontier, numMovies, false,
+                       [&](unsigned int m) {
+                           for (auto actor = graph.actorsBegin(m);
+                                actor != graph.actorsEnd(m); actor++) {
+                               if (!testBit(this->actorSeen, *actor)) {
+                                   reachActor(*actor, m);
+                               }
+                           }
+                       });
+        }
+        unseenActorEdges -= frontierEdges;
+        this->actorFrontier.swap(this->actorNext);
+    }
+}
+
+/*
+ * This method walks a shortest path from the
+ * source of the last search to an actor it reached.
+ * Returns false if it was not reached.
+ *
+ * Parameters:
+ *  1) toId - The actor the path ends at
+ *  2) actorIds - Filled with the actors on the path
+ *  3) movieIds - Filled with the movies between them
+ *
+ */
+bool HybridBFS::getPath(unsigned int toId, vector<unsigned int>& actorIds,
+                        vector<unsigned int>& movieIds) const {
+    actorIds.clear();
+    movieIds.clear();
+    if (!this->hasActor(toId)) {
+        return false;
+    }
+    unsigned int current = toId;
+    actorIds.push_back(current);
+    while (this->prevMovies[current] != CSRGraph::NO_ID) {
+        movieIds.push_back(this->prevMovies[current]);
+        current = this->movieParents[this->prevMovies[current]];
+        actorIds.push_back(current);
+    }
+    reverse(actorIds.begin(), actorIds.end());
+    reverse(movieIds.begin(), movieIds.end());
+    return true;
+}
+
+/*
+ * The purpose of this method is to return the
+ * search owned by the calling thread.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+HybridBFS& HybridBFS::forThread() {
+    static thread_local HybridBFS search;
+    return search;
+}
@@ -0,0 +1,163 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Sources used:
+ *  1) Beamer, Asanovic and Patterson, "Direction-Optimizing
+ *     Breadth-First Search", SC 2012
+ *
+ * Description of File:
+ *  This file defines a BFS over the CSR graph that
+ *  keeps its frontiers as bitmaps and expands each
+ *  level either top down, from the frontier, or
+ *  bottom up, from the nodes not reached yet,
+ *  whichever should check fewer edges.
+ */
+
+#ifndef HYBRIDBFS_HPP
+#define HYBRIDBFS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CSRGraph.hpp"
+
+using namespace std;
+
+/**
+ * The HybridBFS class runs a BFS from one actor. Each
+ * level takes two steps: from the actor frontier to
+ * the movie frontier, then from the movie frontier to
+ * the next actor frontier. A top down step checks the
+ * edges of every frontier node. A bottom up step
+ * checks the edges of every node not reached yet and
+ * stops at the first one that leads to the frontier,
+ * which is cheaper once the frontier holds a large
+ * part of the graph. A step goes bottom up once the
+ * frontier has more than 1 / ALPHA of the edges left
+ * to check, and back top down once the frontier has
+ * fewer than 1 / BETA of the nodes.
+ *
+ * Instance variables:
+ *  1) actorSeen - The bitmap of the reached actors
+ *
+ *  2) movieSeen - The bitmap of the reached movies
+ *
+ *  3) actorFrontier - The bitmap of the actors
+ *                     reached on the last level
+ *
+ *  4) movieFrontier - The bitmap of the movies
+ *                     reached on the last step
+ *
+ *  5) actorNext - The bitmap of the actors reached
+ *                 on the level being built
+ *
+ *  6) levels - The number of movies between the
+ *              source and each reached actor
+ *
+ *  7) prevMovies - The movie each reached actor was
+ *                  reached through
+ *
+ *  8) movieParents - The actor each reached movie was
+ *                    reached from
+ *
+ *  9) numTopDown - The number of top down steps of
+ *                  the last search
+ *
+ *  10) numBottomUp - The number of bottom up steps of
+ *                    the last search
+ */
+class HybridBFS {
+  protected:
+    vector<uint64_t> actorSeen;
+    vector<uint64_t> movieSeen;
+    vector<uint64_t> actorFrontier;
+    vector<uint64_t> movieFrontier;
+    vector<uint64_t> actorNext;
+    vector<unsigned int> levels;
+    vector<unsigned int> prevMovies;
+    vector<unsigned int> movieParents;
+    unsigned int numTopDown;
+    unsigned int numBottomUp;
+
+  public:
+    // Level of an actor the source does not reach
+    static const unsigned int NO_LEVEL = 0xFFFFFFFFu;
+    // A step goes bottom up when the frontier has 1 / ALPHA of the
+    // edges left to check
+    static const unsigned int ALPHA = 14;
+    // A step goes back top down when the frontier has fewer than
+    // 1 / BETA of the nodes
+    static const unsigned int BETA = 24;
+
+    /*
+     * This is the contructor method for the search.
+     * The arrays are sized by the first search.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    HybridBFS();
+
+    /*
+     * This method runs the BFS from a source. It stops
+     * after the level that reaches the target, or once
+     * every reachable actor has been reached if there
+     * is no target.
+     *
+     * Parameters:
+     *  1) graph - The graph to search
+     *  2) sourceId - The actor to start from
+     *  3) targetId - The actor to stop at, or
+     *                CSRGraph::NO_ID to reach them all
+     *
+     */
+    void run(const CSRGraph& graph, unsigned int sourceId,
+             unsigned int targetId = CSRGraph::NO_ID);
+
+    /* Returns true if the last search reached the actor */
+    bool hasActor(unsigned int actorId) const {
+        return (this->actorSeen[actorId >> 6] >> (actorId & 63)) & 1;
+    }
+
+    /* Returns the level of an actor, or NO_LEVEL if it was not reached */
+    unsigned int getLevel(unsigned int actorId) const {
+        return this->hasActor(actorId) ? this->levels[actorId] : NO_LEVEL;
+    }
+
+    /* Returns the number of top down steps of the last search */
+    unsigned int getNumTopDown() const { return this->numTopDown; }
+
+    /* Returns the number of bottom up steps of the last search */
+    unsigned int getNumBottomUp() const { return this->numBottomUp; }
+
+    /*
+     * This method walks a shortest path from the
+     * source of the last search to an actor it reached.
+     * Returns false if it was not reached.
+     *
+     * Parameters:
+     *  1) toId - The actor the path ends at
+     *  2) actorIds - Filled with the actors on the path
+     *  3) movieIds - Filled with the movies between them
+     *
+     */
+    bool getPath(unsigned int toId, vector<unsigned int>& actorIds,
+                 vector<unsigned int>& movieIds) const;
+
+    /*
+     * The purpose of this method is to return the
+     * search owned by the calling thread, so that
+     * searches on different threads do not share
+     * bitmaps.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    static HybridBFS& forThread();
+};
+
+#endif  // HYBRIDBFS_HPP
@@ -0,0 +1,182 @@
+/**
+ * The LandmarkOracle class runs one BFS from each
+ * landmark and keeps the distances in a table with a
+ * row of one byte per landmark for every actor.
+ *
+ * Instance variables:
+ *  1) numLandmarks - The number of landmarks
+ *
+ *  2) landmarks - The actor id of each landmark
+ *
+ *  3) distances - The distance of every actor to
+ *                 every landmark, by actor
+ */
+
+#include "LandmarkOracle.hpp"
+#include <algorithm>
+#include <random>
+#include "HybridBFS.hpp"
+#include "Parallel.hpp"
+
+using namespace std;
+
+const unsigned int LandmarkOracle::NO_DISTANCE;
+const unsigned int LandmarkOracle::MAX_DISTANCE;
+const uint8_t LandmarkOracle::FAR_AWAY;
+const uint8_t LandmarkOracle::NOT_CONNECTED;
+const unsigned int LandmarkOracle::DEFAULT_LANDMARKS;
+
+// Seed of the random landmarks, fixed so that runs agree
+static const unsigned int RANDOM_SEED = 1;
+
+/*
+ * This is the contructor method for the oracle.
+ * It chooses the landmarks and runs a BFS from
+ * each of them.
+ *
+ * Parameters:
+ *  1) graph - The graph to bound distances in
+ *  2) numLandmarks - The number of landmarks
+ *  3) choice - How to choose the landmarks
+ *  4) numThreads - The number of threads to use
+ *
+ */
+LandmarkOracle::LandmarkOracle(const CSRGraph& graph,
+                               unsigned int numLandmarks,
+                               LandmarkChoice choice,
+                               unsigned int numThreads) {
+    unsigned int numActors = graph.numActors();
+    this->numLandmarks = min(numLandmarks, numActors);
+    this->distances.assign((size_t)numActors * this->numLandmarks,
+                           NOT_CONNECTED);
+
+    // Copies the levels of the last BFS into the column of a landmark
+    auto storeLevels = [this, numActors](const HybridBFS& search,
+                                         unsigned int i) {
+        for (unsigned int a = 0; a < numActors; a++) {
+            unsigned int level = search.getLevel(a);
+            if (level <= MAX_DISTANCE) {
+                this->distances[(size_t)a * this->numLandmarks + i] = level;
+            } else if (level != HybridBFS::NO_LEVEL) {
+                this->distances[(size_t)a * this->numLandmarks + i] = FAR_AWAY;
+            }
+        }
+    };
+
+    vector<unsigned int> actors(numActors);
+    for (unsigned int a = 0; a < numActors; a++) {
+        actors[a] = a;
+    }
+    if (choice == RANDOM_LANDMARKS) {
+        mt19937 generator(RANDOM_SEED);
+        for (unsigned int i = 0; i < this->numLandmarks; i++) {
+            uniform_int_distribution<unsigned int> pick(i, numActors - 1);
+            swap(actors[i], actors[pick(generator)]);
+        }
+    } else {
+        vector<size_t> coStars(numActors);
+        for (unsigned int a = 0; a < numActors; a++) {
+            coStars[a] = graph.numCoStars(a);
+        }
+        stable_sort(actors.begin(), actors.end(),
+                    [&coStars](unsigned int a, unsigned int b) {
+                        return coStars[a] > coStars[b];
+                    });
+    }
+
+    if (choice != FARTHEST_LANDMARKS) {
+        this->landmarks.assign(actors.begin(),
+                               actors.begin() + this->numLandmarks);
+        parallelFor(numThreads, this->numLandmarks, [&](size_t i) {
+            HybridBFS& search = HybridBFS::forThread();
+            search.run(graph, this->landmarks[i]);
+            storeLevels(search, i);
+        });
+        return;
+    }
+
+    // Start from the actor with the most co-stars, then keep taking
+    // the actor farthest from its nearest landmark
+    vector<uint8_t> nearest(numActors, NOT_CONNECTED);
+    unsigned int next = numActors > 0 ? actors[0] : 0;
+    for (unsigned int i = 0; i < this->numLandmarks; i++) {
+        this->landmarks.push_back(next);
+        HybridBFS& search = HybridBFS::forThread();
+        search.run(graph, next);
+        storeLevels(search, i);
+        unsigned int farthest = 0;
+        for (unsigned int a = 0; a < numActors; a++) {
+            size_t cell = (size_t)a * this->numLandmarks + i;
+            nearest[a] = min(nearest[a], this->distances[cell]);
+            if (nearest[a] != NOT_CONNECTED && nearest[a] > farthest) {
+                farthest = nearest[a];
+                next = a;
+            }
+        }
+        // Every connected actor is a landmark, so go to another component
+        for (size_t j = 0; farthest == 0 && j < numActors; j++) {
+            if (nearest[actors[j]] != 0) {
+                farthest = nearest[actors[j]];
+                next = actors[j];
+            }
+        }
+    }
+}
+
+/*
+ * The purpose of this method is to bound the
+ * number of movies between two actors.
+ *
+ * Parameters:
+ *  1) fromId - The first actor
+ *  2) toId - The second actor
+ *  3) lower - Set to the lower bound
+ *  4) upper - Set to the upper bound
+ *
+ */
+void LandmarkOracle::bounds(unsigned int fromId, unsigned int toId,
+                            unsigned int& lower, unsigned int& upper) const {
+    if (fromId == toId) {
+        lower = 0;
+        upper = 0;
+        return;
+    }
+    const uint8_t* fromRow =
+        this->distances.data() + (size_t)fromId * this->numLandmarks;
+    const uint8_t* toRow =
+        this->distances.data() + (size_t)toId * this->numLandmarks;
+    lower = 1;
+    upper = NO_DISTANCE;
+    for (unsigned int i = 0; i < this->numLandmarks; i++) {
+        unsigned int fromDistance = fromRow[i];
+        unsigned int toDistance = toRow[i];
+        // Only one of them is connected to the landmark
+        if ((fromDistance == NOT_CONNECTED) != (toDistance == NOT_CONNECTED)) {
+            lower = NO_DISTANCE;
+            upper = NO_DISTANCE;
+            return;
+        }
+        // A distance past the table bounds nothing
+        if (fromDistance >= FAR_AWAY || toDistance >= FAR_AWAY) {
+            continue;
+        }
+        upper = min(upper, fromDistance + toDistance);
+        unsigned int difference = fromDistance > toDistance
+                                      ? fromDistance - toDistance
+                                      : toDistance - fromDistance;
+        lower = max(lower, difference);
+    }
+}
+
+/*
+ * The purpose of this method is to return the
+ * number of bytes used by the oracle.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+size_t LandmarkOracle::memoryUsage() const {
+    return sizeof(unsigned int) * this->landmarks.capacity() +
+           sizeof(uint8_t) * this->distances.capacity();
+}
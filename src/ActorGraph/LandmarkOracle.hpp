@@ -0,0 +1,156 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Sources used:
+ *  1) Goldberg and Harrelson, "Computing the Shortest
+ *     Path: A* Search Meets Graph Theory", SODA 2005
+ *
+ * Description of File:
+ *  This file defines a distance oracle over the actors
+ *  made of the BFS distances from a few landmark
+ *  actors. By the triangle inequality, the distances
+ *  of two actors to the same landmark bound the
+ *  distance between them from above and below.
+ */
+
+#ifndef LANDMARKORACLE_HPP
+#define LANDMARKORACLE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CSRGraph.hpp"
+
+using namespace std;
+
+/* The ways the landmarks can be chosen */
+enum LandmarkChoice {
+    // The actors with the most co-stars
+    DEGREE_LANDMARKS,
+    // Actors picked at random, the same ones every time
+    RANDOM_LANDMARKS,
+    // Each landmark is the actor farthest from the earlier ones
+    FARTHEST_LANDMARKS
+};
+
+/**
+ * The LandmarkOracle class runs one BFS from each
+ * landmark and keeps the distances in a table with a
+ * row of one byte per landmark for every actor, so a
+ * pair of actors is bounded by reading two rows.
+ *
+ * Instance variables:
+ *  1) numLandmarks - The number of landmarks
+ *
+ *  2) landmarks - The actor id of each landmark
+ *
+ *  3) distances - distances[a * numLandmarks + i] is
+ *                 the number of movies between actor
+ *                 a and landmark i, FAR_AWAY or
+ *                 NOT_CONNECTED
+ */
+class LandmarkOracle {
+  protected:
+    unsigned int numLandmarks;
+    vector<unsigned int> landmarks;
+    vector<uint8_t> distances;
+
+  public:
+    // Distance bound of two actors that are not connected
+    static const unsigned int NO_DISTANCE = 0xFFFFFFFFu;
+    // Largest distance to a landmark the table can hold
+    static const unsigned int MAX_DISTANCE = 253;
+    // Marks an actor farther than MAX_DISTANCE from a landmark
+    static const uint8_t FAR_AWAY = 0xFE;
+    // Marks an actor not connected to a landmark
+    static const uint8_t NOT_CONNECTED = 0xFF;
+    // Number of landmarks used when none is given
+    static const unsigned int DEFAULT_LANDMARKS = 16;
+
+    /*
+     * This is the contructor method for the oracle.
+     * It chooses the landmarks and runs a BFS from
+     * each of them. Actors farther than MAX_DISTANCE
+     * from a landmark are marked FAR_AWAY, and give no
+     * bound through it.
+     *
+     * Parameters:
+     *  1) graph - The graph to bound distances in
+     *  2) numLandmarks - The number of landmarks,
+     *                    at most the number of actors
+     *  3) choice - How to choose the landmarks
+     *  4) numThreads - The number of threads to use
+     *
+     */
+    LandmarkOracle(const CSRGraph& graph, unsigned int numLandmarks,
+                   LandmarkChoice choice, unsigned int numThreads = 1);
+
+    /* Returns the number of landmarks */
+    unsigned int size() const { return this->numLandmarks; }
+
+    /* Returns the actor id of a landmark */
+    unsigned int getLandmark(unsigned int i) const {
+        return this->landmarks[i];
+    }
+
+    /*
+     * The purpose of this method is to bound the
+     * number of movies between two actors. The lower
+     * bound is NO_DISTANCE if a landmark shows they
+     * are not connected, and the upper bound is
+     * NO_DISTANCE if no landmark is within
+     * MAX_DISTANCE of both.
+     *
+     * Parameters:
+     *  1) fromId - The first actor
+     *  2) toId - The second actor
+     *  3) lower - Set to the lower bound
+     *  4) upper - Set to the upper bound
+     *
+     */
+    void bounds(unsigned int fromId, unsigned int toId, unsigned int& lower,
+                unsigned int& upper) const;
+
+    /*
+     * The purpose of this method is to return a lower
+     * bound on the number of movies between two actors
+     * without any branch, for pruning searches. It is
+     * only a bound for two connected actors, and skips
+     * the landmarks either of them is FAR_AWAY from.
+     *
+     * Parameters:
+     *  1) fromId - The first actor
+     *  2) toId - The second actor
+     *
+     */
+    unsigned int lowerBound(unsigned int fromId, unsigned int toId) const {
+        const uint8_t* fromRow =
+            this->distances.data() + (size_t)fromId * this->numLandmarks;
+        const uint8_t* toRow =
+            this->distances.data() + (size_t)toId * this->numLandmarks;
+        // Connected actors are both connected to a landmark or neither
+        uint8_t lower = 0;
+        for (unsigned int i = 0; i < this->numLandmarks; i++) {
+            uint8_t difference = fromRow[i] > toRow[i] ? fromRow[i] - toRow[i]
+                                                       : toRow[i] - fromRow[i];
+            bool isFar = fromRow[i] == FAR_AWAY || toRow[i] == FAR_AWAY;
+            lower = max(lower, isFar ? (uint8_t)0 : difference);
+        }
+        return lower;
+    }
+
+    /*
+     * The purpose of this method is to return the
+     * number of bytes used by the oracle.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    size_t memoryUsage() const;
+};
+
+#endif  // LANDMARKORACLE_HPP
@@ -0,0 +1,441 @@
+/**
+ * The LinkPredictor class scores every actor two hops
+ * away from the query actor by the movies they share
+ * with the query actor's collaborators.
+ *
+ * Instance variables:
+ *  1) sharedMovies - The number of movies each actor
+ *                    shared with the query
+ *
+ *  2) scores - The score of each candidate
+ *
+ *  3) collaborators - The actors with a nonzero
+ *                     sharedMovies
+ *
+ *  4) candidates - The actors with a nonzero score
+ *
+ *  5) setScores - The ADAMIC_ADAR or JACCARD score
+ *                 of each candidate
+ *
+ *  6) common - The common collaborators of the query
+ *              and one candidate
+ *
+ *  7) movieBuffer - The decoded movies of an actor
+ *
+ *  8) castBuffer - The decoded actors of a movie
+ */
+
+#include "LinkPredictor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "SortedIntersection.hpp"
+
+using namespace std;
+
+/*
+ * This function keeps the best numPrediction
+ * candidates in a heap whose top is the worst of
+ * them, so most candidates are dropped after one
+ * test, and returns them best first.
+ *
+ * Parameters:
+ *  1) candidates - The actors to choose from
+ *  2) scores - The score of each actor
+ *  3) names - The names of the actors, used to
+ *             order equal scores
+ *  4) numPrediction - The most actors to keep
+ *  5) best - Filled with the kept actors
+ *
+ */
+template <typename Score>
+static void keepBest(const vector<unsigned int>& candidates,
+                     const vector<Score>& scores, const NameTable& names,
+                     unsigned int numPrediction, vector<unsigned int>& best) {
+    auto isBetter = [&scores, &names](unsigned int a, unsigned int b) {
+        if (scores[a] != scores[b]) {
+            return scores[a] > scores[b];
+        }
+        return strcmp(names.getName(a), names.getName(b)) < 0;
+    };
+    best.clear();
+    for (unsigned int candidate : candidates) {
+        if (best.size() < numPrediction) {
+            best.push_back(candidate);
+            push_heap(best.begin(), best.end(), isBetter);
+        } else if (numPrediction > 0 && isBetter(candidate, best.front())) {
+            pop_heap(best.begin(), best.end(), isBetter);
+            best.back() = candidate;
+            push_heap(best.begin(), best.end(), isBetter);
+        }
+    }
+    sort_heap(best.begin(), best.end(), isBetter);
+}
+
+/**
+ * The CSRLists class reads the movies of an actor
+ * and the cast of a movie in place from the CSR
+ * arrays.
+ *
+ * Instance variables:
+ *  1) graph - The graph to read
+ */
+class CSRLists {
+  protected:
+    const CSRGraph& graph;
+
+  public:
+    CSRLists(const CSRGraph& graph) : graph(graph) {}
+
+    /* Returns the number of actors in the graph */
+    unsigned int numActors() const { return this->graph.numActors(); }
+
+    /* Points movies at the movies of an actor and returns their number */
+    unsigned int getMovies(unsigned int actorId,
+                           const unsigned int*& movies) const {
+        movies = this->graph.moviesBegin(actorId);
+        return this->graph.moviesEnd(actorId) - movies;
+    }
+
+    /* Points cast at the actors of a movie and returns their number */
+    unsigned int getActors(unsigned int movieId,
+                           const unsigned int*& cast) const {
+        cast = this->graph.actorsBegin(movieId);
+        return this->graph.actorsEnd(movieId) - cast;
+    }
+};
+
+/**
+ * The CompressedLists class decodes the movies of an
+ * actor and the cast of a movie of a compressed graph
+ * into two buffers, so a cast can be decoded while
+ * the movies it came from are still read.
+ *
+ * Instance variables:
+ *  1) graph - The graph to read
+ *
+ *  2) movies - Room for the movies of any actor
+ *
+ *  3) cast - Room for the actors of any movie
+ */
+class CompressedLists {
+  protected:
+    const CompressedGraph& graph;
+    unsigned int* movies;
+    unsigned int* cast;
+
+  public:
+    CompressedLists(const CompressedGraph& graph,
+                    vector<unsigned int>& movieBuffer,
+                    vector<unsigned int>& castBuffer)
+        : graph(graph) {
+        movieBuffer.resize(graph.getMaxMovies());
+        castBuffer.resize(graph.getMaxCast());
+        this->movies = movieBuffer.data();
+        this->cast = castBuffer.data();
+    }
+
+    /* Returns the number of actors in the graph */
+    unsigned int numActors() const { return this->graph.numActors(); }
+
+    /* Points movies at the movies of an actor and returns their number */
+    unsigned int getMovies(unsigned int actorId,
+                           const unsigned int*& movies) const {
+        movies = this->movies;
+        return this->graph.getMovies(actorId, this->movies);
+    }
+
+    /* Points cast at the actors of a movie and returns their number */
+    unsigned int getActors(unsigned int movieId,
+                           const unsigned int*& cast) const {
+        cast = this->cast;
+        return this->graph.getActors(movieId, this->cast);
+    }
+};
+
+/*
+ * The purpose of this method is to find the best
+ * numPrediction new collaborators of an actor,
+ * best first, from the movies of each actor and
+ * the cast of each movie.
+ *
+ * Parameters:
+ *  1) lists - Reads the movies of an actor and the
+ *             cast of a movie, a CSRLists or a
+ *             CompressedLists
+ *  2) names - The names of the actors, used to
+ *             order equal scores
+ *  3) queryId - The actor to predict links for
+ *  4) numPrediction - The most actors to return
+ *  5) predictionIds - Filled with the predictions
+ *
+ */
+template <typename Lists>
+void LinkPredictor::predictFromLists(const Lists& lists,
+                                     const NameTable& names,
+                                     unsigned int queryId,
+                                     unsigned int numPrediction,
+                                     vector<unsigned int>& predictionIds) {
+    predictionIds.clear();
+    if (this->sharedMovies.size() < lists.numActors()) {
+        this->sharedMovies.resize(lists.numActors(), 0);
+        this->scores.resize(lists.numActors(), 0);
+    }
+    const unsigned int* movies;
+    const unsigned int* cast;
+
+    // Count the movies the query shares with each collaborator
+    unsigned int numMovies = lists.getMovies(queryId, movies);
+    for (unsigned int i = 0; i < numMovies; i++) {
+        unsigned int castSize = lists.getActors(movies[i], cast);
+        for (unsigned int j = 0; j < castSize; j++) {
+            if (cast[j] != queryId && this->sharedMovies[cast[j]]++ == 0) {
+                this->collaborators.push_back(cast[j]);
+            }
+        }
+    }
+
+    // Every movie a collaborator shares with a candidate adds the
+    // weight of the collaborator's link to the query
+    for (unsigned int collaborator : this->collaborators) {
+        uint64_t weight = this->sharedMovies[collaborator];
+        numMovies = lists.getMovies(collaborator, movies);
+        for (unsigned int i = 0; i < numMovies; i++) {
+            unsigned int castSize = lists.getActors(movies[i], cast);
+            for (unsigned int j = 0; j < castSize; j++) {
+                unsigned int actor = cast[j];
+                if (actor == queryId || this->sharedMovies[actor] != 0) {
+                    continue;
+                }
+                if (this->scores[actor] == 0) {
+                    this->candidates.push_back(actor);
+                }
+                this->scores[actor] += weight;
+            }
+        }
+    }
+
+    keepBest(this->candidates, this->scores, names, numPrediction,
+             predictionIds);
+
+    // Leave the scratch arrays zeroed for the next query
+    for (unsigned int candidate : this->candidates) {
+        this->scores[candidate] = 0;
+    }
+    for (unsigned int collaborator : this->collaborators) {
+        this->sharedMovies[collaborator] = 0;
+    }
+    this->candidates.clear();
+    this->collaborators.clear();
+}
+
+/*
+ * The purpose of this method is to find the best
+ * numPrediction new collaborators of an actor,
+ * best first.
+ *
+ * Parameters:
+ *  1) graph - The graph to search
+ *  2) names - The names of the actors, used to
+ *             order equal scores
+ *  3) queryId - The actor to predict links for
+ *  4) numPrediction - The most actors to return
+ *  5) predictionIds - Filled with the predictions
+ *
+ */
+void LinkPredictor::predict(const CSRGraph& graph, const NameTable& names,
+                            unsigned int queryId, unsigned int numPrediction,
+                            vector<unsigned int>& predictionIds) {
+    this->predictFromLists(CSRLists(graph), names, queryId, numPrediction,
+                           predictionIds);
+}
+
+/*
+ * The purpose of this method is to find the best
+ * numPrediction new collaborators of an actor,
+ * best first, decoding the lists of a compressed
+ * copy of the graph.
+ *
+ * Parameters:
+ *  1) graph - The compressed graph to search
+ *  2) names - The names of the actors, used to
+ *             order equal scores
+ *  3) queryId - The actor to predict links for
+ *  4) numPrediction - The most actors to return
+ *  5) predictionIds - Filled with the predictions
+ *
+ */
+void LinkPredictor::predict(const CompressedGraph& graph,
+                            const NameTable& names, unsigned int queryId,
+                            unsigned int numPrediction,
+                            vector<unsigned int>& predictionIds) {
+    CompressedLists lists(graph, this->movieBuffer, this->castBuffer);
+    this->predictFromLists(lists, names, queryId, numPrediction,
+                           predictionIds);
+}
+
+/*
+ * The purpose of this method is to find the best
+ * numPrediction new collaborators of an actor,
+ * best first, reading the shared movie counts from
+ * the links of the collaborator graph.
+ *
+ * Parameters:
+ *  1) graph - The collaborators of every actor
+ *  2) names - The names of the actors, used to
+ *             order equal scores
+ *  3) queryId - The actor to predict links for
+ *  4) numPrediction - The most actors to return
+ *  5) predictionIds - Filled with the predictions
+ *
+ */
+void LinkPredictor::predict(const CollaboratorGraph& graph,
+                            const NameTable& names, unsigned int queryId,
+                            unsigned int numPrediction,
+                            vector<unsigned int>& predictionIds) {
+    predictionIds.clear();
+    if (this->sharedMovies.size() < graph.numActors()) {
+        this->sharedMovies.resize(graph.numActors(), 0);
+        this->scores.resize(graph.numActors(), 0);
+    }
+
+    // The links of the query are its collaborators
+    const Collaboration* link = graph.collaborationsBegin(queryId);
+    for (auto actor = graph.begin(queryId); actor != graph.end(queryId);
+         actor++, link++) {
+        this->sharedMovies[*actor] = link->sharedMovies;
+        this->collaborators.push_back(*actor);
+    }
+
+    // Each link of a collaborator to a candidate adds the movies they
+    // shared times the weight of the collaborator's link to the query
+    for (unsigned int collaborator : this->collaborators) {
+        uint64_t weight = this->sharedMovies[collaborator];
+        link = graph.collaborationsBegin(collaborator);
+        for (auto actor = graph.begin(collaborator);
+             actor != graph.end(collaborator); actor++, link++) {
+            if (*actor == queryId || this->sharedMovies[*actor] != 0) {
+                continue;
+            }
+            if (this->scores[*actor] == 0) {
+                this->candidates.push_back(*actor);
+            }
+            this->scores[*actor] += weight * link->sharedMovies;
+        }
+    }
+
+    keepBest(this->candidates, this->scores, names, numPrediction,
+             predictionIds);
+
+    // Leave the scratch arrays zeroed for the next query
+    for (unsigned int candidate : this->candidates) {
+        this->scores[candidate] = 0;
+    }
+    for (unsigned int collaborator : this->collaborators) {
+        this->sharedMovies[collaborator] = 0;
+    }
+    this->candidates.clear();
+    this->collaborators.clear();
+}
+
+/*
+ * The purpose of this method is to find the best
+ * numPrediction new collaborators of an actor by
+ * the ADAMIC_ADAR or JACCARD score, best first.
+ *
+ * Parameters:
+ *  1) graph - The collaborators of every actor
+ *  2) names - The names of the actors, used to
+ *             order equal scores
+ *  3) queryId - The actor to predict links for
+ *  4) score - ADAMIC_ADAR or JACCARD
+ *  5) numPrediction - The most actors to return
+ *  6) predictionIds - Filled with the predictions
+ *
+ */
+void LinkPredictor::predictBySets(const CollaboratorGraph& graph,
+                                  const NameTable& names,
+                                  unsigned int queryId, LinkScore score,
+                                  unsigned int numPrediction,
+                                  vector<unsigned int>& predictionIds) {
+    predictionIds.clear();
+    if (this->sharedMovies.size() < graph.numActors()) {
+        this->sharedMovies.resize(graph.numActors(), 0);
+        this->scores.resize(graph.numActors(), 0);
+    }
+    if (this->setScores.size() < graph.numActors()) {
+        this->setScores.resize(graph.numActors(), 0);
+    }
+    const unsigned int* queryBegin = graph.begin(queryId);
+    unsigned int queryDegree = graph.degree(queryId);
+    this->common.resize(queryDegree);
+
+    // The candidates are the collaborators of collaborators who are
+    // neither the query nor one of its collaborators
+    for (auto actor = queryBegin; actor != graph.end(queryId); actor++) {
+        this->sharedMovies[*actor] = 1;
+    }
+    this->sharedMovies[queryId] = 1;
+    for (auto collaborator = queryBegin; collaborator != graph.end(queryId);
+         collaborator++) {
+        for (auto actor = graph.begin(*collaborator);
+             actor != graph.end(*collaborator); actor++) {
+            if (this->sharedMovies[*actor] == 0 && this->scores[*actor] == 0) {
+                this->scores[*actor] = 1;
+                this->candidates.push_back(*actor);
+            }
+        }
+    }
+
+    // Intersecting the sorted collaborators is where the time goes
+    for (unsigned int candidate : this->candidates) {
+        unsigned int candidateDegree = graph.degree(candidate);
+        if (score == JACCARD) {
+            size_t numCommon =
+                intersectSorted(queryBegin, queryDegree, graph.begin(candidate),
+                                candidateDegree, nullptr);
+            this->setScores[candidate] =
+                (double)numCommon /
+                (queryDegree + candidateDegree - numCommon);
+        } else {
+            size_t numCommon = intersectSorted(
+                queryBegin, queryDegree, graph.begin(candidate),
+                candidateDegree, this->common.data());
+            // A common collaborator knows both actors, so its log is > 0
+            double sum = 0;
+            for (size_t i = 0; i < numCommon; i++) {
+                sum += 1 / log((double)graph.degree(this->common[i]));
+            }
+            this->setScores[candidate] = sum;
+        }
+    }
+
+    keepBest(this->candidates, this->setScores, names, numPrediction,
+             predictionIds);
+
+    // Leave the scratch arrays zeroed for the next query
+    for (unsigned int candidate : this->candidates) {
+        this->scores[candidate] = 0;
+        this->setScores[candidate] = 0;
+    }
+    for (auto actor = queryBegin; actor != graph.end(queryId); actor++) {
+        this->sharedMovies[*actor] = 0;
+    }
+    this->sharedMovies[queryId] = 0;
+    this->candidates.clear();
+}
+
+/*
+ * The purpose of this method is to return the
+ * predictor owned by the calling thread, so that
+ * queries on different threads do not share
+ * scratch arrays.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+LinkPredictor& LinkPredictor::forThread() {
+    static thread_local LinkPredictor predictor;
+    return predictor;
+}
@@ -0,0 +1,199 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Description of File:
+ *  This file defines the link predictor. It ranks the
+ *  actors who have not worked with a query actor yet
+ *  by how much they have worked with the query actor's
+ *  collaborators, or by how much their collaborators
+ *  overlap with the query actor's.
+ */
+
+#ifndef LINKPREDICTOR_HPP
+#define LINKPREDICTOR_HPP
+
+#include <cstdint>
+#include <vector>
+#include "CSRGraph.hpp"
+#include "CompressedGraph.hpp"
+#include "CollaboratorGraph.hpp"
+#include "NameTable.hpp"
+
+using namespace std;
+
+/* The ways a candidate can be scored against the query actor */
+enum LinkScore {
+    // Sum over common collaborators z of movies(q, z) * movies(z, c)
+    COMMON_NEIGHBORS,
+    // Sum over common collaborators z of 1 / log(collaborators of z)
+    ADAMIC_ADAR,
+    // Common collaborators / collaborators of either actor
+    JACCARD
+};
+
+/**
+ * The LinkPredictor class scores every actor two hops
+ * away from the query actor. For COMMON_NEIGHBORS each
+ * collaborator of the query adds, for every candidate
+ * it worked with, (movies it shared with the query) *
+ * (movies it shared with the candidate). The other
+ * scores intersect the sorted collaborators of the
+ * query with those of every candidate. The best
+ * scores win, and equal scores are ordered by name.
+ *
+ * The scores are summed in dense arrays indexed by
+ * actor id, which stay allocated between queries and
+ * are cleared through the lists of touched actors.
+ *
+ * Instance variables:
+ *  1) sharedMovies - The number of movies each actor
+ *                    shared with the query, 0 for
+ *                    actors who are not collaborators
+ *
+ *  2) scores - The score of each candidate
+ *
+ *  3) collaborators - The actors with a nonzero
+ *                     sharedMovies
+ *
+ *  4) candidates - The actors with a nonzero score
+ *
+ *  5) setScores - The ADAMIC_ADAR or JACCARD score
+ *                 of each candidate
+ *
+ *  6) common - The common collaborators of the query
+ *              and one candidate
+ *
+ *  7) movieBuffer - The decoded movies of an actor of
+ *                   a compressed graph
+ *
+ *  8) castBuffer - The decoded actors of a movie of a
+ *                  compressed graph
+ */
+class LinkPredictor {
+  protected:
+    vector<unsigned int> sharedMovies;
+    vector<uint64_t> scores;
+    vector<unsigned int> collaborators;
+    vector<unsigned int> candidates;
+    vector<double> setScores;
+    vector<unsigned int> common;
+    vector<unsigned int> movieBuffer;
+    vector<unsigned int> castBuffer;
+
+    /*
+     * The purpose of this method is to find the best
+     * numPrediction new collaborators of an actor,
+     * best first, from the movies of each actor and
+     * the cast of each movie.
+     *
+     * Parameters:
+     *  1) lists - Reads the movies of an actor and the
+     *             cast of a movie, however the graph
+     *             stores them
+     *  2) names - The names of the actors, used to
+     *             order equal scores
+     *  3) queryId - The actor to predict links for
+     *  4) numPrediction - The most actors to return
+     *  5) predictionIds - Filled with the predictions
+     *
+     */
+    template <typename Lists>
+    void predictFromLists(const Lists& lists, const NameTable& names,
+                          unsigned int queryId, unsigned int numPrediction,
+                          vector<unsigned int>& predictionIds);
+
+  public:
+    /*
+     * The purpose of this method is to find the best
+     * numPrediction new collaborators of an actor,
+     * best first.
+     *
+     * Parameters:
+     *  1) graph - The graph to search
+     *  2) names - The names of the actors, used to
+     *             order equal scores
+     *  3) queryId - The actor to predict links for
+     *  4) numPrediction - The most actors to return
+     *  5) predictionIds - Filled with the predictions
+     *
+     */
+    void predict(const CSRGraph& graph, const NameTable& names,
+                 unsigned int queryId, unsigned int numPrediction,
+                 vector<unsigned int>& predictionIds);
+
+    /*
+     * The purpose of this method is to find the best
+     * numPrediction new collaborators of an actor,
+     * best first, like predict on the actor/movie
+     * graph but decoding the lists of a compressed
+     * copy of it.
+     *
+     * Parameters:
+     *  1) graph - The compressed graph to search
+     *  2) names - The names of the actors, used to
+     *             order equal scores
+     *  3) queryId - The actor to predict links for
+     *  4) numPrediction - The most actors to return
+     *  5) predictionIds - Filled with the predictions
+     *
+     */
+    void predict(const CompressedGraph& graph, const NameTable& names,
+                 unsigned int queryId, unsigned int numPrediction,
+                 vector<unsigned int>& predictionIds);
+
+    /*
+     * The purpose of this method is to find the best
+     * numPrediction new collaborators of an actor,
+     * best first, like predict on the actor/movie
+     * graph but reading the shared movie counts from
+     * the links of the collaborator graph.
+     *
+     * Parameters:
+     *  1) graph - The collaborators of every actor
+     *  2) names - The names of the actors, used to
+     *             order equal scores
+     *  3) queryId - The actor to predict links for
+     *  4) numPrediction - The most actors to return
+     *  5) predictionIds - Filled with the predictions
+     *
+     */
+    void predict(const CollaboratorGraph& graph, const NameTable& names,
+                 unsigned int queryId, unsigned int numPrediction,
+                 vector<unsigned int>& predictionIds);
+
+    /*
+     * The purpose of this method is to find the best
+     * numPrediction new collaborators of an actor by
+     * the ADAMIC_ADAR or JACCARD score, best first.
+     *
+     * Parameters:
+     *  1) graph - The collaborators of every actor
+     *  2) names - The names of the actors, used to
+     *             order equal scores
+     *  3) queryId - The actor to predict links for
+     *  4) score - ADAMIC_ADAR or JACCARD
+     *  5) numPrediction - The most actors to return
+     *  6) predictionIds - Filled with the predictions
+     *
+     */
+    void predictBySets(const CollaboratorGraph& graph, const NameTable& names,
+                       unsigned int queryId, LinkScore score,
+                       unsigned int numPrediction,
+                       vector<unsigned int>& predictionIds);
+
+    /*
+     * The purpose of this method is to return the
+     * predictor owned by the calling thread, so that
+     * queries on different threads do not share
+     * scratch arrays.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    static LinkPredictor& forThread();
+};
+
+#endif  // LINKPREDICTOR_HPP
@@ -0,0 +1,167 @@
+/**
+ * The LocalityBenchmark class runs a BFS over the CSR
+ * arrays from each of a set of sources, timed and on
+ * a simulated cache.
+ *
+ * Instance variables:
+ *  1) numSets - The number of sets of the cache
+ *
+ *  2) numWays - The number of lines of each set
+ *
+ *  3) lines - The lines held by each set
+ *
+ *  4) numAccesses - The number of accesses counted
+ *
+ *  5) numMisses - The number of those that missed
+ *
+ *  6) milliseconds - The time the BFSs took
+ */
+
+#include "LocalityBenchmark.hpp"
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+const unsigned int LocalityBenchmark::LINE_SIZE;
+const size_t LocalityBenchmark::DEFAULT_CACHE_SIZE;
+const unsigned int LocalityBenchmark::DEFAULT_WAYS;
+
+// Marks a way of the cache that holds no line
+static const uintptr_t NO_LINE = ~(uintptr_t)0;
+
+/*
+ * This function runs a full BFS from a source,
+ * calling visit with the address of every array
+ * element it reads or writes.
+ *
+ * Parameters:
+ *  1) graph - The graph to search
+ *  2) source - The actor to start from
+ *  3) actorSeen - The marks of the actors, all 0
+ *  4) movieSeen - The marks of the movies, all 0
+ *  5) queue - The queue of the actors to expand
+ *  6) visit - Called with each address
+ *
+ */
+template <typename Visit>
+static void searchFrom(const CSRGraph& graph, unsigned int source,
+                       vector<uint8_t>& actorSeen, vector<uint8_t>& movieSeen,
+                       vector<unsigned int>& queue, const Visit& visit) {
+    const unsigned int* actorOffsets = graph.getActorOffsets();
+    const unsigned int* actorMovies = graph.getActorMovies();
+    const unsigned int* movieOffsets = graph.getMovieOffsets();
+    const unsigned int* movieActors = graph.getMovieActors();
+    queue.clear();
+    queue.push_back(source);
+    actorSeen[source] = 1;
+    for (size_t head = 0; head < queue.size(); head++) {
+        unsigned int current = queue[head];
+        visit(&queue[head]);
+        visit(&actorOffsets[current]);
+        for (unsigned int i = actorOffsets[current];
+             i < actorOffsets[current + 1]; i++) {
+            unsigned int movie = actorMovies[i];
+            visit(&actorMovies[i]);
+            visit(&movieSeen[movie]);
+            if (movieSeen[movie]) {
+                continue;
+            }
+            movieSeen[movie] = 1;
+            visit(&movieOffsets[movie]);
+            for (unsigned int j = movieOffsets[movie];
+                 j < movieOffsets[movie + 1]; j++) {
+                unsigned int actor = movieActors[j];
+                visit(&movieActors[j]);
+                visit(&actorSeen[actor]);
+                if (!actorSeen[actor]) {
+                    actorSeen[actor] = 1;
+                    queue.push_back(actor);
+                    visit(&queue.back());
+                }
+            }
+        }
+    }
+}
+
+/*
+ * This is the contructor method for the benchmark.
+ *
+ * Parameters:
+ *  1) cacheSize - The size of the simulated cache
+ *  2) numWays - The number of lines of each set
+ *
+ */
+LocalityBenchmark::LocalityBenchmark(size_t cacheSize, unsigned int numWays) {
+    this->numWays = numWays;
+    this->numSets = max((size_t)1, cacheSize / LINE_SIZE / numWays);
+    this->numAccesses = 0;
+    this->numMisses = 0;
+    this->milliseconds = 0;
+}
+
+/*
+ * The purpose of this method is to count an
+ * access to an address on the simulated cache.
+ *
+ * Parameters:
+ *  1) address - The address read or written
+ *
+ */
+void LocalityBenchmark::touch(const void* address) {
+    uintptr_t line = (uintptr_t)address / LINE_SIZE;
+    uintptr_t* set =
+        this->lines.data() + (line % this->numSets) * this->numWays;
+    this->numAccesses++;
+    // Find the line, or else evict the least recently used one
+    unsigned int way = 0;
+    while (way + 1 < this->numWays && set[way] != line) {
+        way++;
+    }
+    if (set[way] != line) {
+        this->numMisses++;
+    }
+    for (; way > 0; way--) {
+        set[way] = set[way - 1];
+    }
+    set[0] = line;
+}
+
+/*
+ * The purpose of this method is to run a full BFS
+ * from each source, once timed and once on the
+ * simulated cache.
+ *
+ * Parameters:
+ *  1) graph - The graph to search
+ *  2) sources - The actors to start from
+ *
+ */
+void LocalityBenchmark::run(const CSRGraph& graph,
+                            const vector<unsigned int>& sources) {
+    vector<uint8_t> actorSeen;
+    vector<uint8_t> movieSeen;
+    vector<unsigned int> queue;
+    queue.reserve(graph.numActors());
+
+    auto start = chrono::steady_clock::now();
+    for (unsigned int source : sources) {
+        actorSeen.assign(graph.numActors(), 0);
+        movieSeen.assign(graph.numMovies(), 0);
+        searchFrom(graph, source, actorSeen, movieSeen, queue,
+                   [](const void*) {});
+    }
+    this->milliseconds = chrono::duration<double, milli>(
+                             chrono::steady_clock::now() - start)
+                             .count();
+
+    this->lines.assign(this->numSets * this->numWays, NO_LINE);
+    this->numAccesses = 0;
+    this->numMisses = 0;
+    for (unsigned int source : sources) {
+        actorSeen.assign(graph.numActors(), 0);
+        movieSeen.assign(graph.numMovies(), 0);
+        searchFrom(graph, source, actorSeen, movieSeen, queue,
+                   [this](const void* address) { this->touch(address); });
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Description of File:
+ *  This file defines a benchmark of how well the ids
+ *  of a graph suit a search. It times full BFSs, and
+ *  counts the cache misses of the same BFSs on a
+ *  simulated cache, which works where the hardware
+ *  counters cannot be read.
+ */
+
+#ifndef LOCALITYBENCHMARK_HPP
+#define LOCALITYBENCHMARK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CSRGraph.hpp"
+
+using namespace std;
+
+/**
+ * The LocalityBenchmark class runs a BFS over the CSR
+ * arrays from each of a set of sources. Every array
+ * element the BFS reads or writes goes through a set
+ * associative cache with LRU replacement, which
+ * counts a miss whenever the line is not held.
+ *
+ * Instance variables:
+ *  1) numSets - The number of sets of the cache
+ *
+ *  2) numWays - The number of lines of each set
+ *
+ *  3) lines - The lines held by each set, the most
+ *             recently used first
+ *
+ *  4) numAccesses - The number of accesses counted
+ *
+ *  5) numMisses - The number of those that missed
+ *
+ *  6) milliseconds - The time the BFSs took without
+ *                    the simulated cache
+ */
+class LocalityBenchmark {
+  protected:
+    size_t numSets;
+    unsigned int numWays;
+    vector<uintptr_t> lines;
+    uint64_t numAccesses;
+    uint64_t numMisses;
+    double milliseconds;
+
+    /*
+     * The purpose of this method is to count an
+     * access to an address on the simulated cache.
+     *
+     * Parameters:
+     *  1) address - The address read or written
+     *
+     */
+    void touch(const void* address);
+
+  public:
+    // Size of a cache line in bytes
+    static const unsigned int LINE_SIZE = 64;
+    // Size of the simulated cache in bytes, like a second level cache
+    static const size_t DEFAULT_CACHE_SIZE = 1 << 20;
+    // Number of lines of each set of the simulated cache
+    static const unsigned int DEFAULT_WAYS = 8;
+
+    /*
+     * This is the contructor method for the benchmark.
+     *
+     * Parameters:
+     *  1) cacheSize - The size of the simulated cache
+     *                 in bytes, a power of two
+     *  2) numWays - The number of lines of each set
+     *
+     */
+    LocalityBenchmark(size_t cacheSize = DEFAULT_CACHE_SIZE,
+                      unsigned int numWays = DEFAULT_WAYS);
+
+    /*
+     * The purpose of this method is to run a full BFS
+     * from each source, once timed and once on the
+     * simulated cache, which starts empty.
+     *
+     * Parameters:
+     *  1) graph - The graph to search
+     *  2) sources - The actors to start from
+     *
+     */
+    void run(const CSRGraph& graph, const vector<unsigned int>& sources);
+
+    /* Returns the number of accesses of the last run */
+    uint64_t getNumAccesses() const { return this->numAccesses; }
+
+    /* Returns the number of simulated misses of the last run */
+    uint64_t getNumMisses() const { return this->numMisses; }
+
+    /* Returns the time the BFSs of the last run took */
+    double getMilliseconds() const { return this->milliseconds; }
+};
+
+#endif  // LOCALITYBENCHMARK_HPP
@@ -5,10 +5,12 @@
  * which are connected by this movie edge.
  *
  * Instance variables:
- *  1) movieName - The name of the movie
+ *  1) movieName - The interned name of the movie
  *
  *  2) ofActors - The actors which are
  *                linked by this edge.
+ *
+ *  3) id - The dense id of the movie
  */
 
 #include "MovieNode.hpp"
@@ -22,12 +24,16 @@ using namespace std;
  * instance variables to make a movie node.
  *
  * Parameters:
- *  1) movieName - The name of the movie.
+ *  1) movieName - The interned name of the movie,
+ *                which must outlive the node.
+ *  2) id - The dense id of the movie.
+ *  3) arena - The arena the edges are stored in
  *
  */
-MovieNode::MovieNode(string movieName) {
+MovieNode::MovieNode(const char* movieName, unsigned int id, Arena& arena)
+    : ofActors(ArenaAllocator<ActorNode*>(arena)) {
     this->movieName = movieName;
-    this->ofActors = new vector<ActorNode*>();
+    this->id = id;
 }
 
 /*
@@ -38,7 +44,17 @@ MovieNode::MovieNode(string movieName) {
  *  NONE
  *
  */
-string MovieNode::getMovieName() { return this->movieName; }
+const char* MovieNode::getMovieName() { return this->movieName; }
+
+/*
+ * The purpose of this method is to return
+ * the dense id of the movie node.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+unsigned int MovieNode::getId() { return this->id; }
 
 /*
  * The purpose of this method is to add
@@ -50,7 +66,7 @@ string MovieNode::getMovieName() { return this->movieName; }
  *
  */
 void MovieNode::addActor(ActorNode* ofActor) {
-    this->ofActors->push_back(ofActor);
+    this->ofActors.push_back(ofActor);
 }
 
 /*
@@ -63,18 +79,4 @@ void MovieNode::addActor(ActorNode* ofActor) {
  *  NONE
  *
  */
-vector<ActorNode*>* MovieNode::actorsInMovie() { return this->ofActors; }
-
-/*
- * The purpose of this method is to free up
- * all of the memory used by the movie node
- * in the graph.
- *
- * Parameters:
- *  NONE
- *
- */
-MovieNode::~MovieNode() {
-    this->ofActors->clear();
-    delete this->ofActors;
-}
\ No newline at end of file
+MovieNode::ActorList* MovieNode::actorsInMovie() { return &this->ofActors; }
\ No newline at end of file
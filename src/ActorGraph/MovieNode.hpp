@@ -21,6 +21,7 @@
 
 #include <string>
 #include <vector>
+#include "Arena.hpp"
 
 using namespace std;
 
@@ -33,15 +34,23 @@ class ActorNode;
  * which are connected by this movie edge.
  *
  * Instance variables:
- *  1) movieName - The name of the movie
+ *  1) movieName - The interned name of the movie
  *
  *  2) ofActors - The actors which are
  *                linked by this edge.
+ *
+ *  3) id - The dense id of the movie, used to
+ *          index the frozen CSR graph
  */
 class MovieNode {
+  public:
+    // The edges of a node, stored in the graph's arena
+    typedef vector<ActorNode*, ArenaAllocator<ActorNode*>> ActorList;
+
   protected:
-    string movieName;
-    vector<ActorNode*>* ofActors;
+    const char* movieName;
+    unsigned int id;
+    ActorList ofActors;
 
   public:
     /*
@@ -50,10 +59,13 @@ class MovieNode {
      * instance variables to make a movie node.
      *
      * Parameters:
-     *  1) movieName - The name of the movie.
+     *  1) movieName - The interned name of the movie,
+     *                which must outlive the node.
+     *  2) id - The dense id of the movie.
+     *  3) arena - The arena the edges are stored in
      *
      */
-    MovieNode(string movieName);
+    MovieNode(const char* movieName, unsigned int id, Arena& arena);
 
     /*
      * The purpose of this method is to return
@@ -63,7 +75,17 @@ class MovieNode {
      *  NONE
      *
      */
-    string getMovieName();
+    const char* getMovieName();
+
+    /*
+     * The purpose of this method is to return
+     * the dense id of the movie node.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    unsigned int getId();
 
     /*
      * The purpose of this method is to add
@@ -86,18 +108,7 @@ class MovieNode {
      *  NONE
      *
      */
-    vector<ActorNode*>* actorsInMovie();
-
-    /*
-     * The purpose of this method is to free up
-     * all of the memory used by the movie node
-     * in the graph.
-     *
-     * Parameters:
-     *  NONE
-     *
-     */
-    ~MovieNode();
+    ActorList* actorsInMovie();
 };
 
 #endif  // MOVIENODE_HPP
\ No newline at end of file
@@ -0,0 +1,68 @@
+/**
+ * The MovieYearIndex class stores the movies of each
+ * actor ordered by year, next to their years.
+ *
+ * Instance variables:
+ *  1) offsets - The offsets of the CSR graph
+ *
+ *  2) movies - The movies of every actor, oldest first
+ *
+ *  3) years - The year of each entry of movies
+ */
+
+#include "MovieYearIndex.hpp"
+#include "Parallel.hpp"
+
+using namespace std;
+
+// Number of actors sorted by one task of the build
+static const unsigned int ACTORS_PER_TASK = 4096;
+
+/*
+ * This is the contructor method for the index.
+ * It sorts a copy of the movies of every actor.
+ *
+ * Parameters:
+ *  1) graph - The graph to index, which must
+ *             outlive the index
+ *  2) numThreads - The number of threads to use
+ *
+ */
+MovieYearIndex::MovieYearIndex(const CSRGraph& graph, unsigned int numThreads)
+    : offsets(graph.getActorOffsets()),
+      movies(graph.numEdges()),
+      years(graph.numEdges()) {
+    unsigned int numActors = graph.numActors();
+    size_t numTasks = (numActors + ACTORS_PER_TASK - 1) / ACTORS_PER_TASK;
+    parallelFor(numThreads, numTasks, [&](size_t t) {
+        unsigned int last =
+            min(numActors, (unsigned int)(t + 1) * ACTORS_PER_TASK);
+        for (unsigned int a = t * ACTORS_PER_TASK; a < last; a++) {
+            unsigned int* first = this->movies.data() + this->offsets[a];
+            copy(graph.moviesBegin(a), graph.moviesEnd(a), first);
+            // Movies of the same year keep the order of the graph
+            stable_sort(first, this->movies.data() + this->offsets[a + 1],
+                        [&graph](unsigned int x, unsigned int y) {
+                            return graph.getMovieYear(x) <
+                                   graph.getMovieYear(y);
+                        });
+            for (unsigned int i = this->offsets[a]; i < this->offsets[a + 1];
+                 i++) {
+                this->years[i] = graph.getMovieYear(this->movies[i]);
+            }
+        }
+    });
+}
+
+/*
+ * The purpose of this method is to return the
+ * number of bytes used by the index.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+size_t MovieYearIndex::memoryUsage() const {
+    return sizeof(unsigned int) * this->movies.capacity() +
+           sizeof(int) * this->years.capacity();
+}
@@ -0,0 +1,100 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Description of File:
+ *  This file defines a copy of the movies of every
+ *  actor sorted by year, so that a search limited to
+ *  a range of years finds the movies of an actor in
+ *  that range with two binary searches.
+ */
+
+#ifndef MOVIEYEARINDEX_HPP
+#define MOVIEYEARINDEX_HPP
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+#include "CSRGraph.hpp"
+
+using namespace std;
+
+/* The years from minYear to maxYear, both included */
+struct YearRange {
+    int minYear;
+    int maxYear;
+
+    /* Returns true if the range holds every year */
+    bool isAll() const {
+        return this->minYear == INT_MIN && this->maxYear == INT_MAX;
+    }
+};
+
+// The range of every year
+static const YearRange ALL_YEARS = {INT_MIN, INT_MAX};
+
+/**
+ * The MovieYearIndex class stores the movies of each
+ * actor ordered by year, oldest first, next to their
+ * years. It uses the offsets of the CSR graph, so the
+ * movies of actor a are still found at positions
+ * [actorOffsets[a], actorOffsets[a + 1]).
+ *
+ * Instance variables:
+ *  1) offsets - The offsets of the CSR graph
+ *
+ *  2) movies - The movies of every actor, oldest
+ *              first, stored back to back
+ *
+ *  3) years - The year of each entry of movies
+ */
+class MovieYearIndex {
+  protected:
+    const unsigned int* offsets;
+    vector<unsigned int> movies;
+    vector<int> years;
+
+  public:
+    /*
+     * This is the contructor method for the index.
+     * It sorts a copy of the movies of every actor.
+     *
+     * Parameters:
+     *  1) graph - The graph to index, which must
+     *             outlive the index
+     *  2) numThreads - The number of threads to use
+     *
+     */
+    MovieYearIndex(const CSRGraph& graph, unsigned int numThreads = 1);
+
+    /* Returns a pointer to the first movie of an actor in a range */
+    const unsigned int* moviesBegin(unsigned int actorId,
+                                    const YearRange& range) const {
+        const int* first = this->years.data() + this->offsets[actorId];
+        const int* last = this->years.data() + this->offsets[actorId + 1];
+        return this->movies.data() +
+               (lower_bound(first, last, range.minYear) - this->years.data());
+    }
+
+    /* Returns a pointer one past the last movie of an actor in a range */
+    const unsigned int* moviesEnd(unsigned int actorId,
+                                  const YearRange& range) const {
+        const int* first = this->years.data() + this->offsets[actorId];
+        const int* last = this->years.data() + this->offsets[actorId + 1];
+        return this->movies.data() +
+               (upper_bound(first, last, range.maxYear) - this->years.data());
+    }
+
+    /*
+     * The purpose of this method is to return the
+     * number of bytes used by the index.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    size_t memoryUsage() const;
+};
+
+#endif  // MOVIEYEARINDEX_HPP
@@ -0,0 +1,267 @@
+/**
+ * The MultiSourceBFS class grows the BFS trees of a
+ * batch of sources level by level. Bit i of a mask is
+ * source i of the batch.
+ *
+ * Instance variables:
+ *  1) graph - The CSR graph to search
+ *
+ *  2) seen - The sources that have reached each actor
+ *
+ *  3) movieSeen - The sources that have visited each movie
+ *
+ *  4) next - The sources reaching each actor on the
+ *            level being built
+ *
+ *  5) movieNext - The sources reaching each movie on
+ *                 the level being built
+ *
+ *  6) levelActors - The actors reached on each level
+ *
+ *  7) levelMasks - The sources of each actor of each
+ *                  level
+ */
+
+#include "MultiSourceBFS.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+using namespace std;
+
+const unsigned int MultiSourceBFS::MAX_SOURCES;
+
+/*
+ * This is the contructor method for the search.
+ *
+ * Parameters:
+ *  1) graph - The CSR graph to search, which
+ *             must outlive the search
+ *
+ */
+MultiSourceBFS::MultiSourceBFS(const CSRGraph* graph)
+    : graph(graph),
+      seen(graph->numActors(), 0),
+      movieSeen(graph->numMovies(), 0),
+      next(graph->numActors(), 0),
+      movieNext(graph->numMovies(), 0) {}
+
+/*
+ * This method forgets the previous batch by
+ * clearing only the entries it set.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+void MultiSourceBFS::clear() {
+    for (size_t level = 0; level < this->levelActors.size(); level++) {
+        for (unsigned int actor : this->levelActors[level]) {
+            this->seen[actor] = 0;
+            // Every movie seen was reached from some reached actor
+            for (auto movie = this->graph->moviesBegin(actor);
+                 movie != this->graph->moviesEnd(actor); movie++) {
+                this->movieSeen[*movie] = 0;
+            }
+        }
+        this->levelActors[level].clear();
+        this->levelMasks[level].clear();
+    }
+}
+
+/*
+ * This method moves the masks of the actors of a
+ * level out of next, sorted by actor, and marks
+ * the actors seen by their sources.
+ *
+ * Parameters:
+ *  1) level - The level whose actors were reached
+ *
+ */
+void MultiSourceBFS::sealLevel(size_t level) {
+    vector<unsigned int>& actors = this->levelActors[level];
+    vector<uint64_t>& masks = this->levelMasks[level];
+    sort(actors.begin(), actors.end());
+    masks.resize(actors.size());
+    for (size_t k = 0; k < actors.size(); k++) {
+        masks[k] = this->next[actors[k]];
+        this->seen[actors[k]] |= masks[k];
+        this->next[actors[k]] = 0;
+    }
+}
+
+/*
+ * The purpose of this method is to return the
+ * sources at some distance from an actor, found
+ * by a binary search of the level.
+ *
+ * Parameters:
+ *  1) level - The distance from the sources
+ *  2) actorId - The actor to look up
+ *
+ */
+uint64_t MultiSourceBFS::levelMask(size_t level, unsigned int actorId) const {
+    const vector<unsigned int>& actors = this->levelActors[level];
+    auto actor = lower_bound(actors.begin(), actors.end(), actorId);
+    if (actor == actors.end() || *actor != actorId) {
+        return 0;
+    }
+    return this->levelMasks[level][actor - actors.begin()];
+}
+
+/*
+ * This method runs the BFS of every source at
+ * once. It stops as soon as every target has
+ * been reached by its source, or when no source
+ * can reach any new actor.
+ *
+ * Parameters:
+ *  1) sources - The actor id of each source,
+ *               at most MAX_SOURCES of them
+ *  2) queries - Pairs of (index into sources,
+ *               target actor id) to answer
+ *
+ */
+void MultiSourceBFS::run(
+    const vector<unsigned int>& sources,
+    const vector<pair<unsigned int, unsigned int>>& queries) {
+    this->clear();
+
+    // The sources each target is waiting for
+    unordered_map<unsigned int, uint64_t> targets;
+    for (auto& query : queries) {
+        targets[query.second] |= uint64_t(1) << query.first;
+    }
+
+    // Level 0 is every source reaching itself
+    if (this->levelActors.empty()) {
+        this->levelActors.push_back(vector<unsigned int>());
+        this->levelMasks.push_back(vector<uint64_t>());
+    }
+    for (unsigned int i = 0; i < sources.size(); i++) {
+        if (this->next[sources[i]] == 0) {
+            this->levelActors[0].push_back(sources[i]);
+        }
+        this->next[sources[i]] |= uint64_t(1) << i;
+    }
+    this->sealLevel(0);
+
+    vector<unsigned int> touchedMovies;
+    for (size_t level = 0; !this->levelActors[level].empty(); level++) {
+        // Stop once every target has been reached by all of its sources
+        bool done = true;
+        for (auto& target : targets) {
+            if ((this->seen[target.first] & target.second) != target.second) {
+                done = false;
+                break;
+            }
+        }
+        if (done) {
+            break;
+        }
+
+        // Only the actors of a level are kept, so a batch needs memory
+        // for the actors it reaches, not for every actor on every level
+        if (this->levelActors.size() == level + 1) {
+            this->levelActors.push_back(vector<unsigned int>());
+            this->levelMasks.push_back(vector<uint64_t>());
+        }
+        const vector<unsigned int>& frontier = this->levelActors[level];
+        const vector<uint64_t>& frontierMasks = this->levelMasks[level];
+        vector<unsigned int>& reachedActors = this->levelActors[level + 1];
+
+        // Push the frontier's sources onto its movies
+        touchedMovies.clear();
+        for (size_t k = 0; k < frontier.size(); k++) {
+            unsigned int actor = frontier[k];
+            uint64_t sourceBits = frontierMasks[k];
+            for (auto movie = this->graph->moviesBegin(actor);
+                 movie != this->graph->moviesEnd(actor); movie++) {
+                if (this->movieNext[*movie] == 0) {
+                    touchedMovies.push_back(*movie);
+                }
+                this->movieNext[*movie] |= sourceBits;
+            }
+        }
+
+        // Each movie passes on only the sources that had not visited it
+        for (unsigned int movie : touchedMovies) {
+            uint64_t newBits =
+                this->movieNext[movie] & ~this->movieSeen[movie];
+            this->movieNext[movie] = 0;
+            if (newBits == 0) {
+                continue;
+            }
+            this->movieSeen[movie] |= newBits;
+            for (auto actor = this->graph->actorsBegin(movie);
+                 actor != this->graph->actorsEnd(movie); actor++) {
+                uint64_t actorBits = newBits & ~this->seen[*actor];
+                if (actorBits == 0) {
+                    continue;
+                }
+                if (this->next[*actor] == 0) {
+                    reachedActors.push_back(*actor);
+                }
+                this->next[*actor] |= actorBits;
+            }
+        }
+
+        this->sealLevel(level + 1);
+    }
+}
+
+/*
+ * This method walks a shortest path from a source
+ * of the last batch to an actor it reached. Among
+ * equally short paths it keeps the first movie and
+ * actor in adjacency order at every step, so the
+ * path does not depend on the rest of the batch.
+ * Returns false if the source did not reach it.
+ *
+ * Parameters:
+ *  1) sourceIndex - The index of the source in
+ *                   the last batch
+ *  2) toId - The actor the path ends at
+ *  3) actorIds - Filled with the actors on the path
+ *  4) movieIds - Filled with the movies between them
+ *
+ */
+bool MultiSourceBFS::getPath(unsigned int sourceIndex, unsigned int toId,
+                             vector<unsigned int>& actorIds,
+                             vector<unsigned int>& movieIds) const {
+    actorIds.clear();
+    movieIds.clear();
+    uint64_t bit = uint64_t(1) << sourceIndex;
+    if ((this->seen[toId] & bit) == 0) {
+        return false;
+    }
+    // Find the level the target was reached on
+    size_t level = 0;
+    while ((this->levelMask(level, toId) & bit) == 0) {
+        level++;
+    }
+    // Step back to any co-star one level closer to the source
+    unsigned int current = toId;
+    actorIds.push_back(current);
+    while (level > 0) {
+        level--;
+        bool stepped = false;
+        for (auto movie = this->graph->moviesBegin(current);
+             !stepped && movie != this->graph->moviesEnd(current); movie++) {
+            for (auto actor = this->graph->actorsBegin(*movie);
+                 actor != this->graph->actorsEnd(*movie); actor++) {
+                // Most co-stars are ruled out without a search
+                if ((this->seen[*actor] & bit) &&
+                    (this->levelMask(level, *actor) & bit)) {
+                    movieIds.push_back(*movie);
+                    current = *actor;
+                    stepped = true;
+                    break;
+                }
+            }
+        }
+        actorIds.push_back(current);
+    }
+    reverse(actorIds.begin(), actorIds.end());
+    reverse(movieIds.begin(), movieIds.end());
+    return true;
+}
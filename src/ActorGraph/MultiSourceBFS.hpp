@@ -0,0 +1,148 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Sources used:
+ *  1) Then et al., "The More the Merrier: Efficient
+ *     Multi-Source Graph Traversal", VLDB 2015
+ *
+ * Description of File:
+ *  This file defines a BFS that runs from up to 64
+ *  sources at once over the CSR graph. Each actor
+ *  and movie keeps one bit per source, so a single
+ *  pass over an edge serves every source that
+ *  reaches it on the same level.
+ */
+
+#ifndef MULTISOURCEBFS_HPP
+#define MULTISOURCEBFS_HPP
+
+#include <cstdint>
+#include <vector>
+#include "CSRGraph.hpp"
+
+using namespace std;
+
+/**
+ * The MultiSourceBFS class grows the BFS trees of a
+ * batch of sources level by level. Bit i of a mask is
+ * source i of the batch. Instead of a parent per
+ * source, it remembers which sources first reached
+ * each actor on each level, which is enough to walk
+ * a shortest path back from any reached target.
+ *
+ * Instance variables:
+ *  1) graph - The CSR graph to search
+ *
+ *  2) seen - The sources that have reached each actor
+ *
+ *  3) movieSeen - The sources that have visited each movie
+ *
+ *  4) next - The sources reaching each actor on the
+ *            level being built
+ *
+ *  5) movieNext - The sources reaching each movie on
+ *                 the level being built
+ *
+ *  6) levelActors - The actors reached on each level,
+ *                   ascending
+ *
+ *  7) levelMasks - levelMasks[L][k] are the sources at
+ *                  distance L from levelActors[L][k]
+ */
+class MultiSourceBFS {
+  protected:
+    const CSRGraph* graph;
+    vector<uint64_t> seen;
+    vector<uint64_t> movieSeen;
+    vector<uint64_t> next;
+    vector<uint64_t> movieNext;
+    vector<vector<unsigned int>> levelActors;
+    vector<vector<uint64_t>> levelMasks;
+
+    /*
+     * This method forgets the previous batch by
+     * clearing only the entries it set.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    void clear();
+
+    /*
+     * This method moves the masks of the actors of a
+     * level out of next, sorted by actor, and marks
+     * the actors seen by their sources.
+     *
+     * Parameters:
+     *  1) level - The level whose actors were reached
+     *
+     */
+    void sealLevel(size_t level);
+
+    /*
+     * The purpose of this method is to return the
+     * sources at some distance from an actor, found
+     * by a binary search of the level.
+     *
+     * Parameters:
+     *  1) level - The distance from the sources
+     *  2) actorId - The actor to look up
+     *
+     */
+    uint64_t levelMask(size_t level, unsigned int actorId) const;
+
+  public:
+    // Largest number of sources in one batch
+    static const unsigned int MAX_SOURCES = 64;
+
+    /*
+     * This is the contructor method for the search.
+     *
+     * Parameters:
+     *  1) graph - The CSR graph to search, which
+     *             must outlive the search
+     *
+     */
+    explicit MultiSourceBFS(const CSRGraph* graph);
+
+    /*
+     * This method runs the BFS of every source at
+     * once. It stops as soon as every target has
+     * been reached by its source, or when no source
+     * can reach any new actor.
+     *
+     * Parameters:
+     *  1) sources - The actor id of each source,
+     *               at most MAX_SOURCES of them
+     *  2) queries - Pairs of (index into sources,
+     *               target actor id) to answer
+     *
+     */
+    void run(const vector<unsigned int>& sources,
+             const vector<pair<unsigned int, unsigned int>>& queries);
+
+    /*
+     * This method walks a shortest path from a source
+     * of the last batch to an actor it reached. Among
+     * equally short paths it keeps the first movie and
+     * actor in adjacency order at every step, so the
+     * path does not depend on the rest of the batch.
+     * Returns false if the source did not reach it.
+     *
+     * Parameters:
+     *  1) sourceIndex - The index of the source in
+     *                   the last batch
+     *  2) toId - The actor the path ends at
+     *  3) actorIds - Filled with the actors on the path
+     *  4) movieIds - Filled with the movies between them
+     *
+     */
+    bool getPath(unsigned int sourceIndex, unsigned int toId,
+                 vector<unsigned int>& actorIds,
+                 vector<unsigned int>& movieIds) const;
+};
+
+#endif  // MULTISOURCEBFS_HPP
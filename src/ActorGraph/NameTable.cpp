@@ -0,0 +1,222 @@
+/**
+ * The NameTable class assigns ids 0, 1, 2, ... to
+ * names in the order they are first interned.
+ *
+ * Instance variables:
+ *  1) parts - The hashtables from a name to its id
+ *
+ *  2) names - Pointers to the keys of the hashtables,
+ *             indexed by id
+ *
+ *  3) mappedChars - The names of a mapped table
+ *
+ *  4) mappedOffsets - The start of each mapped name
+ *
+ *  5) mappedSlots - The index of a mapped table
+ *
+ *  6) mappedCount - The number of names of a mapped table
+ *
+ *  7) mappedSlotMask - The number of slots minus one
+ */
+
+#include "NameTable.hpp"
+#include <cstring>
+#include <utility>
+
+using namespace std;
+
+const unsigned int NameTable::NO_ID;
+
+/*
+ * This is the contructor method for the table.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+NameTable::NameTable()
+    : parts(1),
+      mappedChars(nullptr),
+      mappedOffsets(nullptr),
+      mappedSlots(nullptr),
+      mappedCount(0),
+      mappedSlotMask(0) {}
+
+/*
+ * The purpose of this method is to return the
+ * id of a name, adding the name to the table
+ * with the next free id if it is new.
+ *
+ * Parameters:
+ *  1) name - The name to intern
+ *
+ */
+unsigned int NameTable::intern(const string& name) {
+    // A mapped table is read only, so copy it out first
+    if (this->mappedChars != nullptr) {
+        this->unmap();
+    }
+    unordered_map<string, unsigned int>& part = this->parts[partOf(name)];
+    // Names seen before are found without copying the string
+    auto entry = part.find(name);
+    if (entry != part.end()) {
+        return entry->second;
+    }
+    // The keys of the hashtable never move, so we can point at them
+    entry = part.insert(make_pair(name, this->size())).first;
+    this->names.push_back(&entry->first);
+    return entry->second;
+}
+
+/*
+ * The purpose of this method is to return the
+ * id of a name, or NO_ID if it was never interned.
+ *
+ * Parameters:
+ *  1) name - The name to look up
+ *
+ */
+unsigned int NameTable::find(const string& name) const {
+    if (this->mappedChars != nullptr) {
+        // Probe from the name's slot until it or an empty slot is found
+        uint64_t slot = hashName(name.data(), name.size());
+        for (;; slot++) {
+            unsigned int id = this->mappedSlots[slot & this->mappedSlotMask];
+            if (id == NO_ID) {
+                return NO_ID;
+            }
+            const char* candidate = this->getName(id);
+            size_t length = this->mappedOffsets[id + 1] -
+                            this->mappedOffsets[id] - 1;
+            if (length == name.size() &&
+                memcmp(candidate, name.data(), length) == 0) {
+                return id;
+            }
+        }
+    }
+    const unordered_map<string, unsigned int>& part =
+        this->parts[partOf(name)];
+    auto entry = part.find(name);
+    if (entry == part.end()) {
+        return NO_ID;
+    }
+    return entry->second;
+}
+
+/*
+ * The purpose of this method is to reserve room
+ * for a number of names ahead of time.
+ *
+ * Parameters:
+ *  1) count - The number of names expected
+ *
+ */
+void NameTable::reserve(size_t count) {
+    for (unsigned int p = 0; p < this->parts.size(); p++) {
+        this->parts[p].reserve(count / this->parts.size() + 1);
+    }
+    this->names.reserve(count);
+}
+
+/*
+ * The purpose of this method is to empty the
+ * table and make room for the names of a table
+ * built part by part. Every part must then be
+ * handed over with adoptPart.
+ *
+ * Parameters:
+ *  1) numParts - The number of parts, which decides
+ *                the part of each name (see partOf)
+ *  2) count - The total number of names
+ *
+ */
+void NameTable::prepareAdoption(unsigned int numParts, unsigned int count) {
+    this->mappedChars = nullptr;
+    this->mappedCount = 0;
+    this->parts.clear();
+    this->parts.resize(numParts);
+    this->names.assign(count, nullptr);
+}
+
+/*
+ * The purpose of this method is to take over the
+ * names of one part. Each name must belong to that
+ * part and already map to its final id. Different
+ * parts may be adopted by different threads at once.
+ *
+ * Parameters:
+ *  1) part - The part being handed over
+ *  2) partIds - The names of the part and their ids,
+ *               left empty by this method
+ *
+ */
+void NameTable::adoptPart(unsigned int part,
+                          unordered_map<string, unsigned int>& partIds) {
+    // Swapping keeps every key where it is in memory
+    this->parts[part].swap(partIds);
+    partIds.clear();
+    for (auto& entry : this->parts[part]) {
+        this->names[entry.second] = &entry.first;
+    }
+}
+
+/*
+ * The purpose of this method is to turn the table
+ * into a read only view of names stored elsewhere,
+ * such as in a snapshot. Nothing is copied, so the
+ * storage must outlive the table.
+ *
+ * Parameters:
+ *  1) chars - The names, each ended by a '\0'
+ *  2) offsets - The start of each name in chars,
+ *                followed by the size of chars
+ *  3) count - The number of names
+ *  4) slots - The index: a power of two number of
+ *             slots holding ids or NO_ID, where a
+ *             name is in the first free slot from
+ *             its hashName onward
+ *  5) numSlots - The number of slots
+ *
+ */
+void NameTable::map(const char* chars, const uint64_t* offsets,
+                    unsigned int count, const unsigned int* slots,
+                    unsigned int numSlots) {
+    // The hashtable stays, empty, for unmap to fill
+    this->parts.assign(1, unordered_map<string, unsigned int>());
+    this->names.clear();
+    this->mappedChars = chars;
+    this->mappedOffsets = offsets;
+    this->mappedSlots = slots;
+    this->mappedCount = count;
+    this->mappedSlotMask = numSlots - 1;
+}
+
+/*
+ * The purpose of this method is to copy the names
+ * of a mapped table into a hashtable of its own,
+ * with the same ids, so that new names can be
+ * interned. The mapped storage is no longer used.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+void NameTable::unmap() {
+    const char* chars = this->mappedChars;
+    const uint64_t* offsets = this->mappedOffsets;
+    unsigned int count = this->mappedCount;
+    this->mappedChars = nullptr;
+    this->mappedOffsets = nullptr;
+    this->mappedSlots = nullptr;
+    this->mappedCount = 0;
+    this->mappedSlotMask = 0;
+    this->parts.assign(1, unordered_map<string, unsigned int>());
+    this->parts[0].reserve(count);
+    this->names.clear();
+    this->names.reserve(count);
+    for (unsigned int id = 0; id < count; id++) {
+        string name(chars + offsets[id], offsets[id + 1] - offsets[id] - 1);
+        auto entry = this->parts[0].insert(make_pair(move(name), id)).first;
+        this->names.push_back(&entry->first);
+    }
+}
@@ -0,0 +1,225 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Sources used:
+ *  1) Stepik: Introduction to Data Structures (Fall 2016)
+ *     by Moshiri and Izhikevich (available at stepik.org)
+ *
+ * Description of File:
+ *  This file defines a string interning table. Every
+ *  distinct name is stored once and is given a dense
+ *  32 bit id, so the rest of the graph can work with
+ *  ids and only look at the strings when printing.
+ *  A table can also be a read only view of names
+ *  stored in a graph snapshot.
+ */
+
+#ifndef NAMETABLE_HPP
+#define NAMETABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/**
+ * The NameTable class assigns ids 0, 1, 2, ... to
+ * names in the order they are first interned. A table
+ * built one part per thread (see adoptPart) spreads
+ * its names over several hashtables by their hash;
+ * otherwise there is a single hashtable.
+ *
+ * A mapped table (see map) keeps its names back to
+ * back in one block of characters and finds them with
+ * an open addressing index of ids. Interning into it
+ * first copies its names into a hashtable.
+ *
+ * Instance variables:
+ *  1) parts - The hashtables from a name to its id.
+ *             Their keys are the only copy of each name.
+ *
+ *  2) names - Pointers to the keys of the hashtables,
+ *             indexed by id
+ *
+ *  3) mappedChars - The names of a mapped table, each
+ *                   ended by a '\0'
+ *
+ *  4) mappedOffsets - The start of each mapped name in
+ *                     mappedChars, indexed by id
+ *
+ *  5) mappedSlots - The index of a mapped table: the id
+ *                   of the name in each slot, or NO_ID
+ *
+ *  6) mappedCount - The number of names of a mapped table
+ *
+ *  7) mappedSlotMask - The number of slots minus one
+ */
+class NameTable {
+  protected:
+    vector<unordered_map<string, unsigned int>> parts;
+    vector<const string*> names;
+    const char* mappedChars;
+    const uint64_t* mappedOffsets;
+    const unsigned int* mappedSlots;
+    unsigned int mappedCount;
+    unsigned int mappedSlotMask;
+
+    /*
+     * The purpose of this method is to copy the names
+     * of a mapped table into a hashtable of its own,
+     * with the same ids, so that new names can be
+     * interned. The mapped storage is no longer used.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    void unmap();
+
+  public:
+    // Id returned when a name is not in the table
+    static const unsigned int NO_ID = 0xFFFFFFFFu;
+
+    /*
+     * This is the contructor method for the table.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    NameTable();
+
+    /* Returns which of numParts hashtables a name belongs to */
+    static unsigned int partOf(const string& name, unsigned int numParts) {
+        // A single hashtable needs no extra hashing
+        if (numParts == 1) {
+            return 0;
+        }
+        // The top bits, since the hashtable itself uses the low ones
+        size_t hash = std::hash<string>()(name);
+        return (unsigned int)((hash >> (sizeof(size_t) * 8 - 16)) % numParts);
+    }
+
+    /* Returns the hashtable of this table a name belongs to */
+    unsigned int partOf(const string& name) const {
+        return partOf(name, (unsigned int)this->parts.size());
+    }
+
+    /* Returns the number of hashtables the names are spread over */
+    unsigned int numParts() const { return (unsigned int)this->parts.size(); }
+
+    /*
+     * The purpose of this method is to return the
+     * id of a name, adding the name to the table
+     * with the next free id if it is new.
+     *
+     * Parameters:
+     *  1) name - The name to intern
+     *
+     */
+    unsigned int intern(const string& name);
+
+    /*
+     * The purpose of this method is to return the
+     * id of a name, or NO_ID if it was never interned.
+     *
+     * Parameters:
+     *  1) name - The name to look up
+     *
+     */
+    unsigned int find(const string& name) const;
+
+    /* Returns the name with the given id, ended by a '\0' */
+    const char* getName(unsigned int id) const {
+        if (this->mappedChars != nullptr) {
+            return this->mappedChars + this->mappedOffsets[id];
+        }
+        return this->names[id]->c_str();
+    }
+
+    /* Returns the number of names in the table */
+    unsigned int size() const {
+        if (this->mappedChars != nullptr) {
+            return this->mappedCount;
+        }
+        return (unsigned int)this->names.size();
+    }
+
+    /* Returns the hash used by the index of a mapped table */
+    static uint64_t hashName(const char* name, size_t length) {
+        // 64 bit FNV-1a, which is the same on every platform
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < length; i++) {
+            hash = (hash ^ (unsigned char)name[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /*
+     * The purpose of this method is to turn the table
+     * into a read only view of names stored elsewhere,
+     * such as in a snapshot. Nothing is copied, so the
+     * storage must outlive the table.
+     *
+     * Parameters:
+     *  1) chars - The names, each ended by a '\0'
+     *  2) offsets - The start of each name in chars,
+     *                followed by the size of chars
+     *  3) count - The number of names
+     *  4) slots - The index: a power of two number of
+     *             slots holding ids or NO_ID, where a
+     *             name is in the first free slot from
+     *             its hashName onward
+     *  5) numSlots - The number of slots
+     *
+     */
+    void map(const char* chars, const uint64_t* offsets, unsigned int count,
+             const unsigned int* slots, unsigned int numSlots);
+
+    /*
+     * The purpose of this method is to reserve room
+     * for a number of names ahead of time.
+     *
+     * Parameters:
+     *  1) count - The number of names expected
+     *
+     */
+    void reserve(size_t count);
+
+    /*
+     * The purpose of this method is to empty the
+     * table and make room for the names of a table
+     * built part by part. Every part must then be
+     * handed over with adoptPart.
+     *
+     * Parameters:
+     *  1) numParts - The number of parts, which decides
+     *                the part of each name (see partOf)
+     *  2) count - The total number of names
+     *
+     */
+    void prepareAdoption(unsigned int numParts, unsigned int count);
+
+    /*
+     * The purpose of this method is to take over the
+     * names of one part. Each name must belong to that
+     * part and already map to its final id. Different
+     * parts may be adopted by different threads at once.
+     *
+     * Parameters:
+     *  1) part - The part being handed over
+     *  2) partIds - The names of the part and their ids,
+     *               left empty by this method
+     *
+     */
+    void adoptPart(unsigned int part,
+                   unordered_map<string, unsigned int>& partIds);
+};
+
+#endif  // NAMETABLE_HPP
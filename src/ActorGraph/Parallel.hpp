@@ -0,0 +1,52 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Description of File:
+ *  This file defines a small helper that spreads the
+ *  iterations of a loop over several threads.
+ */
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/*
+ * This function runs task(i) for every i in [0, count).
+ * The threads take the next unclaimed i one at a time,
+ * so uneven tasks still keep every thread busy. The
+ * calling thread is one of the workers.
+ *
+ * Parameters:
+ *  1) numThreads - The number of threads to use
+ *  2) count - The number of iterations
+ *  3) task - Called once with each iteration
+ *
+ */
+template <typename Task>
+void parallelFor(unsigned int numThreads, size_t count, const Task& task) {
+    atomic<size_t> next(0);
+    auto work = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            task(i);
+        }
+    };
+    vector<thread> workers;
+    for (size_t t = 1; t < min((size_t)numThreads, count); t++) {
+        workers.push_back(thread(work));
+    }
+    work();
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+}
+
+#endif  // PARALLEL_HPP
@@ -0,0 +1,212 @@
+/**
+ * The ParallelCastLoader class loads a cast file on
+ * several threads. It scans chunks of rows, interns
+ * each hash part of the names on its own thread, and
+ * then numbers the names by the row they first appear
+ * on, so the ids match a serial load.
+ *
+ * Instance variables:
+ *  1) reader - The mapped cast file
+ *
+ *  2) numThreads - The number of threads to use
+ *
+ *  3) chunks - The rows of each chunk of the file
+ */
+
+#include "ParallelCastLoader.hpp"
+#include <cstdio>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include "Parallel.hpp"
+
+using namespace std;
+
+const unsigned int ParallelCastLoader::NUM_PARTS;
+
+/*
+ * This is the contructor method for the loader.
+ *
+ * Parameters:
+ *  1) reader - The mapped cast file
+ *  2) numThreads - The number of threads to use
+ *
+ */
+ParallelCastLoader::ParallelCastLoader(const CastFileReader& reader,
+                                       unsigned int numThreads)
+    : reader(reader), numThreads(numThreads) {}
+
+/*
+ * This method writes the interning key of the
+ * actor or movie of a row: the actor's name, or
+ * the movie's "title#@year".
+ *
+ * Parameters:
+ *  1) chunk - The chunk of the row
+ *  2) row - The index of the row in the chunk
+ *  3) isMovie - Whether to write the movie key
+ *  4) key - The string the key is written to
+ *
+ */
+void ParallelCastLoader::rowKey(const Chunk& chunk, unsigned int row,
+                                bool isMovie, string& key) const {
+    CastRow fields;
+    size_t position = chunk.begin + chunk.rowOffsets[row];
+    this->reader.nextRow(position, chunk.end, fields);
+    if (!isMovie) {
+        key.assign(fields.actor, fields.actorLength);
+        return;
+    }
+    char yearDigits[16];
+    int yearLength =
+        snprintf(yearDigits, sizeof(yearDigits), "#@%d", fields.year);
+    key.assign(fields.title, fields.titleLength);
+    key.append(yearDigits, yearLength);
+}
+
+/*
+ * This method loads the file. It fills the name
+ * tables and returns the actor and movie id of
+ * every well formed row, in file order.
+ *
+ * Parameters:
+ *  1) actorNames - Filled with the actor names
+ *  2) movieNames - Filled with the "title#@year"
+ *                  names of the movies
+ *  3) rowActors - Filled with the actor of each row
+ *  4) rowMovies - Filled with the movie of each row
+ *
+ */
+void ParallelCastLoader::load(NameTable& actorNames, NameTable& movieNames,
+                              vector<unsigned int>& rowActors,
+                              vector<unsigned int>& rowMovies) {
+    // A few chunks per thread so that uneven chunks balance out
+    vector<pair<size_t, size_t>> ranges;
+    this->reader.splitRows(this->numThreads * 4, ranges);
+    this->chunks.assign(ranges.size(), Chunk());
+
+    // Step 1: find the rows of each chunk and the part of their names
+    parallelFor(this->numThreads, this->chunks.size(), [&](size_t c) {
+        Chunk& chunk = this->chunks[c];
+        chunk.begin = ranges[c].first;
+        chunk.end = ranges[c].second;
+        chunk.actorRowsOfPart.resize(NUM_PARTS);
+        chunk.movieRowsOfPart.resize(NUM_PARTS);
+        const char* start = this->reader.getData() + chunk.begin;
+        size_t position = chunk.begin;
+        CastRow fields;
+        string key;
+        while (this->reader.nextRow(position, chunk.end, fields)) {
+            // The actor is the first field, so it is where the row starts
+            unsigned int row = chunk.rowOffsets.size();
+            chunk.rowOffsets.push_back(fields.actor - start);
+            this->rowKey(chunk, row, false, key);
+            chunk.actorRowsOfPart[NameTable::partOf(key, NUM_PARTS)]
+                .push_back(row);
+            this->rowKey(chunk, row, true, key);
+            chunk.movieRowsOfPart[NameTable::partOf(key, NUM_PARTS)]
+                .push_back(row);
+        }
+        chunk.actorIds.resize(chunk.rowOffsets.size());
+        chunk.movieIds.resize(chunk.rowOffsets.size());
+    });
+    size_t numRows = 0;
+    for (Chunk& chunk : this->chunks) {
+        chunk.firstRow = numRows;
+        numRows += chunk.rowOffsets.size();
+    }
+
+    // Steps 2 to 4, for the actors and then for the movies
+    this->internNames(false, actorNames);
+    this->internNames(true, movieNames);
+
+    // Hand back the ids of the rows in file order
+    rowActors.clear();
+    rowMovies.clear();
+    rowActors.reserve(numRows);
+    rowMovies.reserve(numRows);
+    for (Chunk& chunk : this->chunks) {
+        rowActors.insert(rowActors.end(), chunk.actorIds.begin(),
+                         chunk.actorIds.end());
+        rowMovies.insert(rowMovies.end(), chunk.movieIds.begin(),
+                         chunk.movieIds.end());
+    }
+    this->chunks.clear();
+}
+
+/*
+ * This method gives every name of one kind its
+ * final id and fills the name table with them.
+ *
+ * Parameters:
+ *  1) isMovie - Whether to number the movies or
+ *               the actors
+ *  2) names - The table to fill
+ *
+ */
+void ParallelCastLoader::internNames(bool isMovie, NameTable& names) {
+    // Step 2: intern each part on its own thread, in file order
+    vector<unordered_map<string, unsigned int>> partIds(NUM_PARTS);
+    vector<vector<size_t>> firstRows(NUM_PARTS);
+    parallelFor(this->numThreads, NUM_PARTS, [&](size_t p) {
+        string key;
+        for (Chunk& chunk : this->chunks) {
+            vector<unsigned int>& rows =
+                isMovie ? chunk.movieRowsOfPart[p] : chunk.actorRowsOfPart[p];
+            vector<unsigned int>& ids =
+                isMovie ? chunk.movieIds : chunk.actorIds;
+            for (unsigned int row : rows) {
+                this->rowKey(chunk, row, isMovie, key);
+                auto entry = partIds[p].find(key);
+                if (entry == partIds[p].end()) {
+                    entry = partIds[p]
+                                .insert(make_pair(key, firstRows[p].size()))
+                                .first;
+                    firstRows[p].push_back(chunk.firstRow + row);
+                }
+                ids[row] = entry->second;
+            }
+        }
+    });
+
+    // Step 3: number the names by the row they first appear on. The
+    // local ids of a part already follow that order, so this merges
+    // the parts. No two names of a kind share their first row.
+    typedef pair<size_t, unsigned int> RowOfPart;
+    priority_queue<RowOfPart, vector<RowOfPart>, greater<RowOfPart>> heads;
+    vector<vector<unsigned int>> finalIds(NUM_PARTS);
+    for (unsigned int p = 0; p < NUM_PARTS; p++) {
+        finalIds[p].reserve(firstRows[p].size());
+        if (!firstRows[p].empty()) {
+            heads.push(make_pair(firstRows[p][0], p));
+        }
+    }
+    unsigned int numNames = 0;
+    while (!heads.empty()) {
+        unsigned int p = heads.top().second;
+        heads.pop();
+        finalIds[p].push_back(numNames++);
+        if (finalIds[p].size() < firstRows[p].size()) {
+            heads.push(make_pair(firstRows[p][finalIds[p].size()], p));
+        }
+    }
+
+    // Step 4: swap in the final ids and hand the parts to the table
+    names.prepareAdoption(NUM_PARTS, numNames);
+    parallelFor(this->numThreads, NUM_PARTS, [&](size_t p) {
+        for (auto& entry : partIds[p]) {
+            entry.second = finalIds[p][entry.second];
+        }
+        names.adoptPart(p, partIds[p]);
+        for (Chunk& chunk : this->chunks) {
+            vector<unsigned int>& rows =
+                isMovie ? chunk.movieRowsOfPart[p] : chunk.actorRowsOfPart[p];
+            vector<unsigned int>& ids =
+                isMovie ? chunk.movieIds : chunk.actorIds;
+            for (unsigned int row : rows) {
+                ids[row] = finalIds[p][ids[row]];
+            }
+            vector<unsigned int>().swap(rows);
+        }
+    });
+}
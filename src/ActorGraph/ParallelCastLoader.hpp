@@ -0,0 +1,130 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Description of File:
+ *  This file defines a loader that reads and interns
+ *  a cast file on several threads. It gives every
+ *  actor and movie the same id, and every row the
+ *  same place, as reading the file row by row would,
+ *  whatever the number of threads.
+ */
+
+#ifndef PARALLELCASTLOADER_HPP
+#define PARALLELCASTLOADER_HPP
+
+#include <string>
+#include <vector>
+#include "CastFileReader.hpp"
+#include "NameTable.hpp"
+
+using namespace std;
+
+/**
+ * The ParallelCastLoader class loads a cast file in
+ * four steps:
+ *  1) The rows are split into chunks at line breaks,
+ *     and each chunk is scanned by one thread, which
+ *     sorts its rows by the hash part of their names.
+ *  2) Each hash part is interned by one thread, going
+ *     through the chunks in file order. This gives
+ *     each name a local id and the row it first
+ *     appears on.
+ *  3) The names are numbered by the row they first
+ *     appear on, which is the order a serial load
+ *     would have numbered them in.
+ *  4) The local ids of every row are replaced by the
+ *     final ids, and the parts become the name tables.
+ *
+ * Instance variables:
+ *  1) reader - The mapped cast file
+ *
+ *  2) numThreads - The number of threads to use
+ *
+ *  3) chunks - The rows of each chunk of the file
+ */
+class ParallelCastLoader {
+  protected:
+    /* The rows of one chunk of the file and what is known about them */
+    struct Chunk {
+        // Byte range of the chunk in the file
+        size_t begin;
+        size_t end;
+        // Global index of the first row of the chunk
+        size_t firstRow;
+        // Offset of each well formed row from the start of the chunk
+        vector<unsigned int> rowOffsets;
+        // Rows of the chunk whose actor / movie is in each part
+        vector<vector<unsigned int>> actorRowsOfPart;
+        vector<vector<unsigned int>> movieRowsOfPart;
+        // Id of the actor / movie of each row, local to its part at
+        // first and final once the load is done
+        vector<unsigned int> actorIds;
+        vector<unsigned int> movieIds;
+    };
+
+    const CastFileReader& reader;
+    unsigned int numThreads;
+    vector<Chunk> chunks;
+
+    /*
+     * This method gives every name of one kind its
+     * final id and fills the name table with them.
+     *
+     * Parameters:
+     *  1) isMovie - Whether to number the movies or
+     *               the actors
+     *  2) names - The table to fill
+     *
+     */
+    void internNames(bool isMovie, NameTable& names);
+
+    /*
+     * This method writes the interning key of the
+     * actor or movie of a row: the actor's name, or
+     * the movie's "title#@year".
+     *
+     * Parameters:
+     *  1) chunk - The chunk of the row
+     *  2) row - The index of the row in the chunk
+     *  3) isMovie - Whether to write the movie key
+     *  4) key - The string the key is written to
+     *
+     */
+    void rowKey(const Chunk& chunk, unsigned int row, bool isMovie,
+                string& key) const;
+
+  public:
+    // Number of hash parts the names are interned in
+    static const unsigned int NUM_PARTS = 64;
+
+    /*
+     * This is the contructor method for the loader.
+     *
+     * Parameters:
+     *  1) reader - The mapped cast file
+     *  2) numThreads - The number of threads to use
+     *
+     */
+    ParallelCastLoader(const CastFileReader& reader, unsigned int numThreads);
+
+    /*
+     * This method loads the file. It fills the name
+     * tables and returns the actor and movie id of
+     * every well formed row, in file order.
+     *
+     * Parameters:
+     *  1) actorNames - Filled with the actor names
+     *  2) movieNames - Filled with the "title#@year"
+     *                  names of the movies
+     *  3) rowActors - Filled with the actor of each row
+     *  4) rowMovies - Filled with the movie of each row
+     *
+     */
+    void load(NameTable& actorNames, NameTable& movieNames,
+              vector<unsigned int>& rowActors,
+              vector<unsigned int>& rowMovies);
+};
+
+#endif  // PARALLELCASTLOADER_HPP
@@ -0,0 +1,153 @@
+/**
+ * The PathQueryPool class hands submitted pairs of
+ * actors to its workers, which call the read only
+ * ActorGraph::BFS. Finished paths wait in a reorder
+ * buffer until every earlier path has been written.
+ *
+ * Instance variables:
+ *  1) graph - The graph the queries run on
+ *
+ *  2) out - The stream the paths are written to
+ *
+ *  3) search - How the BFS searches, see PathSearch
+ *
+ *  4) years - The years of the movies the BFS may use
+ *
+ *  5) workers - The worker threads
+ *
+ *  6) lock - Guards every variable below it
+ *
+ *  7) workReady - Signalled when a query is queued
+ *                 or the pool is closed
+ *
+ *  8) spaceReady - Signalled when a path is written
+ *
+ *  9) pending - The queued queries with their number
+ *
+ *  10) finished - The reorder buffer
+ *
+ *  11) nextSubmit - The number of the next query
+ *
+ *  12) nextWrite - The number of the next path to write
+ *
+ *  13) closed - Whether all queries have been submitted
+ */
+
+#include "PathQueryPool.hpp"
+
+using namespace std;
+
+const size_t PathQueryPool::MAX_IN_FLIGHT;
+
+/*
+ * This is the contructor method for the pool.
+ * It starts the worker threads.
+ *
+ * Parameters:
+ *  1) graph - The built graph to search
+ *  2) out - The stream each path is written to,
+ *           followed by a new line
+ *  3) numThreads - The number of workers
+ *  4) search - How the BFS searches, see PathSearch
+ *  5) years - The years of the movies the BFS may use
+ *
+ */
+PathQueryPool::PathQueryPool(ActorGraph* graph, ostream& out,
+                             unsigned int numThreads, PathSearch search,
+                             const YearRange& years)
+    : graph(graph), out(out), search(search), years(years) {
+    this->nextSubmit = 0;
+    this->nextWrite = 0;
+    this->closed = false;
+    for (unsigned int i = 0; i < numThreads; i++) {
+        this->workers.push_back(thread(&PathQueryPool::work, this));
+    }
+}
+
+/*
+ * This method queues a query. It blocks while
+ * MAX_IN_FLIGHT queries are waiting to be written.
+ *
+ * Parameters:
+ *  1) fromActor - The actor from which to start
+ *  2) toActor - The actor we want to end at
+ *
+ */
+void PathQueryPool::submit(const string& fromActor, const string& toActor) {
+    unique_lock<mutex> guard(this->lock);
+    while (this->nextSubmit - this->nextWrite >= MAX_IN_FLIGHT) {
+        this->spaceReady.wait(guard);
+    }
+    this->pending.push_back(
+        make_pair(this->nextSubmit, make_pair(fromActor, toActor)));
+    this->nextSubmit++;
+    this->workReady.notify_one();
+}
+
+/*
+ * This method is run by every worker. It takes
+ * queries until the pool is closed and empty,
+ * and writes every path that is next in line.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+void PathQueryPool::work() {
+    unique_lock<mutex> guard(this->lock);
+    while (true) {
+        while (this->pending.empty() && !this->closed) {
+            this->workReady.wait(guard);
+        }
+        if (this->pending.empty()) {
+            return;
+        }
+        auto query = this->pending.front();
+        this->pending.pop_front();
+
+        // The search itself only reads the graph, so run it unlocked
+        guard.unlock();
+        string shortestPath = "";
+        this->graph->BFS(query.second.first, query.second.second, shortestPath,
+                         this->search, this->years);
+        guard.lock();
+
+        // Park the path, then write every path that is now in line
+        this->finished[query.first] = move(shortestPath);
+        bool wrote = false;
+        auto entry = this->finished.find(this->nextWrite);
+        while (entry != this->finished.end()) {
+            this->out << entry->second << '\n';
+            this->finished.erase(entry);
+            this->nextWrite++;
+            wrote = true;
+            entry = this->finished.find(this->nextWrite);
+        }
+        if (wrote) {
+            this->spaceReady.notify_all();
+        }
+    }
+}
+
+/*
+ * This method waits until every submitted path
+ * has been written, then stops the workers.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+void PathQueryPool::finish() {
+    {
+        lock_guard<mutex> guard(this->lock);
+        this->closed = true;
+    }
+    this->workReady.notify_all();
+    for (unsigned int i = 0; i < this->workers.size(); i++) {
+        this->workers[i].join();
+    }
+    this->workers.clear();
+}
+
+/* The destructor finishes the pool if it was not finished */
+PathQueryPool::~PathQueryPool() { this->finish(); }
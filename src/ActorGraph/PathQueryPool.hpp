@@ -0,0 +1,139 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Description of File:
+ *  This file defines a pool of worker threads that
+ *  answer shortest path queries on a built graph.
+ *  The paths are written in the order the queries
+ *  were submitted, so the output is the same as a
+ *  run on a single thread.
+ */
+
+#ifndef PATHQUERYPOOL_HPP
+#define PATHQUERYPOOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ActorGraph.hpp"
+
+using namespace std;
+
+/**
+ * The PathQueryPool class hands submitted pairs of
+ * actors to its workers, which call the read only
+ * ActorGraph::BFS. Finished paths wait in a reorder
+ * buffer until every earlier path has been written.
+ * At most MAX_IN_FLIGHT queries are submitted but not
+ * yet written, which bounds the memory of the buffer.
+ *
+ * Instance variables:
+ *  1) graph - The graph the queries run on
+ *
+ *  2) out - The stream the paths are written to
+ *
+ *  3) search - How the BFS searches, see PathSearch
+ *
+ *  4) years - The years of the movies the BFS may use
+ *
+ *  5) workers - The worker threads
+ *
+ *  6) lock - Guards every variable below it
+ *
+ *  7) workReady - Signalled when a query is queued
+ *                 or the pool is closed
+ *
+ *  8) spaceReady - Signalled when a path is written
+ *
+ *  9) pending - The queued queries with their number
+ *
+ *  10) finished - The reorder buffer of paths that
+ *                 are found but not yet written
+ *
+ *  11) nextSubmit - The number of the next query
+ *
+ *  12) nextWrite - The number of the next path to write
+ *
+ *  13) closed - Whether all queries have been submitted
+ */
+class PathQueryPool {
+  protected:
+    ActorGraph* graph;
+    ostream& out;
+    PathSearch search;
+    YearRange years;
+    vector<thread> workers;
+
+    mutex lock;
+    condition_variable workReady;
+    condition_variable spaceReady;
+    deque<pair<size_t, pair<string, string>>> pending;
+    unordered_map<size_t, string> finished;
+    size_t nextSubmit;
+    size_t nextWrite;
+    bool closed;
+
+    /*
+     * This method is run by every worker. It takes
+     * queries until the pool is closed and empty,
+     * and writes every path that is next in line.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    void work();
+
+  public:
+    // Largest number of queries submitted but not written
+    static const size_t MAX_IN_FLIGHT = 1 << 16;
+
+    /*
+     * This is the contructor method for the pool.
+     * It starts the worker threads.
+     *
+     * Parameters:
+     *  1) graph - The built graph to search
+     *  2) out - The stream each path is written to,
+     *           followed by a new line
+     *  3) numThreads - The number of workers
+     *  4) search - How the BFS searches, see PathSearch
+     *  5) years - The years of the movies the BFS may use
+     *
+     */
+    PathQueryPool(ActorGraph* graph, ostream& out, unsigned int numThreads,
+                  PathSearch search, const YearRange& years = ALL_YEARS);
+
+    /*
+     * This method queues a query. It blocks while
+     * MAX_IN_FLIGHT queries are waiting to be written.
+     *
+     * Parameters:
+     *  1) fromActor - The actor from which to start
+     *  2) toActor - The actor we want to end at
+     *
+     */
+    void submit(const string& fromActor, const string& toActor);
+
+    /*
+     * This method waits until every submitted path
+     * has been written, then stops the workers.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    void finish();
+
+    /* The destructor finishes the pool if it was not finished */
+    ~PathQueryPool();
+};
+
+#endif  // PATHQUERYPOOL_HPP
@@ -0,0 +1,477 @@
+/**
+ * The PrunedLabelIndex class gives every actor a
+ * label of (hub, distance) pairs, built by pruned
+ * BFSs in order of decreasing number of co-stars.
+ *
+ * Instance variables:
+ *  1) numActors - The number of actors indexed
+ *
+ *  2) numMovies - The number of movies of the graph
+ *
+ *  3) numEdges - The number of edges of the graph
+ *
+ *  4) fingerprint - The checksum of the edges of the
+ *                   graph
+ *
+ *  5) order - The actor of each rank
+ *
+ *  6) offsets - Start of each actor's label
+ *
+ *  7) hubs - The rank of the hub of every entry
+ *
+ *  8) parents - The next actor towards the hub of
+ *               every entry
+ *
+ *  9) distances - The distance to the hub of every entry
+ */
+
+#include "PrunedLabelIndex.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "Parallel.hpp"
+#include "SearchWorkspace.hpp"
+
+using namespace std;
+
+const unsigned int PrunedLabelIndex::NO_DISTANCE;
+const unsigned int PrunedLabelIndex::MAX_DISTANCE;
+
+// Identifies an index file
+static const char MAGIC[8] = {'A', 'C', 'T', 'L', 'A', 'B', 'E', 'L'};
+// Version of the index file format
+static const uint32_t VERSION = 3;
+// Most BFSs each thread runs between two merges of their entries
+static const size_t BATCH_PER_THREAD = 16;
+// Marks a hub the root of a BFS has no entry for
+static const uint16_t NO_ENTRY = 0xFFFF;
+
+/* The start of an index file, followed by its arrays */
+struct LabelHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t numActors;
+    uint32_t numMovies;
+    uint32_t unused;
+    uint64_t numEdges;
+    uint64_t numEntries;
+    uint64_t fingerprint;
+};
+
+/* An entry of a label while the labels are built */
+struct LabelEntry {
+    unsigned int hub;
+    unsigned int parent;
+    uint16_t distance;
+};
+
+/*
+ * This function runs the pruned BFS of one root. It
+ * does not expand an actor whose distance to the root
+ * the labels already give, and returns an entry for
+ * every actor it does expand.
+ *
+ * Parameters:
+ *  1) graph - The graph to search
+ *  2) labels - The labels built by the earlier batches
+ *  3) root - The actor to start from
+ *  4) found - Filled with (actor, entry) pairs
+ *
+ */
+static void prunedSearch(const CSRGraph& graph,
+                         const vector<vector<LabelEntry>>& labels,
+                         unsigned int root,
+                         vector<pair<unsigned int, LabelEntry>>& found) {
+    // The distance of the root to each hub of its label
+    static thread_local vector<uint16_t> rootDistances;
+    if (rootDistances.size() < graph.numActors()) {
+        rootDistances.resize(graph.numActors(), NO_ENTRY);
+    }
+    for (const LabelEntry& entry : labels[root]) {
+        rootDistances[entry.hub] = entry.distance;
+    }
+
+    SearchWorkspace& workspace = SearchWorkspace::forThread();
+    workspace.startSearch(graph.numActors(), graph.numMovies());
+    workspace.reachActor(root, root, CSRGraph::NO_ID);
+    workspace.getFrontier().push_back(root);
+    for (unsigned int distance = 0; !workspace.getFrontier().empty();
+         distance++) {
+        vector<unsigned int>& frontier = workspace.getFrontier();
+        vector<unsigned int>& next = workspace.getNextFrontier();
+        next.clear();
+        for (unsigned int actor : frontier) {
+            // Prune the actors the labels already connect well enough
+            bool isCovered = false;
+            for (const LabelEntry& entry : labels[actor]) {
+                if (rootDistances[entry.hub] != NO_ENTRY &&
+                    rootDistances[entry.hub] + entry.distance <= distance) {
+                    isCovered = true;
+                    break;
+                }
+            }
+            if (isCovered) {
+                continue;
+            }
+            LabelEntry entry = {0, workspace.getPrevActor(actor),
+                                (uint16_t)distance};
+            found.push_back(make_pair(actor, entry));
+            if (distance == PrunedLabelIndex::MAX_DISTANCE) {
+                continue;
+            }
+            for (auto movie = graph.moviesBegin(actor);
+                 movie != graph.moviesEnd(actor); movie++) {
+                if (!workspace.visitMovie(*movie)) {
+                    continue;
+                }
+                for (auto other = graph.actorsBegin(*movie);
+                     other != graph.actorsEnd(*movie); other++) {
+                    if (!workspace.hasActor(*other)) {
+                        workspace.reachActor(*other, actor, *movie);
+                        next.push_back(*other);
+                    }
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+
+    for (const LabelEntry& entry : labels[root]) {
+        rootDistances[entry.hub] = NO_ENTRY;
+    }
+}
+
+/*
+ * This is the contructor method for the index.
+ * The index is empty until it is built or read.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+PrunedLabelIndex::PrunedLabelIndex() {
+    this->numActors = 0;
+    this->numMovies = 0;
+    this->numEdges = 0;
+    this->fingerprint = 0;
+}
+
+/*
+ * The purpose of this method is to build the
+ * labels of every actor of a graph.
+ *
+ * Parameters:
+ *  1) graph - The graph to index
+ *  2) numThreads - The number of threads to use
+ *
+ */
+void PrunedLabelIndex::build(const CSRGraph& graph, unsigned int numThreads) {
+    this->numActors = graph.numActors();
+    this->numMovies = graph.numMovies();
+    this->numEdges = graph.numEdges();
+    this->fingerprint = graph.fingerprint();
+
+    // Rank the actors by their number of co-star slots
+    vector<size_t> coStars(this->numActors);
+    for (unsigned int a = 0; a < this->numActors; a++) {
+        coStars[a] = graph.numCoStars(a);
+    }
+    this->order.resize(this->numActors);
+    for (unsigned int a = 0; a < this->numActors; a++) {
+        this->order[a] = a;
+    }
+    stable_sort(this->order.begin(), this->order.end(),
+                [&coStars](unsigned int a, unsigned int b) {
+                    return coStars[a] > coStars[b];
+                });
+
+    // The first batches are small since their hubs prune the most,
+    // and one thread runs one BFS at a time to keep the labels minimal
+    vector<vector<LabelEntry>> labels(this->numActors);
+    vector<vector<pair<unsigned int, LabelEntry>>> found;
+    for (size_t done = 0; done < this->numActors;) {
+        size_t batch = 1;
+        if (numThreads > 1) {
+            batch = min(numThreads * BATCH_PER_THREAD, done / 16);
+        }
+        batch = min(max(batch, (size_t)1), this->numActors - done);
+        found.resize(batch);
+        parallelFor(numThreads, batch, [&](size_t i) {
+            found[i].clear();
+            prunedSearch(graph, labels, this->order[done + i], found[i]);
+        });
+        // Ranks only grow, so every label stays sorted by hub
+        for (size_t i = 0; i < batch; i++) {
+            for (auto& actorEntry : found[i]) {
+                actorEntry.second.hub = done + i;
+                labels[actorEntry.first].push_back(actorEntry.second);
+            }
+        }
+        done += batch;
+    }
+
+    // Store the labels back to back
+    this->offsets.resize((size_t)this->numActors + 1);
+    this->offsets[0] = 0;
+    for (unsigned int a = 0; a < this->numActors; a++) {
+        this->offsets[a + 1] = this->offsets[a] + labels[a].size();
+    }
+    this->hubs.assign(this->offsets.back(), 0);
+    this->parents.assign(this->offsets.back(), 0);
+    this->distances.assign(this->offsets.back(), 0);
+    for (unsigned int a = 0; a < this->numActors; a++) {
+        uint64_t position = this->offsets[a];
+        for (const LabelEntry& entry : labels[a]) {
+            this->hubs[position] = entry.hub;
+            this->parents[position] = entry.parent;
+            this->distances[position] = entry.distance;
+            position++;
+        }
+        vector<LabelEntry>().swap(labels[a]);
+    }
+}
+
+/*
+ * The purpose of this method is to write the index
+ * to a file. Returns false if it cannot be written.
+ *
+ * Parameters:
+ *  1) filename - The name of the file to write
+ *
+ */
+bool PrunedLabelIndex::write(const char* filename) const {
+    LabelHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.numActors = this->numActors;
+    header.numMovies = this->numMovies;
+    header.numEdges = this->numEdges;
+    header.numEntries = this->hubs.size();
+    header.fingerprint = this->fingerprint;
+    ofstream out(filename, ios::binary | ios::trunc);
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)this->order.data(), 4 * this->order.size());
+    out.write((const char*)this->offsets.data(), 8 * this->offsets.size());
+    out.write((const char*)this->hubs.data(), 4 * this->hubs.size());
+    out.write((const char*)this->parents.data(), 4 * this->parents.size());
+    out.write((const char*)this->distances.data(),
+              2 * this->distances.size());
+    return out.good();
+}
+
+/*
+ * The purpose of this method is to read an index
+ * written by write. Returns false, leaving the
+ * index empty, if the file cannot be read, is
+ * corrupt, or was written for a graph with other
+ * edges.
+ *
+ * Parameters:
+ *  1) filename - The name of the file to read
+ *  2) graph - The graph the index must belong to
+ *
+ */
+bool PrunedLabelIndex::read(const char* filename, const CSRGraph& graph) {
+    ifstream in(filename, ios::binary);
+    LabelHeader header;
+    if (!in.read((char*)&header, sizeof(header)) ||
+        memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.version != VERSION || header.numActors != graph.numActors() ||
+        header.numMovies != graph.numMovies() ||
+        header.numEdges != graph.numEdges() ||
+        header.fingerprint != graph.fingerprint()) {
+        return false;
+    }
+    this->numActors = header.numActors;
+    this->order.resize(header.numActors);
+    this->offsets.resize((size_t)header.numActors + 1);
+    this->hubs.resize(header.numEntries);
+    this->parents.resize(header.numEntries);
+    this->distances.resize(header.numEntries);
+    in.read((char*)this->order.data(), 4 * this->order.size());
+    in.read((char*)this->offsets.data(), 8 * this->offsets.size());
+    in.read((char*)this->hubs.data(), 4 * this->hubs.size());
+    in.read((char*)this->parents.data(), 4 * this->parents.size());
+    in.read((char*)this->distances.data(), 2 * this->distances.size());
+    if (!in || !this->isConsistent()) {
+        *this = PrunedLabelIndex();
+        return false;
+    }
+    this->numMovies = header.numMovies;
+    this->numEdges = header.numEdges;
+    this->fingerprint = header.fingerprint;
+    return true;
+}
+
+/*
+ * The purpose of this method is to check that
+ * every rank, hub and parent read from a file is
+ * an actor of the index, and that every label is
+ * sorted by hub, so a corrupt file cannot be used.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+bool PrunedLabelIndex::isConsistent() const {
+    for (unsigned int actor : this->order) {
+        if (actor >= this->numActors) {
+            return false;
+        }
+    }
+    if (this->offsets[0] != 0 || this->offsets.back() != this->hubs.size()) {
+        return false;
+    }
+    for (unsigned int a = 0; a < this->numActors; a++) {
+        if (this->offsets[a + 1] < this->offsets[a] ||
+            this->offsets[a + 1] > this->hubs.size()) {
+            return false;
+        }
+        for (uint64_t e = this->offsets[a]; e < this->offsets[a + 1]; e++) {
+            if (this->hubs[e] >= this->numActors ||
+                this->parents[e] >= this->numActors ||
+                (e > this->offsets[a] && this->hubs[e] <= this->hubs[e - 1])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * The purpose of this method is to return the
+ * position of the entry of a hub in the label of
+ * an actor, or the end of the label if it has none.
+ *
+ * Parameters:
+ *  1) actorId - The actor whose label is searched
+ *  2) hub - The rank of the hub
+ *
+ */
+uint64_t PrunedLabelIndex::findEntry(unsigned int actorId,
+                                     unsigned int hub) const {
+    auto first = this->hubs.begin() + this->offsets[actorId];
+    auto last = this->hubs.begin() + this->offsets[actorId + 1];
+    auto entry = lower_bound(first, last, hub);
+    if (entry == last || *entry != hub) {
+        return this->offsets[actorId + 1];
+    }
+    return entry - this->hubs.begin();
+}
+
+/*
+ * The purpose of this method is to return the
+ * number of movies between two actors, or
+ * NO_DISTANCE if they are not connected.
+ *
+ * Parameters:
+ *  1) fromId - The first actor
+ *  2) toId - The second actor
+ *
+ */
+unsigned int PrunedLabelIndex::distance(unsigned int fromId,
+                                        unsigned int toId) const {
+    unsigned int best = NO_DISTANCE;
+    uint64_t i = this->offsets[fromId];
+    uint64_t j = this->offsets[toId];
+    // Both labels are sorted by hub, so merge them
+    while (i < this->offsets[fromId + 1] && j < this->offsets[toId + 1]) {
+        if (this->hubs[i] < this->hubs[j]) {
+            i++;
+        } else if (this->hubs[i] > this->hubs[j]) {
+            j++;
+        } else {
+            best = min(best, (unsigned int)this->distances[i] +
+                                 this->distances[j]);
+            i++;
+            j++;
+        }
+    }
+    return best;
+}
+
+/*
+ * The purpose of this method is to find a shortest
+ * path between two actors by walking from each of
+ * them to their best common hub. Returns false if
+ * they are not connected.
+ *
+ * Parameters:
+ *  1) graph - The graph the index was built for
+ *  2) fromId - The actor from which to start
+ *  3) toId - The actor we want to end at
+ *  4) actorIds - Filled with the actors on the path
+ *  5) movieIds - Filled with the movies between them
+ *
+ */
+bool PrunedLabelIndex::getPath(const CSRGraph& graph, unsigned int fromId,
+                               unsigned int toId,
+                               vector<unsigned int>& actorIds,
+                               vector<unsigned int>& movieIds) const {
+    actorIds.clear();
+    movieIds.clear();
+    // Find the common hub of the shortest path
+    unsigned int best = NO_DISTANCE;
+    unsigned int hub = 0;
+    uint64_t i = this->offsets[fromId];
+    uint64_t j = this->offsets[toId];
+    while (i < this->offsets[fromId + 1] && j < this->offsets[toId + 1]) {
+        if (this->hubs[i] < this->hubs[j]) {
+            i++;
+        } else if (this->hubs[i] > this->hubs[j]) {
+            j++;
+        } else {
+            if ((unsigned int)this->distances[i] + this->distances[j] < best) {
+                best = this->distances[i] + this->distances[j];
+                hub = this->hubs[i];
+            }
+            i++;
+            j++;
+        }
+    }
+    if (best == NO_DISTANCE) {
+        return false;
+    }
+
+    // Walk from each end to the hub, then join the two walks. A walk
+    // that leaves the labels or runs too long means a corrupt index
+    vector<unsigned int> backwards;
+    unsigned int ends[2] = {fromId, toId};
+    vector<unsigned int>* walks[2] = {&actorIds, &backwards};
+    for (unsigned int side = 0; side < 2; side++) {
+        unsigned int current = ends[side];
+        walks[side]->push_back(current);
+        while (current != this->order[hub]) {
+            uint64_t entry = this->findEntry(current, hub);
+            if (entry == this->offsets[current + 1] ||
+                walks[side]->size() > best) {
+                actorIds.clear();
+                return false;
+            }
+            current = this->parents[entry];
+            walks[side]->push_back(current);
+        }
+    }
+    actorIds.insert(actorIds.end(), backwards.rbegin() + 1, backwards.rend());
+    for (size_t k = 0; k + 1 < actorIds.size(); k++) {
+        movieIds.push_back(graph.sharedMovie(actorIds[k], actorIds[k + 1]));
+    }
+    return true;
+}
+
+/*
+ * The purpose of this method is to return the
+ * number of bytes used by the index.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+size_t PrunedLabelIndex::memoryUsage() const {
+    return sizeof(unsigned int) * this->order.capacity() +
+           sizeof(uint64_t) * this->offsets.capacity() +
+           sizeof(unsigned int) * this->hubs.capacity() +
+           sizeof(unsigned int) * this->parents.capacity() +
+           sizeof(uint16_t) * this->distances.capacity();
+}
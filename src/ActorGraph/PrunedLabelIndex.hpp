@@ -0,0 +1,204 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Sources used:
+ *  1) Akiba, Iwata and Yoshida, "Fast Exact Shortest-Path
+ *     Distance Queries on Large Networks by Pruned
+ *     Landmark Labeling", SIGMOD 2013
+ *
+ * Description of File:
+ *  This file defines a 2-hop distance index over the
+ *  actors. Every actor gets a label of (hub, distance)
+ *  pairs such that a shortest path between any two
+ *  actors goes through a hub they both have, so a
+ *  distance query is one merge of two short labels.
+ */
+
+#ifndef PRUNEDLABELINDEX_HPP
+#define PRUNEDLABELINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CSRGraph.hpp"
+
+using namespace std;
+
+/**
+ * The PrunedLabelIndex class builds the labels with
+ * one BFS per actor, taking the actors by decreasing
+ * number of co-stars. A BFS stops at every actor whose
+ * distance the labels built so far already give, so
+ * the later ones stay tiny. The BFSs of a batch of
+ * actors run on several threads, each pruned by the
+ * labels of the earlier batches only, which keeps the
+ * labels exact at the cost of a few extra entries.
+ *
+ * Each entry also keeps the next actor on a shortest
+ * path towards its hub, which has an entry for the
+ * same hub, so a path can be walked hub by hub.
+ *
+ * Instance variables:
+ *  1) numActors - The number of actors indexed
+ *
+ *  2) numMovies - The number of movies of the graph
+ *
+ *  3) numEdges - The number of edges of the graph
+ *
+ *  4) fingerprint - The checksum of the edges of the
+ *                   graph
+ *
+ *  5) order - The actor of each rank, the actor with
+ *             the most co-stars first
+ *
+ *  6) offsets - hubs[offsets[a] .. offsets[a + 1]) is
+ *               the label of actor a
+ *
+ *  7) hubs - The rank of the hub of every entry,
+ *            increasing within each label
+ *
+ *  8) parents - The next actor towards the hub of
+ *               every entry
+ *
+ *  9) distances - The number of movies between each
+ *                 actor and the hub of every entry
+ */
+class PrunedLabelIndex {
+  protected:
+    unsigned int numActors;
+    unsigned int numMovies;
+    size_t numEdges;
+    uint64_t fingerprint;
+    vector<unsigned int> order;
+    vector<uint64_t> offsets;
+    vector<unsigned int> hubs;
+    vector<unsigned int> parents;
+    vector<uint16_t> distances;
+
+    /*
+     * The purpose of this method is to return the
+     * position of the entry of a hub in the label of
+     * an actor, or the end of the label if it has none.
+     *
+     * Parameters:
+     *  1) actorId - The actor whose label is searched
+     *  2) hub - The rank of the hub
+     *
+     */
+    uint64_t findEntry(unsigned int actorId, unsigned int hub) const;
+
+    /*
+     * The purpose of this method is to check that
+     * every rank, hub and parent read from a file is
+     * an actor of the index, and that every label is
+     * sorted by hub, so a corrupt file cannot be used.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    bool isConsistent() const;
+
+  public:
+    // Distance of two actors that are not connected
+    static const unsigned int NO_DISTANCE = 0xFFFFFFFFu;
+    // Largest distance the labels can hold
+    static const unsigned int MAX_DISTANCE = 65534;
+
+    /*
+     * This is the contructor method for the index.
+     * The index is empty until it is built or read.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    PrunedLabelIndex();
+
+    /*
+     * The purpose of this method is to build the
+     * labels of every actor of a graph. Actors farther
+     * apart than MAX_DISTANCE are not connected as far
+     * as the index is concerned.
+     *
+     * Parameters:
+     *  1) graph - The graph to index
+     *  2) numThreads - The number of threads to use
+     *
+     */
+    void build(const CSRGraph& graph, unsigned int numThreads);
+
+    /*
+     * The purpose of this method is to write the index
+     * to a file. Returns false if it cannot be written.
+     *
+     * Parameters:
+     *  1) filename - The name of the file to write
+     *
+     */
+    bool write(const char* filename) const;
+
+    /*
+     * The purpose of this method is to read an index
+     * written by write. Returns false, leaving the
+     * index empty, if the file cannot be read, is
+     * corrupt, or was written for a graph with other
+     * edges.
+     *
+     * Parameters:
+     *  1) filename - The name of the file to read
+     *  2) graph - The graph the index must belong to
+     *
+     */
+    bool read(const char* filename, const CSRGraph& graph);
+
+    /* Returns true if the index has been built or read */
+    bool isReady() const { return !this->offsets.empty(); }
+
+    /* Returns the number of entries of all the labels */
+    size_t numEntries() const { return this->hubs.size(); }
+
+    /*
+     * The purpose of this method is to return the
+     * number of movies between two actors, or
+     * NO_DISTANCE if they are not connected.
+     *
+     * Parameters:
+     *  1) fromId - The first actor
+     *  2) toId - The second actor
+     *
+     */
+    unsigned int distance(unsigned int fromId, unsigned int toId) const;
+
+    /*
+     * The purpose of this method is to find a shortest
+     * path between two actors by walking from each of
+     * them to their best common hub. Returns false if
+     * they are not connected.
+     *
+     * Parameters:
+     *  1) graph - The graph the index was built for
+     *  2) fromId - The actor from which to start
+     *  3) toId - The actor we want to end at
+     *  4) actorIds - Filled with the actors on the path
+     *  5) movieIds - Filled with the movies between them
+     *
+     */
+    bool getPath(const CSRGraph& graph, unsigned int fromId,
+                 unsigned int toId, vector<unsigned int>& actorIds,
+                 vector<unsigned int>& movieIds) const;
+
+    /*
+     * The purpose of this method is to return the
+     * number of bytes used by the index.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    size_t memoryUsage() const;
+};
+
+#endif  // PRUNEDLABELINDEX_HPP
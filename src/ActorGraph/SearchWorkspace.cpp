@@ -0,0 +1,110 @@
+/**
+ * The SearchWorkspace class holds the visited marks,
+ * the previous links, and the frontiers of one search.
+ * An actor or movie counts as visited only if its
+ * stamp equals the current epoch.
+ *
+ * Instance variables:
+ *  1) epoch - The stamp of the current search
+ *
+ *  2) actorEpochs - The epoch each actor was last reached in
+ *
+ *  3) movieEpochs - The epoch each movie was last visited in
+ *
+ *  4) prevActors - The previous actor of each reached actor
+ *
+ *  5) prevMovies - The movie linking each reached actor
+ *                  to its previous actor
+ *
+ *  6) frontier - The actors being expanded
+ *
+ *  7) nextFrontier - The actors reached by the current expansion
+ *
+ *  8) heap - The movies waiting in a weighted search
+ *
+ *  9) actorBits - A bitmap of the reached actors
+ */
+
+#include "SearchWorkspace.hpp"
+#include <algorithm>
+
+using namespace std;
+
+const unsigned int SearchWorkspace::NUM_SLOTS;
+
+/*
+ * This is the contructor method for the workspace.
+ * The arrays are sized by the first search.
+ *
+ * Parameters:
+ *  NONE
+ *
+ */
+SearchWorkspace::SearchWorkspace() { this->epoch = 0; }
+
+/*
+ * The purpose of this method is to start a new
+ * search. It forgets every visited mark in O(1)
+ * and only allocates if the graph has grown since
+ * the last search. Both frontiers and the heap
+ * are emptied.
+ *
+ * Parameters:
+ *  1) numActors - The number of actors in the graph
+ *  2) numMovies - The number of movies in the graph
+ *
+ */
+void SearchWorkspace::startSearch(unsigned int numActors,
+                                  unsigned int numMovies) {
+    // New slots get stamp 0, which is never a live epoch
+    if (this->actorEpochs.size() < numActors) {
+        this->actorEpochs.resize(numActors, 0);
+        this->prevActors.resize(numActors);
+        this->prevMovies.resize(numActors);
+    }
+    if (this->movieEpochs.size() < numMovies) {
+        this->movieEpochs.resize(numMovies, 0);
+    }
+    this->epoch++;
+    // Once every 2^32 searches the stamps must really be cleared
+    if (this->epoch == 0) {
+        fill(this->actorEpochs.begin(), this->actorEpochs.end(), 0);
+        fill(this->movieEpochs.begin(), this->movieEpochs.end(), 0);
+        this->epoch = 1;
+    }
+    this->frontier.clear();
+    this->nextFrontier.clear();
+    this->heap.clear();
+}
+
+/*
+ * The purpose of this method is to clear the
+ * bitmap of the reached actors and return it.
+ *
+ * Parameters:
+ *  1) numActors - The number of actors in the graph
+ *
+ */
+uint64_t* SearchWorkspace::clearActorBits(unsigned int numActors) {
+    size_t numWords = (numActors + 63) / 64;
+    if (this->actorBits.size() < numWords) {
+        this->actorBits.resize(numWords);
+    }
+    fill(this->actorBits.begin(), this->actorBits.begin() + numWords, 0);
+    return this->actorBits.data();
+}
+
+/*
+ * The purpose of this method is to return one of
+ * the workspaces owned by the calling thread. Each
+ * thread gets NUM_SLOTS of them so that a search can
+ * use more than one at a time.
+ *
+ * Parameters:
+ *  1) slot - Which of the thread's workspaces to use
+ *
+ */
+SearchWorkspace& SearchWorkspace::forThread(unsigned int slot) {
+    static thread_local SearchWorkspace workspaces[NUM_SLOTS];
+    return workspaces[slot];
+}
@@ -0,0 +1,184 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Sources used:
+ *  1) Stepik: Introduction to Data Structures (Fall 2016)
+ *     by Moshiri and Izhikevich (available at stepik.org)
+ *
+ * Description of File:
+ *  This file defines the scratch space used by the
+ *  searches over the CSR graph. It is kept alive
+ *  between searches so that back to back queries do
+ *  not allocate, and it is cleared in O(1) time by
+ *  bumping an epoch counter.
+ */
+
+#ifndef SEARCHWORKSPACE_HPP
+#define SEARCHWORKSPACE_HPP
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/* A movie waiting in the heap of a weighted search */
+struct WeightedEntry {
+    // Distance of the start to the cast of the movie through it
+    uint64_t distance;
+    unsigned int movieId;
+    // The actor the movie was reached from
+    unsigned int prevActor;
+
+    /* Orders the entries by distance, then by movie */
+    bool operator>(const WeightedEntry& other) const {
+        if (this->distance != other.distance) {
+            return this->distance > other.distance;
+        }
+        return this->movieId > other.movieId;
+    }
+};
+
+/**
+ * The SearchWorkspace class holds the visited marks,
+ * the previous links, and the frontiers of one search.
+ * An actor or movie counts as visited only if its
+ * stamp equals the current epoch, so starting a new
+ * search just increments the epoch.
+ *
+ * Instance variables:
+ *  1) epoch - The stamp of the current search
+ *
+ *  2) actorEpochs - The epoch each actor was last
+ *                   reached in
+ *
+ *  3) movieEpochs - The epoch each movie was last
+ *                   visited in
+ *
+ *  4) prevActors - The previous actor of each
+ *                  reached actor
+ *
+ *  5) prevMovies - The movie linking each reached
+ *                  actor to its previous actor
+ *
+ *  6) frontier - The actors being expanded
+ *
+ *  7) nextFrontier - The actors reached by the
+ *                    current expansion
+ *
+ *  8) heap - The movies waiting in a weighted
+ *            search, closest on top
+ *
+ *  9) actorBits - A bitmap of the reached actors,
+ *                 kept only by the searches that
+ *                 clear it (see clearActorBits)
+ */
+class SearchWorkspace {
+  protected:
+    unsigned int epoch;
+    vector<unsigned int> actorEpochs;
+    vector<unsigned int> movieEpochs;
+    vector<unsigned int> prevActors;
+    vector<unsigned int> prevMovies;
+    vector<unsigned int> frontier;
+    vector<unsigned int> nextFrontier;
+    vector<WeightedEntry> heap;
+    vector<uint64_t> actorBits;
+
+  public:
+    // Number of workspaces kept for each thread
+    static const unsigned int NUM_SLOTS = 2;
+
+    /*
+     * This is the contructor method for the workspace.
+     * The arrays are sized by the first search.
+     *
+     * Parameters:
+     *  NONE
+     *
+     */
+    SearchWorkspace();
+
+    /*
+     * The purpose of this method is to start a new
+     * search. It forgets every visited mark in O(1)
+     * and only allocates if the graph has grown since
+     * the last search. Both frontiers and the heap
+     * are emptied.
+     *
+     * Parameters:
+     *  1) numActors - The number of actors in the graph
+     *  2) numMovies - The number of movies in the graph
+     *
+     */
+    void startSearch(unsigned int numActors, unsigned int numMovies);
+
+    /* Returns true if the actor was reached by this search */
+    bool hasActor(unsigned int actorId) const {
+        return this->actorEpochs[actorId] == this->epoch;
+    }
+
+    /* Marks an actor as reached through a previous actor and movie */
+    void reachActor(unsigned int actorId, unsigned int prevActor,
+                    unsigned int prevMovie) {
+        this->actorEpochs[actorId] = this->epoch;
+        this->prevActors[actorId] = prevActor;
+        this->prevMovies[actorId] = prevMovie;
+    }
+
+    /* Marks a movie as visited, returns false if it already was */
+    bool visitMovie(unsigned int movieId) {
+        if (this->movieEpochs[movieId] == this->epoch) {
+            return false;
+        }
+        this->movieEpochs[movieId] = this->epoch;
+        return true;
+    }
+
+    /*
+     * The purpose of this method is to clear the
+     * bitmap of the reached actors and return it.
+     * Unlike the stamps it is not kept up to date by
+     * reachActor, so a search that uses it must set
+     * the bit of every actor it reaches itself.
+     *
+     * Parameters:
+     *  1) numActors - The number of actors in the graph
+     *
+     */
+    uint64_t* clearActorBits(unsigned int numActors);
+
+    /* Returns the previous actor of a reached actor */
+    unsigned int getPrevActor(unsigned int actorId) const {
+        return this->prevActors[actorId];
+    }
+
+    /* Returns the movie linking a reached actor to its previous actor */
+    unsigned int getPrevMovie(unsigned int actorId) const {
+        return this->prevMovies[actorId];
+    }
+
+    /* Returns the actors being expanded */
+    vector<unsigned int>& getFrontier() { return this->frontier; }
+
+    /* Returns the actors reached by the current expansion */
+    vector<unsigned int>& getNextFrontier() { return this->nextFrontier; }
+
+    /* Returns the heap of a weighted search */
+    vector<WeightedEntry>& getHeap() { return this->heap; }
+
+    /*
+     * The purpose of this method is to return one of
+     * the workspaces owned by the calling thread. Each
+     * thread gets NUM_SLOTS of them so that a search can
+     * use more than one at a time.
+     *
+     * Parameters:
+     *  1) slot - Which of the thread's workspaces to use
+     *
+     */
+    static SearchWorkspace& forThread(unsigned int slot = 0);
+};
+
+#endif  // SEARCHWORKSPACE_HPP
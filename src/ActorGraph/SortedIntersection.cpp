@@ -0,0 +1,224 @@
+/**
+ * This file implements the intersection of two sorted
+ * lists of ids. Lists of similar length are compared
+ * a block at a time: every id of a block of a is
+ * compared with every id of a block of b by rotating
+ * the block of b, and the block with the smaller last
+ * id is then skipped. A list more than GALLOP_RATIO
+ * times shorter than the other is galloped instead.
+ */
+
+#include "SortedIntersection.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define HAVE_X86_SIMD 1
+#endif
+
+using namespace std;
+
+// A list this many times longer than the other is galloped through
+static const size_t GALLOP_RATIO = 32;
+
+/* Adds the ids of a block of a picked by a match mask to the result */
+static inline size_t emitMatches(const unsigned int* block, unsigned int mask,
+                                 unsigned int* common, size_t count) {
+    if (common == nullptr) {
+        return count + __builtin_popcount(mask);
+    }
+    while (mask != 0) {
+        common[count++] = block[__builtin_ctz(mask)];
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+/*
+ * This function merges the rest of two lists after
+ * the blocks, one id at a time.
+ *
+ * Parameters:
+ *  1) a, aSize, b, bSize, common - As intersectSorted
+ *  2) i, j - Where the merge starts in a and b
+ *  3) count - The number of common ids found so far
+ *
+ */
+static size_t mergeTail(const unsigned int* a, size_t aSize,
+                        const unsigned int* b, size_t bSize,
+                        unsigned int* common, size_t i, size_t j,
+                        size_t count) {
+    while (i < aSize && j < bSize) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            if (common != nullptr) {
+                common[count] = a[i];
+            }
+            count++;
+            i++;
+            j++;
+        }
+    }
+    return count;
+}
+
+/*
+ * This function looks up every id of a short list
+ * in a long one by galloping: it doubles its steps
+ * from the last match until it passes the id, and
+ * then binary searches the last step.
+ *
+ * Parameters:
+ *  1) small, smallSize - The short list
+ *  2) large, largeSize - The long list
+ *  3) common - As intersectSorted
+ *
+ */
+static size_t gallop(const unsigned int* small, size_t smallSize,
+                     const unsigned int* large, size_t largeSize,
+                     unsigned int* common) {
+    size_t count = 0;
+    size_t low = 0;
+    for (size_t i = 0; i < smallSize && low < largeSize; i++) {
+        unsigned int id = small[i];
+        size_t step = 1;
+        size_t high = low;
+        while (high < largeSize && large[high] < id) {
+            low = high + 1;
+            high += step;
+            step *= 2;
+        }
+        high = min(high + 1, largeSize);
+        low = lower_bound(large + low, large + high, id) - large;
+        if (low < largeSize && large[low] == id) {
+            if (common != nullptr) {
+                common[count] = id;
+            }
+            count++;
+            low++;
+        }
+    }
+    return count;
+}
+
+#ifdef HAVE_X86_SIMD
+/*
+ * This function compares blocks of 4 ids with SSE2,
+ * which every x86-64 CPU has, and merges the rest.
+ *
+ * Parameters:
+ *  Same as intersectSorted
+ *
+ */
+static size_t intersectSSE2(const unsigned int* a, size_t aSize,
+                            const unsigned int* b, size_t bSize,
+                            unsigned int* common) {
+    size_t i = 0;
+    size_t j = 0;
+    size_t count = 0;
+    while (i + 4 <= aSize && j + 4 <= bSize) {
+        __m128i blockA = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i blockB = _mm_loadu_si128((const __m128i*)(b + j));
+        __m128i match = _mm_cmpeq_epi32(blockA, blockB);
+        match = _mm_or_si128(
+            match, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, 0x39)));
+        match = _mm_or_si128(
+            match, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, 0x4E)));
+        match = _mm_or_si128(
+            match, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, 0x93)));
+        unsigned int mask = _mm_movemask_ps(_mm_castsi128_ps(match));
+        count = emitMatches(a + i, mask, common, count);
+        unsigned int lastA = a[i + 3];
+        unsigned int lastB = b[j + 3];
+        i += lastA <= lastB ? 4 : 0;
+        j += lastB <= lastA ? 4 : 0;
+    }
+    return mergeTail(a, aSize, b, bSize, common, i, j, count);
+}
+
+/*
+ * This function compares blocks of 8 ids with AVX2.
+ * It is only called when the CPU has AVX2.
+ *
+ * Parameters:
+ *  Same as intersectSorted
+ *
+ */
+__attribute__((target("avx2"))) static size_t intersectAVX2(
+    const unsigned int* a, size_t aSize, const unsigned int* b, size_t bSize,
+    unsigned int* common) {
+    size_t i = 0;
+    size_t j = 0;
+    size_t count = 0;
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    while (i + 8 <= aSize && j + 8 <= bSize) {
+        __m256i blockA = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i blockB = _mm256_loadu_si256((const __m256i*)(b + j));
+        __m256i match = _mm256_cmpeq_epi32(blockA, blockB);
+        for (unsigned int r = 1; r < 8; r++) {
+            blockB = _mm256_permutevar8x32_epi32(blockB, rotate);
+            match = _mm256_or_si256(match, _mm256_cmpeq_epi32(blockA, blockB));
+        }
+        unsigned int mask = _mm256_movemask_ps(_mm256_castsi256_ps(match));
+        count = emitMatches(a + i, mask, common, count);
+        unsigned int lastA = a[i + 7];
+        unsigned int lastB = b[j + 7];
+        i += lastA <= lastB ? 8 : 0;
+        j += lastB <= lastA ? 8 : 0;
+    }
+    return mergeTail(a, aSize, b, bSize, common, i, j, count);
+}
+#endif
+
+/*
+ * This function finds the ids that are in both of
+ * two sorted lists of distinct ids. Returns how many
+ * there are.
+ *
+ * Parameters:
+ *  1) a - The first list, sorted ascending
+ *  2) aSize - The number of ids in a
+ *  3) b - The second list, sorted ascending
+ *  4) bSize - The number of ids in b
+ *  5) common - Filled with the common ids in
+ *              ascending order, or nullptr to only
+ *              count them. Must have room for the
+ *              shorter of the two lists.
+ *
+ */
+size_t intersectSorted(const unsigned int* a, size_t aSize,
+                       const unsigned int* b, size_t bSize,
+                       unsigned int* common) {
+    if (aSize * GALLOP_RATIO < bSize) {
+        return gallop(a, aSize, b, bSize, common);
+    }
+    if (bSize * GALLOP_RATIO < aSize) {
+        return gallop(b, bSize, a, aSize, common);
+    }
+#ifdef HAVE_X86_SIMD
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    if (hasAVX2) {
+        return intersectAVX2(a, aSize, b, bSize, common);
+    }
+    return intersectSSE2(a, aSize, b, bSize, common);
+#else
+    return mergeTail(a, aSize, b, bSize, common, 0, 0, 0);
+#endif
+}
+
+/*
+ * This function is intersectSorted without any SIMD
+ * or galloping, used to check the fast versions.
+ *
+ * Parameters:
+ *  Same as intersectSorted
+ *
+ */
+size_t intersectSortedScalar(const unsigned int* a, size_t aSize,
+                             const unsigned int* b, size_t bSize,
+                             unsigned int* common) {
+    return mergeTail(a, aSize, b, bSize, common, 0, 0, 0);
+}
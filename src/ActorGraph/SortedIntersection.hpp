@@ -0,0 +1,53 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Description of File:
+ *  This file defines the intersection of two sorted
+ *  lists of ids. On x86-64 the lists are compared a
+ *  block at a time with SSE2, or AVX2 when the CPU
+ *  has it, and a short list is galloped through a
+ *  much longer one.
+ */
+
+#ifndef SORTEDINTERSECTION_HPP
+#define SORTEDINTERSECTION_HPP
+
+#include <cstddef>
+
+using namespace std;
+
+/*
+ * This function finds the ids that are in both of
+ * two sorted lists of distinct ids. Returns how many
+ * there are.
+ *
+ * Parameters:
+ *  1) a - The first list, sorted ascending
+ *  2) aSize - The number of ids in a
+ *  3) b - The second list, sorted ascending
+ *  4) bSize - The number of ids in b
+ *  5) common - Filled with the common ids in
+ *              ascending order, or nullptr to only
+ *              count them. Must have room for the
+ *              shorter of the two lists.
+ *
+ */
+size_t intersectSorted(const unsigned int* a, size_t aSize,
+                       const unsigned int* b, size_t bSize,
+                       unsigned int* common);
+
+/*
+ * This function is intersectSorted without any SIMD
+ * or galloping, used to check the fast versions.
+ *
+ * Parameters:
+ *  Same as intersectSorted
+ *
+ */
+size_t intersectSortedScalar(const unsigned int* a, size_t aSize,
+                             const unsigned int* b, size_t bSize,
+                             unsigned int* common);
+
+#endif  // SORTEDINTERSECTION_HPP
@@ -0,0 +1,213 @@
+/**
+ * The VertexOrder class computes the new order of the
+ * actors and movies of a graph.
+ *
+ * Instance variables:
+ *  1) actorOrder - The old id of each new actor id
+ *
+ *  2) movieOrder - The old id of each new movie id
+ */
+
+#include "VertexOrder.hpp"
+#include <algorithm>
+
+using namespace std;
+
+// Number of passes of label propagation over the actors
+static const unsigned int LABEL_ROUNDS = 3;
+
+/*
+ * This function returns the actors of a graph by
+ * decreasing number of co-stars, ties by id.
+ *
+ * Parameters:
+ *  1) graph - The graph to order
+ *
+ */
+static vector<unsigned int> actorsByCoStars(const CSRGraph& graph) {
+    vector<size_t> coStars(graph.numActors());
+    vector<unsigned int> actors(graph.numActors());
+    for (unsigned int a = 0; a < graph.numActors(); a++) {
+        coStars[a] = graph.numCoStars(a);
+        actors[a] = a;
+    }
+    stable_sort(actors.begin(), actors.end(),
+                [&coStars](unsigned int a, unsigned int b) {
+                    return coStars[a] > coStars[b];
+                });
+    return actors;
+}
+
+/*
+ * This function numbers the actors and movies in
+ * the order BFSs reach them. Each actor not reached
+ * yet, by decreasing number of co-stars, starts the
+ * next BFS.
+ *
+ * Parameters:
+ *  1) graph - The graph to order
+ *  2) actorOrder - Filled with the actors in order
+ *  3) movieOrder - Filled with the movies in order
+ *
+ */
+static void bfsOrder(const CSRGraph& graph, vector<unsigned int>& actorOrder,
+                     vector<unsigned int>& movieOrder) {
+    vector<bool> actorSeen(graph.numActors(), false);
+    vector<bool> movieSeen(graph.numMovies(), false);
+    actorOrder.clear();
+    movieOrder.clear();
+    // The order is also the queue of the BFSs
+    for (unsigned int source : actorsByCoStars(graph)) {
+        if (actorSeen[source]) {
+            continue;
+        }
+        actorSeen[source] = true;
+        actorOrder.push_back(source);
+        for (size_t head = actorOrder.size() - 1; head < actorOrder.size();
+             head++) {
+            unsigned int current = actorOrder[head];
+            for (auto movie = graph.moviesBegin(current);
+                 movie != graph.moviesEnd(current); movie++) {
+                if (movieSeen[*movie]) {
+                    continue;
+                }
+                movieSeen[*movie] = true;
+                movieOrder.push_back(*movie);
+                for (auto actor = graph.actorsBegin(*movie);
+                     actor != graph.actorsEnd(*movie); actor++) {
+                    if (!actorSeen[*actor]) {
+                        actorSeen[*actor] = true;
+                        actorOrder.push_back(*actor);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * This function orders the movies by the new id of
+ * their first actor, ties by old id.
+ *
+ * Parameters:
+ *  1) graph - The graph to order
+ *  2) actorOrder - The actors in their new order
+ *  3) movieOrder - Filled with the movies in order
+ *
+ */
+static void followActors(const CSRGraph& graph,
+                         const vector<unsigned int>& actorOrder,
+                         vector<unsigned int>& movieOrder) {
+    vector<unsigned int> firstActors(graph.numMovies(), CSRGraph::NO_ID);
+    for (unsigned int a = 0; a < actorOrder.size(); a++) {
+        for (auto movie = graph.moviesBegin(actorOrder[a]);
+             movie != graph.moviesEnd(actorOrder[a]); movie++) {
+            firstActors[*movie] = min(firstActors[*movie], a);
+        }
+    }
+    movieOrder.resize(graph.numMovies());
+    for (unsigned int m = 0; m < graph.numMovies(); m++) {
+        movieOrder[m] = m;
+    }
+    stable_sort(movieOrder.begin(), movieOrder.end(),
+                [&firstActors](unsigned int a, unsigned int b) {
+                    return firstActors[a] < firstActors[b];
+                });
+}
+
+/*
+ * This function finds communities of actors by label
+ * propagation. Every actor starts with a label of
+ * its own, then in BFS order takes the label most
+ * common among its co-stars, counted once per shared
+ * movie, keeping its own label on ties.
+ *
+ * Parameters:
+ *  1) graph - The graph to search
+ *  2) bfsActors - The actors in BFS order
+ *  3) labels - Filled with the label of every actor
+ *
+ */
+static void propagateLabels(const CSRGraph& graph,
+                            const vector<unsigned int>& bfsActors,
+                            vector<unsigned int>& labels) {
+    labels.resize(graph.numActors());
+    for (unsigned int a = 0; a < graph.numActors(); a++) {
+        labels[a] = a;
+    }
+    // counts[l] is valid for this actor only if stamps[l] is its stamp
+    vector<unsigned int> counts(graph.numActors(), 0);
+    vector<unsigned int> stamps(graph.numActors(), CSRGraph::NO_ID);
+    unsigned int stamp = 0;
+    for (unsigned int round = 0; round < LABEL_ROUNDS; round++) {
+        for (unsigned int current : bfsActors) {
+            unsigned int best = labels[current];
+            unsigned int bestCount = 0;
+            for (auto movie = graph.moviesBegin(current);
+                 movie != graph.moviesEnd(current); movie++) {
+                for (auto actor = graph.actorsBegin(*movie);
+                     actor != graph.actorsEnd(*movie); actor++) {
+                    unsigned int label = labels[*actor];
+                    if (stamps[label] != stamp) {
+                        stamps[label] = stamp;
+                        counts[label] = 0;
+                    }
+                    counts[label]++;
+                    if (counts[label] > bestCount ||
+                        (counts[label] == bestCount &&
+                         label == labels[current])) {
+                        best = label;
+                        bestCount = counts[label];
+                    }
+                }
+            }
+            labels[current] = best;
+            stamp++;
+        }
+    }
+}
+
+/*
+ * This is the contructor method for the order.
+ * It computes the new ids of every node.
+ *
+ * Parameters:
+ *  1) graph - The graph to order
+ *  2) ordering - Which order to compute
+ *
+ */
+VertexOrder::VertexOrder(const CSRGraph& graph, VertexOrdering ordering) {
+    if (ordering == DEGREE_ORDER) {
+        this->actorOrder = actorsByCoStars(graph);
+        this->movieOrder.resize(graph.numMovies());
+        for (unsigned int m = 0; m < graph.numMovies(); m++) {
+            this->movieOrder[m] = m;
+        }
+        stable_sort(this->movieOrder.begin(), this->movieOrder.end(),
+                    [&graph](unsigned int a, unsigned int b) {
+                        return graph.actorsEnd(a) - graph.actorsBegin(a) >
+                               graph.actorsEnd(b) - graph.actorsBegin(b);
+                    });
+        return;
+    }
+
+    bfsOrder(graph, this->actorOrder, this->movieOrder);
+    if (ordering == BFS_ORDER) {
+        return;
+    }
+
+    // Lay out the communities in the order BFS reaches their first
+    // actor, each in BFS order
+    vector<unsigned int> labels;
+    propagateLabels(graph, this->actorOrder, labels);
+    vector<unsigned int> firstSeen(graph.numActors(), CSRGraph::NO_ID);
+    for (unsigned int i = 0; i < this->actorOrder.size(); i++) {
+        unsigned int label = labels[this->actorOrder[i]];
+        firstSeen[label] = min(firstSeen[label], i);
+    }
+    stable_sort(this->actorOrder.begin(), this->actorOrder.end(),
+                [&labels, &firstSeen](unsigned int a, unsigned int b) {
+                    return firstSeen[labels[a]] < firstSeen[labels[b]];
+                });
+    followActors(graph, this->actorOrder, this->movieOrder);
+}
@@ -0,0 +1,79 @@
+/**
+ * Authors: Matthew Lund and Mohammad Javid
+ * Contact info: mtlund@ucsd.edu (Matthew),
+ *               Msamadpo@ucsd.edu (Mohammad)
+ *
+ * Sources used:
+ *  1) Arai et al., "Rabbit Order: Just-in-time Parallel
+ *     Reordering for Fast Graph Analysis", IPDPS 2016
+ *  2) Raghavan, Albert and Kumara, "Near linear time
+ *     algorithm to detect community structures in
+ *     large-scale networks", Physical Review E 2007
+ *
+ * Description of File:
+ *  This file defines new orders of the actor and movie
+ *  ids meant to put co-stars near each other, so that
+ *  a search touches fewer cache lines.
+ */
+
+#ifndef VERTEXORDER_HPP
+#define VERTEXORDER_HPP
+
+#include <vector>
+#include "CSRGraph.hpp"
+
+using namespace std;
+
+/* The orders the ids of a graph can be given */
+enum VertexOrdering {
+    // The order a BFS from the busiest actors reaches the nodes
+    BFS_ORDER,
+    // The actors with the most co-stars and the largest casts first
+    DEGREE_ORDER,
+    // The actors of each community together, see VertexOrder
+    COMMUNITY_ORDER
+};
+
+/**
+ * The VertexOrder class computes the new order of the
+ * actors and movies of a graph. The community order
+ * finds communities by label propagation, where each
+ * actor takes the label most common among its
+ * co-stars, then lays the communities out one after
+ * the other in BFS order, and each movie follows
+ * the first of its actors.
+ *
+ * Instance variables:
+ *  1) actorOrder - The old id of each new actor id
+ *
+ *  2) movieOrder - The old id of each new movie id
+ */
+class VertexOrder {
+  protected:
+    vector<unsigned int> actorOrder;
+    vector<unsigned int> movieOrder;
+
+  public:
+    /*
+     * This is the contructor method for the order.
+     * It computes the new ids of every node.
+     *
+     * Parameters:
+     *  1) graph - The graph to order
+     *  2) ordering - Which order to compute
+     *
+     */
+    VertexOrder(const CSRGraph& graph, VertexOrdering ordering);
+
+    /* Returns the old id of each new actor id */
+    const vector<unsigned int>& getActorOrder() const {
+        return this->actorOrder;
+    }
+
+    /* Returns the old id of each new movie id */
+    const vector<unsigned int>& getMovieOrder() const {
+        return this->movieOrder;
+    }
+};
+
+#endif  // VERTEXORDER_HPP
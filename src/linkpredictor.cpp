@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 #include "ActorGraph.hpp"
+#include <cxxopts.hpp>
 
 using namespace std;
 
@@ -16,30 +17,94 @@ using namespace std;
 void usage(char* program_name) {
     cerr << program_name << " called with incorrect arguments." << endl;
     cerr << "Usage: " << program_name
+         << " [--score common-neighbors | adamic-adar | jaccard]"
+         << " [--projected] [--compressed] [--threads N]"
          << " movie_cast_file num_prediction query_actor_file link_predictions"
          << endl;
 }
 
 /* Main program that drives the linkpredictor */
 int main(int argc, char* argv[]) {
-    const int NUM_ARG = 5, INPUT_IDX = 1, NUM_PRED = 2, QUERY_IDX = 3,
-              LINK_IDX = 4;
+    cxxopts::Options options(argv[0], "Predict new links between actors");
+    options.positional_help(
+        "movie_cast_file num_prediction query_actor_file link_predictions");
 
-    if (argc != NUM_ARG) {
-        usage(argv[0]);
+    string scoreName = "common-neighbors";
+    unsigned int numPrediction = 0;
+    bool isProjected = false;
+    bool isCompressed = false;
+    unsigned int numThreads = 1;
+    string graphFileName, queryActors, prediction;
+    options.add_options()(
+        "score", "how candidates are ranked: common-neighbors (movies "
+        "shared through common collaborators), adamic-adar or jaccard",
+        cxxopts::value<string>(scoreName))(
+        "projected", "build the actor to actor projection of the graph "
+        "up front and score from its shared movie counts",
+        cxxopts::value<bool>(isProjected))(
+        "compressed", "keep the graph as compressed lists, which take less "
+        "memory; only common-neighbors can be used",
+        cxxopts::value<bool>(isCompressed))(
+        "threads", "number of threads reading the file and building "
+        "the projection",
+        cxxopts::value<unsigned int>(numThreads))(
+        "graph", "", cxxopts::value<string>(graphFileName))(
+        "num", "", cxxopts::value<unsigned int>(numPrediction))(
+        "queries", "", cxxopts::value<string>(queryActors))(
+        "output", "", cxxopts::value<string>(prediction))(
+        "h,help", "Print help and exit");
+    options.parse_positional({"graph", "num", "queries", "output"});
+
+    char* programName = argv[0];
+    try {
+        auto userOptions = options.parse(argc, argv);
+        if (userOptions.count("help")) {
+            cout << options.help({""}) << endl;
+            return 0;
+        }
+    } catch (const cxxopts::OptionException& e) {
+        cerr << e.what() << endl;
+        usage(programName);
         return 1;
     }
 
-    char* graphFileName = argv[INPUT_IDX];
-    unsigned int numPrediction = stoi(argv[NUM_PRED]);
-    char* queryActors = argv[QUERY_IDX];
-    char* prediction = argv[LINK_IDX];
+    LinkScore score;
+    if (scoreName == "common-neighbors") {
+        score = COMMON_NEIGHBORS;
+    } else if (scoreName == "adamic-adar") {
+        score = ADAMIC_ADAR;
+    } else if (scoreName == "jaccard") {
+        score = JACCARD;
+    } else {
+        cerr << "Unknown score " << scoreName << endl;
+        usage(programName);
+        return 1;
+    }
+    if (argc != 1 || prediction.empty() || numThreads == 0 ||
+        (isCompressed && (isProjected || score != COMMON_NEIGHBORS))) {
+        usage(programName);
+        return 1;
+    }
 
     // build the actor graph from the input file
     ActorGraph* graph = new ActorGraph();
     cout << "Reading " << graphFileName << " ..." << endl;
-    if (!graph->buildGraphFromFile(graphFileName)) return 1;
+    if (!graph->buildGraphFromFile(graphFileName.c_str(), numThreads)) {
+        return 1;
+    }
     cout << "Done." << endl;
+    if (isCompressed) {
+        graph->compress();
+    }
+
+    // only common-neighbors can do without the projection
+    if (isProjected || score != COMMON_NEIGHBORS) {
+        const CollaboratorGraph& collaborators =
+            graph->buildCollaborators(numThreads);
+        cout << "Built the collaborator graph: " << collaborators.numLinks()
+             << " links in " << collaborators.memoryUsage() / 1024 << " KB"
+             << endl;
+    }
 
     ifstream infile(queryActors);
     ofstream outfile(prediction);
@@ -72,7 +137,7 @@ int main(int argc, char* argv[]) {
         // write the link predictions
         string actor(record[0]);
         vector<string> predictActors;
-        graph->predictLink(actor, predictActors, numPrediction);
+        graph->predictLink(actor, predictActors, numPrediction, score);
 
         unsigned int i = 0;
         for (auto name : predictActors) {
@@ -1,6 +1,8 @@
 /**
  * CSE 100 PA4 Pathfinder in Actor Graph
  */
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
@@ -9,6 +11,9 @@
 #include <string>
 #include <vector>
 #include "ActorGraph.hpp"
+#include "LocalityBenchmark.hpp"
+#include "PathQueryPool.hpp"
+#include <cxxopts.hpp>
 
 using namespace std;
 
@@ -16,39 +21,418 @@ using namespace std;
 void usage(char* program_name) {
     cerr << program_name << " called with incorrect arguments." << endl;
     cerr << "Usage: " << program_name
+         << " [--bidirectional | --batch | --projected | --weighted |"
+         << " --hybrid | --first-year | --landmarks | --bounds]"
+         << " [--min-year YEAR] [--max-year YEAR] [--threads N]"
+         << " [--snapshot FILE] [--labels FILE]"
+         << " [--num-landmarks K] [--landmark-choice degree|random|farthest]"
+         << " [--reorder bfs|degree|community] [--compressed]"
+         << " [--mega-cast N]"
          << " movie_cast_file actor_pairs_file shortest_paths_file" << endl;
+    cerr << "       " << program_name
+         << " [--threads N] --bacon ACTOR movie_cast_file distances_file"
+         << endl;
+    cerr << "       " << program_name
+         << " [--threads N] [--hll-registers B] --distribution"
+         << " movie_cast_file distribution_file" << endl;
+    cerr << "       " << program_name
+         << " [--threads N] --snapshot FILE movie_cast_file" << endl;
 }
 
 /* Main program that drives the pathfinder */
 int main(int argc, char* argv[]) {
-    const int NUM_ARG = 4, INPUT_IDX = 1, PAIR_IDX = 2, OUT_IDX = 3,
-              PAIR_SIZE = 2;
+    const int PAIR_SIZE = 2;
 
-    if (argc != NUM_ARG) {
-        usage(argv[0]);
+    cxxopts::Options options(argv[0], "Find shortest paths between actors");
+    options.positional_help(
+        "movie_cast_file actor_pairs_file shortest_paths_file");
+
+    bool isBidirectional = false;
+    bool isBatch = false;
+    bool isProjected = false;
+    bool isWeighted = false;
+    bool isFirstYear = false;
+    bool isHybrid = false;
+    bool isLandmarks = false;
+    bool isBounds = false;
+    bool isCompressed = false;
+    bool isDistribution = false;
+    unsigned int numLandmarks = LandmarkOracle::DEFAULT_LANDMARKS;
+    string landmarkChoice = "degree";
+    string reorderName;
+    string baconName;
+    unsigned int megaCast = CastBitsets::DEFAULT_MIN_CAST;
+    unsigned int hllRegisters = DistanceDistribution::DEFAULT_LOG2_REGISTERS;
+    unsigned int numThreads = 1;
+    YearRange years = ALL_YEARS;
+    string graphFileName, pairs, output, snapshotName, labelsName;
+    options.add_options()(
+        "bidirectional", "search from both actors of each pair at once",
+        cxxopts::value<bool>(isBidirectional))(
+        "batch", "search from up to 64 first actors of the pairs at once",
+        cxxopts::value<bool>(isBatch))(
+        "projected", "search the actor to actor projection of the graph",
+        cxxopts::value<bool>(isProjected))(
+        "weighted", "find the cheapest paths, where a movie costs "
+        "1 + (newest year - its year)",
+        cxxopts::value<bool>(isWeighted))(
+        "hybrid", "search with bitmap frontiers, switching between top "
+        "down and bottom up steps",
+        cxxopts::value<bool>(isHybrid))(
+        "first-year", "write the first year each pair was connected "
+        "instead of a path",
+        cxxopts::value<bool>(isFirstYear))(
+        "landmarks", "search with a BFS that skips the actors the landmark "
+        "bounds rule out",
+        cxxopts::value<bool>(isLandmarks))(
+        "bounds", "write lower and upper bounds on the number of movies "
+        "between each pair instead of a path",
+        cxxopts::value<bool>(isBounds))(
+        "num-landmarks", "number of landmarks used to bound distances",
+        cxxopts::value<unsigned int>(numLandmarks))(
+        "landmark-choice", "how to choose the landmarks: degree, random or "
+        "farthest",
+        cxxopts::value<string>(landmarkChoice))(
+        "reorder", "renumber the actors and movies for fewer cache misses: "
+        "bfs, degree or community",
+        cxxopts::value<string>(reorderName))(
+        "compressed", "keep the graph as compressed lists, which take less "
+        "memory but only allow the default search",
+        cxxopts::value<bool>(isCompressed))(
+        "mega-cast", "keep the casts of at least this many actors as "
+        "bitsets, which the default search reaches a word at a time; "
+        "none are kept unless this is given",
+        cxxopts::value<unsigned int>(megaCast))(
+        "bacon", "write the number of movies between this actor and every "
+        "actor, given a distances file in place of the pairs and paths",
+        cxxopts::value<string>(baconName))(
+        "distribution", "estimate how many pairs of actors are each number "
+        "of movies apart, given a distribution file in place of the pairs "
+        "and paths",
+        cxxopts::value<bool>(isDistribution))(
+        "hll-registers", "log2 of the registers of each counter of the "
+        "distribution, from 4 to 12; each one more doubles the memory and "
+        "cuts the error by 30%",
+        cxxopts::value<unsigned int>(hllRegisters))(
+        "min-year", "only use the movies from this year on",
+        cxxopts::value<int>(years.minYear))(
+        "max-year", "only use the movies up to this year",
+        cxxopts::value<int>(years.maxYear))(
+        "threads", "number of threads reading the file and answering the pairs",
+        cxxopts::value<unsigned int>(numThreads))(
+        "snapshot", "write a snapshot of the graph, which can be given "
+        "in place of the cast file to start faster",
+        cxxopts::value<string>(snapshotName))(
+        "labels", "answer the pairs from the distance labels read from "
+        "this file, building and writing them if it is missing or stale",
+        cxxopts::value<string>(labelsName))(
+        "graph", "", cxxopts::value<string>(graphFileName))(
+        "pairs", "", cxxopts::value<string>(pairs))(
+        "output", "", cxxopts::value<string>(output))("h,help",
+                                                      "Print help and exit");
+    options.parse_positional({"graph", "pairs", "output"});
+
+    char* programName = argv[0];
+    try {
+        auto userOptions = options.parse(argc, argv);
+        if (userOptions.count("help")) {
+            cout << options.help({""}) << endl;
+            return 0;
+        }
+    } catch (const cxxopts::OptionException& e) {
+        cerr << e.what() << endl;
+        usage(programName);
+        return 1;
+    }
+    // Only writing a snapshot needs no pairs
+    bool onlySnapshot = !snapshotName.empty() && pairs.empty();
+    // The distances from one actor and the distribution are written
+    // where the pairs would be read from
+    bool writesInPlaceOfPairs = !baconName.empty() || isDistribution;
+    if (writesInPlaceOfPairs) {
+        output.swap(pairs);
+    }
+    // At most one way of searching can be asked for
+    int numSearches = isBidirectional + isBatch + isProjected + isWeighted +
+                      isHybrid + isFirstYear + !labelsName.empty() +
+                      isLandmarks + isBounds + !baconName.empty() +
+                      isDistribution;
+    LandmarkChoice choice = DEGREE_LANDMARKS;
+    bool isKnownChoice = landmarkChoice == "degree";
+    if (landmarkChoice == "random") {
+        choice = RANDOM_LANDMARKS;
+        isKnownChoice = true;
+    } else if (landmarkChoice == "farthest") {
+        choice = FARTHEST_LANDMARKS;
+        isKnownChoice = true;
+    }
+    VertexOrdering ordering = BFS_ORDER;
+    bool isKnownOrder = reorderName.empty() || reorderName == "bfs";
+    if (reorderName == "degree") {
+        ordering = DEGREE_ORDER;
+        isKnownOrder = true;
+    } else if (reorderName == "community") {
+        ordering = COMMUNITY_ORDER;
+        isKnownOrder = true;
+    }
+    if (argc != 1 || graphFileName.empty() || numThreads == 0 ||
+        (output.empty() && !onlySnapshot) || numSearches > 1 ||
+        (!years.isAll() && numSearches > 0) || years.minYear > years.maxYear ||
+        (isCompressed && (numSearches > 0 || !years.isAll())) ||
+        numLandmarks == 0 || megaCast == 0 ||
+        (writesInPlaceOfPairs && (!pairs.empty() || output.empty())) ||
+        hllRegisters < DistanceDistribution::MIN_LOG2_REGISTERS ||
+        hllRegisters > DistanceDistribution::MAX_LOG2_REGISTERS ||
+        !isKnownChoice || !isKnownOrder) {
+        usage(programName);
         return 1;
     }
-
-    char* graphFileName = argv[INPUT_IDX];
-    char* pairs = argv[PAIR_IDX];
-    char* output = argv[OUT_IDX];
 
     // build the actor graph from the input file
     ActorGraph* graph = new ActorGraph();
     cout << "Reading " << graphFileName << " ..." << endl;
-    if (!graph->buildGraphFromFile(graphFileName)) return 1;
+    if (!graph->buildGraphFromFile(graphFileName.c_str(), numThreads)) {
+        return 1;
+    }
     cout << "Done." << endl;
+    const ActorComponents& components = graph->getComponents();
+    if (components.numComponents() > 0) {
+        cout << components.numComponents() << " components, the largest with "
+             << components.getSize(components.getLargest()) << " actors, "
+             << components.getNumSingletons() << " actors alone" << endl;
+    }
+
+    // the same actors are searched from before and after renumbering
+    if (!reorderName.empty()) {
+        const unsigned int NUM_SOURCES = 8;
+        unsigned int numActors = graph->getCSR().numActors();
+        vector<string> sourceNames;
+        vector<unsigned int> sources;
+        for (unsigned int i = 0; i < NUM_SOURCES && numActors > 0; i++) {
+            sources.push_back((unsigned int)((uint64_t)i * numActors /
+                                             NUM_SOURCES));
+            sourceNames.push_back(graph->getActorName(sources.back()));
+        }
+        LocalityBenchmark before;
+        before.run(graph->getCSR(), sources);
+
+        auto start = chrono::steady_clock::now();
+        graph->reorder(ordering, numThreads);
+        auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+            chrono::steady_clock::now() - start);
+        for (unsigned int i = 0; i < sources.size(); i++) {
+            sources[i] = graph->getActorId(sourceNames[i]);
+        }
+        LocalityBenchmark after;
+        after.run(graph->getCSR(), sources);
+
+        cout << "Reordered by " << reorderName << " in " << elapsed.count()
+             << " ms: simulated cache misses per BFS "
+             << before.getNumMisses() / max((size_t)1, sources.size())
+             << " -> "
+             << after.getNumMisses() / max((size_t)1, sources.size());
+        if (before.getNumMisses() > 0) {
+            long long saved = 100 - (long long)(100 * after.getNumMisses() /
+                                                before.getNumMisses());
+            cout << " (" << saved << "% fewer)";
+        }
+        cout << ", BFS time " << (long)before.getMilliseconds() << " -> "
+             << (long)after.getMilliseconds() << " ms" << endl;
+    }
+    if (!snapshotName.empty()) {
+        if (!graph->saveSnapshot(snapshotName.c_str())) {
+            cerr << "Failed to write " << snapshotName << endl;
+            delete graph;
+            return 1;
+        }
+        cout << "Wrote snapshot " << snapshotName << endl;
+    }
+    if (onlySnapshot) {
+        delete graph;
+        return 0;
+    }
+    // the distribution of the distances is written instead of any path
+    if (isDistribution) {
+        DistanceDistribution distribution(hllRegisters);
+        auto start = chrono::steady_clock::now();
+        graph->distanceDistribution(distribution, numThreads);
+        auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+            chrono::steady_clock::now() - start);
+        cout << "Estimated the distance distribution in " << elapsed.count()
+             << " ms with " << distribution.getNumRegisters()
+             << " registers per actor in "
+             << distribution.memoryUsage() / 1024 << " KB, +/- "
+             << (long)(2000 * distribution.getRelativeError() + 0.5) / 10.0
+             << "% at 2 sigma"
+             << endl;
+        cout << "About " << (long long)distribution.getConnectedPairs()
+             << " connected pairs, average distance "
+             << distribution.getAverageDistance() << " movies, effective "
+             << "diameter " << distribution.getEffectiveDiameter()
+             << ", largest distance " << distribution.getMaxDistance()
+             << endl;
+
+        // N(t) counts every actor with itself, like the pairs at 0 movies
+        ofstream outfile(output);
+        outfile << "Distance\tPairs\tWithin\tWithinLower\tWithinUpper"
+                << endl;
+        for (unsigned int t = 0; t <= distribution.getMaxDistance(); t++) {
+            outfile << t << '\t' << (long long)distribution.getPairs(t)
+                    << '\t'
+                    << (long long)distribution.getNeighbourhood()[t] << '\t'
+                    << (long long)distribution.getLower(t) << '\t'
+                    << (long long)distribution.getUpper(t) << endl;
+        }
+        outfile.close();
+        delete graph;
+        return 0;
+    }
+    // the distances from one actor are written instead of any path
+    if (!baconName.empty()) {
+        const unsigned int NUM_FARTHEST = 10;
+        BaconNumbers numbers;
+        auto start = chrono::steady_clock::now();
+        if (!graph->baconNumbers(baconName, numbers, numThreads)) {
+            cerr << baconName << " is not in " << graphFileName << endl;
+            delete graph;
+            return 1;
+        }
+        auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+            chrono::steady_clock::now() - start);
+        const vector<unsigned int>& distances = numbers.getDistances();
+        cout << "Found the distances from " << baconName << " in "
+             << elapsed.count() << " ms: " << numbers.getNumReached()
+             << " actors connected, "
+             << distances.size() - numbers.getNumReached()
+             << " not connected" << endl;
+        const vector<size_t>& histogram = numbers.getHistogram();
+        for (unsigned int d = 0; d < histogram.size(); d++) {
+            cout << "  " << d << " movies: " << histogram[d] << " actors"
+                 << endl;
+        }
+        const vector<unsigned int>& farthest = numbers.getFarthest();
+        cout << "Farthest at " << numbers.getMaxDistance() << " movies:";
+        for (unsigned int i = 0; i < farthest.size() && i < NUM_FARTHEST;
+             i++) {
+            cout << (i == 0 ? " " : ", ") << graph->getActorName(farthest[i]);
+        }
+        if (farthest.size() > NUM_FARTHEST) {
+            cout << " and " << farthest.size() - NUM_FARTHEST << " more";
+        }
+        cout << endl;
+
+        // the distance is blank for the actors that are not connected
+        ofstream outfile(output);
+        outfile << "Actor/Actress\tDistance" << endl;
+        for (unsigned int a = 0; a < distances.size(); a++) {
+            outfile << graph->getActorName(a) << '\t';
+            if (distances[a] != BaconNumbers::NO_DISTANCE) {
+                outfile << distances[a];
+            }
+            outfile << '\n';
+        }
+        outfile.close();
+        delete graph;
+        return 0;
+    }
+    // the largest casts are kept as bitsets for the default search
+    if (!isCompressed && megaCast != CastBitsets::DEFAULT_MIN_CAST) {
+        const CastBitsets& bitsets = graph->buildCastBitsets(megaCast);
+        cout << bitsets.size() << " casts of at least " << bitsets.getMinCast()
+             << " actors kept as bitsets in " << bitsets.memoryUsage() / 1024
+             << " KB" << endl;
+    }
+    if (isCompressed) {
+        const CSRGraph& csr = graph->getCSR();
+        size_t plainSize =
+            sizeof(unsigned int) * (csr.numActors() + csr.numMovies() + 2 +
+                                    2 * csr.numEdges()) +
+            sizeof(int) * csr.numMovies();
+        graph->compress();
+        cout << "Compressed the graph to "
+             << graph->getCompressed()->memoryUsage() / 1024 << " KB from "
+             << plainSize / 1024 << " KB" << endl;
+    }
+
+    // the projection is built once, before any pair is searched
+    PathSearch search = FORWARD_SEARCH;
+    if (isBidirectional) {
+        search = BIDIRECTIONAL_SEARCH;
+    } else if (isWeighted) {
+        search = WEIGHTED_SEARCH;
+    } else if (isHybrid) {
+        search = HYBRID_SEARCH;
+    } else if (isProjected) {
+        const CollaboratorGraph& collaborators =
+            graph->buildCollaborators(numThreads);
+        cout << "Built the collaborator graph: " << collaborators.numLinks()
+             << " links in " << collaborators.memoryUsage() / 1024 << " KB"
+             << endl;
+        search = PROJECTED_SEARCH;
+    } else if (!labelsName.empty()) {
+        if (graph->loadLabels(labelsName.c_str())) {
+            cout << "Read the distance labels from " << labelsName << endl;
+        } else {
+            auto start = chrono::steady_clock::now();
+            const PrunedLabelIndex& labels = graph->buildLabels(numThreads);
+            auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+                chrono::steady_clock::now() - start);
+            cout << "Built the distance labels in " << elapsed.count()
+                 << " ms: " << labels.numEntries() << " entries in "
+                 << labels.memoryUsage() / 1024 << " KB" << endl;
+            if (!graph->saveLabels(labelsName.c_str())) {
+                cerr << "Failed to write " << labelsName << endl;
+            }
+        }
+        search = INDEXED_SEARCH;
+    }
+
+    // the landmarks are built once, before any pair is searched
+    if (isLandmarks || isBounds) {
+        auto start = chrono::steady_clock::now();
+        const LandmarkOracle& landmarks =
+            graph->buildLandmarks(numLandmarks, choice, numThreads);
+        auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+            chrono::steady_clock::now() - start);
+        cout << "Built " << landmarks.size() << " landmarks in "
+             << elapsed.count() << " ms: " << landmarks.memoryUsage() / 1024
+             << " KB" << endl;
+        search = LANDMARK_SEARCH;
+    }
+
+    // the movies are sorted by year once, before any pair is searched
+    if (!years.isAll()) {
+        graph->buildYearIndex(numThreads);
+    }
 
     // write the shorest path of each given pair to the output file
     ifstream infile(pairs);
     ofstream outfile(output);
     bool haveHeader = false;
+    vector<pair<string, string>> batchPairs;
+    // with more than one thread the pairs are answered by a pool of workers
+    // that still writes the paths in input order
+    PathQueryPool* pool = nullptr;
+    if (numThreads > 1 && !isBatch && !isFirstYear && !isBounds) {
+        pool = new PathQueryPool(graph, outfile, numThreads, search, years);
+    }
 
     while (infile) {
         string s;
         if (!getline(infile, s)) break;
 
         // skip reading the header in inFile and output the header in outFile
+        if (!haveHeader && isFirstYear) {
+            outfile << "Actor1/Actress1\tActor2/Actress2\tYear" << endl;
+            haveHeader = true;
+            continue;
+        }
+        if (!haveHeader && isBounds) {
+            outfile << "Actor1/Actress1\tActor2/Actress2\tLower\tUpper"
+                    << endl;
+            haveHeader = true;
+            continue;
+        }
         if (!haveHeader) {
             outfile << "(actor)--[movie#@year]-->(actor)--..." << endl;
             haveHeader = true;
@@ -72,14 +456,70 @@ int main(int argc, char* argv[]) {
         string actor1(actorPair[0]);
         string actor2(actorPair[1]);
 
+        // in batch mode the paths are found once every pair is read
+        if (isBatch || isFirstYear) {
+            batchPairs.push_back(make_pair(actor1, actor2));
+            continue;
+        }
+        // the bounds are blank for an unknown actor, and the lower one
+        // for actors that are not connected, the upper one if unknown
+        if (isBounds) {
+            unsigned int lower;
+            unsigned int upper;
+            outfile << actor1 << '\t' << actor2 << '\t';
+            if (graph->distanceBounds(actor1, actor2, lower, upper)) {
+                if (lower != LandmarkOracle::NO_DISTANCE) {
+                    outfile << lower;
+                }
+                outfile << '\t';
+                if (upper != LandmarkOracle::NO_DISTANCE) {
+                    outfile << upper;
+                }
+            } else {
+                outfile << '\t';
+            }
+            outfile << endl;
+            continue;
+        }
+        if (pool != nullptr) {
+            pool->submit(actor1, actor2);
+            continue;
+        }
+
         // output the shorest path for each line
         string shortestPath = "";
-        graph->BFS(actor1, actor2, shortestPath);
+        graph->BFS(actor1, actor2, shortestPath, search, years);
         if (shortestPath.length() > 0) {
             outfile << shortestPath;
         }
         outfile << endl;
     }
+
+    // output the shortest path of each pair of the batch, in order
+    if (isBatch) {
+        vector<string> shortestPaths;
+        graph->BFS(batchPairs, shortestPaths, numThreads);
+        for (const string& shortestPath : shortestPaths) {
+            outfile << shortestPath << endl;
+        }
+    }
+    // output the year each pair was first connected, in order
+    if (isFirstYear) {
+        vector<int> years;
+        graph->firstConnectionYears(batchPairs, years);
+        for (size_t i = 0; i < batchPairs.size(); i++) {
+            outfile << batchPairs[i].first << '\t' << batchPairs[i].second
+                    << '\t';
+            if (years[i] != ActorGraph::NO_YEAR) {
+                outfile << years[i];
+            }
+            outfile << endl;
+        }
+    }
+    if (pool != nullptr) {
+        pool->finish();
+        delete pool;
+    }
     outfile.close();
     infile.close();
     delete graph;
@@ -1,6 +1,1209 @@
 #include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "ActorGraph.hpp"
+#include "Arena.hpp"
+#include "BaconNumbers.hpp"
+#include "CastBitsets.hpp"
+#include "CastFileReader.hpp"
+#include "CompressedGraph.hpp"
+#include "DisjointSets.hpp"
+#include "DistanceDistribution.hpp"
+#include "HybridBFS.hpp"
+#include "LandmarkOracle.hpp"
+#include "LocalityBenchmark.hpp"
+#include "NameTable.hpp"
+#include "PathQueryPool.hpp"
+#include "PrunedLabelIndex.hpp"
+#include "SearchWorkspace.hpp"
+#include "SortedIntersection.hpp"
+#include "VertexOrder.hpp"
 
 using namespace std;
 using namespace testing;
 
-// TODO: add tests for actor graph
\ No newline at end of file
+/* Writes the cast file used by the tests and returns its name */
+static string writeCastFile() {
+    string fileName = TempDir() + "test_ActorGraph_cast.tsv";
+    ofstream out(fileName);
+    out << "Actor/Actress\tMovie\tYear\n"
+        << "Kevin Bacon\tX-Men: First Class\t2011\n"
+        << "James McAvoy\tX-Men: First Class\t2011\n"
+        << "James McAvoy\tX-Men: Apocalypse\t2016\n"
+        << "James McAvoy\tGlass\t2019\n"
+        << "Michael Fassbender\tX-Men: First Class\t2011\n"
+        << "Michael Fassbender\tX-Men: Apocalypse\t2016\n"
+        << "Michael Fassbender\tAlien: Covenant\t2017\n"
+        << "Samuel L. Jackson\tGlass\t2019\n"
+        << "Samuel L. Jackson\tAvengers: Endgame\t2019\n"
+        << "Robert Downey Jr.\tAvengers: Endgame\t2019\n"
+        << "Robert Downey Jr.\tSpider-Man: Homecoming\t2017\n"
+        << "Tom Holland\tSpider-Man: Homecoming\t2017\n"
+        << "Tom Holland\tThe Current War\t2017\n"
+        << "Katherine Waterston\tAlien: Covenant\t2017\n"
+        << "Katherine Waterston\tThe Current War\t2017\n"
+        << "Lonely Actor\tNobody Watched This\t1999\n";
+    return fileName;
+}
+
+/* Writes a cast file where actor i and actor i + 1 share movie i */
+static string writeChainCastFile(unsigned int numActors) {
+    string fileName = TempDir() + "test_ActorGraph_chain.tsv";
+    ofstream out(fileName);
+    out << "Actor/Actress\tMovie\tYear\n";
+    for (unsigned int i = 0; i + 1 < numActors; i++) {
+        out << "Actor " << i << "\tMovie " << i << "\t2000\n";
+        out << "Actor " << i + 1 << "\tMovie " << i << "\t2000\n";
+    }
+    return fileName;
+}
+
+/* Writes a cast file that adds one actor and one movie to writeCastFile */
+static string writeSecondCastFile() {
+    string fileName = TempDir() + "test_ActorGraph_second.tsv";
+    ofstream out(fileName);
+    out << "Actor/Actress\tMovie\tYear\n"
+        << "Zoe Newcomer\tGlass\t2019\n"
+        << "Zoe Newcomer\tNew Movie\t2020\n"
+        << "Lonely Actor\tNew Movie\t2020\n";
+    return fileName;
+}
+
+class SmallActorGraphFixture : public ::testing::Test {
+  protected:
+    ActorGraph graph;
+
+  public:
+    SmallActorGraphFixture() {
+        graph.buildGraphFromFile(writeCastFile().c_str());
+    }
+};
+
+TEST_F(SmallActorGraphFixture, TEST_BFS_DIRECT_COSTARS) {
+    string path;
+    graph.BFS("Kevin Bacon", "James McAvoy", path);
+    ASSERT_EQ(path,
+              "(Kevin Bacon)--[X-Men: First Class#@2011]-->(James McAvoy)");
+}
+
+TEST_F(SmallActorGraphFixture, TEST_BFS_SHORTEST_PATH) {
+    string path;
+    graph.BFS("Kevin Bacon", "Tom Holland", path);
+    ASSERT_EQ(path,
+              "(Kevin Bacon)--[X-Men: First Class#@2011]-->(Michael "
+              "Fassbender)--[Alien: Covenant#@2017]-->(Katherine "
+              "Waterston)--[The Current War#@2017]-->(Tom Holland)");
+}
+
+TEST_F(SmallActorGraphFixture, TEST_BFS_SAME_ACTOR) {
+    string path;
+    graph.BFS("Tom Holland", "Tom Holland", path);
+    ASSERT_EQ(path, "(Tom Holland)");
+}
+
+TEST_F(SmallActorGraphFixture, TEST_BFS_NO_PATH) {
+    string path;
+    graph.BFS("Kevin Bacon", "Lonely Actor", path);
+    ASSERT_EQ(path, "");
+    graph.BFS("Kevin Bacon", "Not An Actor", path);
+    ASSERT_EQ(path, "");
+    graph.BFS("", "Kevin Bacon", path);
+    ASSERT_EQ(path, "");
+}
+
+TEST_F(SmallActorGraphFixture, TEST_PREDICT_LINK) {
+    vector<string> predictions;
+    graph.predictLink("Samuel L. Jackson", predictions, 3);
+    // Fassbender shares two movies with McAvoy, the rest tie on one
+    ASSERT_EQ(predictions, vector<string>({"Michael Fassbender", "Kevin Bacon",
+                                           "Tom Holland"}));
+    graph.predictLink("Samuel L. Jackson", predictions, 1);
+    ASSERT_EQ(predictions, vector<string>({"Michael Fassbender"}));
+    graph.predictLink("Kevin Bacon", predictions, 5);
+    ASSERT_EQ(predictions,
+              vector<string>({"Katherine Waterston", "Samuel L. Jackson"}));
+    graph.predictLink("Lonely Actor", predictions, 5);
+    ASSERT_TRUE(predictions.empty());
+    graph.predictLink("Not An Actor", predictions, 5);
+    ASSERT_TRUE(predictions.empty());
+}
+
+TEST_F(SmallActorGraphFixture, TEST_PREDICT_LINK_SET_SCORES) {
+    vector<string> predictions;
+    // Jaccard: Kevin and Tom share 1 of 3 collaborators, Fassbender 1 of 4
+    graph.predictLink("Samuel L. Jackson", predictions, 3, JACCARD);
+    ASSERT_EQ(predictions, vector<string>({"Kevin Bacon", "Tom Holland",
+                                           "Michael Fassbender"}));
+    // Adamic-Adar: Robert Downey Jr. has fewer collaborators than McAvoy
+    graph.predictLink("Samuel L. Jackson", predictions, 3, ADAMIC_ADAR);
+    ASSERT_EQ(predictions, vector<string>({"Tom Holland", "Kevin Bacon",
+                                           "Michael Fassbender"}));
+    graph.predictLink("Not An Actor", predictions, 3, JACCARD);
+    ASSERT_TRUE(predictions.empty());
+}
+
+TEST_F(SmallActorGraphFixture, TEST_COLLABORATOR_GRAPH) {
+    const CollaboratorGraph& collaborators = graph.buildCollaborators(2);
+    unsigned int mcAvoy = graph.getActorId("James McAvoy");
+    unsigned int fassbender = graph.getActorId("Michael Fassbender");
+    ASSERT_EQ(collaborators.degree(mcAvoy), 3u);
+    const unsigned int* link = find(collaborators.begin(mcAvoy),
+                                    collaborators.end(mcAvoy), fassbender);
+    ASSERT_NE(link, collaborators.end(mcAvoy));
+    const Collaboration& both = collaborators.collaborationsBegin(
+        mcAvoy)[link - collaborators.begin(mcAvoy)];
+    ASSERT_EQ(both.sharedMovies, 2u);
+    ASSERT_EQ(both.firstYear, 2011);
+    ASSERT_EQ(both.lastYear, 2016);
+
+    // The projection gives the same predictions as the movies
+    vector<string> predictions;
+    graph.predictLink("Samuel L. Jackson", predictions, 3);
+    ASSERT_EQ(predictions, vector<string>({"Michael Fassbender", "Kevin Bacon",
+                                           "Tom Holland"}));
+
+    string path;
+    graph.BFS("Kevin Bacon", "Tom Holland", path, PROJECTED_SEARCH);
+    ASSERT_EQ(path,
+              "(Kevin Bacon)--[X-Men: First Class#@2011]-->(Michael "
+              "Fassbender)--[Alien: Covenant#@2017]-->(Katherine "
+              "Waterston)--[The Current War#@2017]-->(Tom Holland)");
+    path.clear();
+    graph.BFS("Kevin Bacon", "Lonely Actor", path, PROJECTED_SEARCH);
+    ASSERT_EQ(path, "");
+}
+
+TEST(SortedIntersectionTests, TEST_MATCHES_SCALAR_MERGE) {
+    srand(7);
+    vector<pair<unsigned int, unsigned int>> sizes = {
+        {0, 5}, {3, 3}, {17, 40}, {64, 64}, {100, 1000}, {5, 5000}, {999, 3}};
+    for (auto size : sizes) {
+        vector<unsigned int> lists[2];
+        unsigned int lengths[2] = {size.first, size.second};
+        for (unsigned int l = 0; l < 2; l++) {
+            for (unsigned int i = 0; i < lengths[l]; i++) {
+                lists[l].push_back(rand() % (4 * (size.first + size.second)));
+            }
+            sort(lists[l].begin(), lists[l].end());
+            lists[l].erase(unique(lists[l].begin(), lists[l].end()),
+                           lists[l].end());
+        }
+        vector<unsigned int> expected(min(lists[0].size(), lists[1].size()));
+        vector<unsigned int> actual(expected.size());
+        size_t numExpected = intersectSortedScalar(
+            lists[0].data(), lists[0].size(), lists[1].data(), lists[1].size(),
+            expected.data());
+        size_t numActual =
+            intersectSorted(lists[0].data(), lists[0].size(), lists[1].data(),
+                            lists[1].size(), actual.data());
+        ASSERT_EQ(numActual, numExpected);
+        ASSERT_EQ(actual, expected);
+        ASSERT_EQ(intersectSorted(lists[1].data(), lists[1].size(),
+                                  lists[0].data(), lists[0].size(), nullptr),
+                  numExpected);
+    }
+}
+
+TEST(NameTableTests, TEST_INTERN_DENSE_IDS) {
+    NameTable table;
+    ASSERT_EQ(table.intern("a"), 0);
+    ASSERT_EQ(table.intern("b"), 1);
+    ASSERT_EQ(table.intern("a"), 0);
+    ASSERT_EQ(table.size(), 2);
+    ASSERT_STREQ(table.getName(1), "b");
+    ASSERT_EQ(table.find("b"), 1);
+    ASSERT_EQ(table.find("c"), NameTable::NO_ID);
+
+    // A mapped table takes new names after its own
+    const char chars[] = "x\0yz\0";
+    const uint64_t offsets[] = {0, 2, 5};
+    const unsigned int slots[] = {NameTable::NO_ID, NameTable::NO_ID,
+                                  NameTable::NO_ID, NameTable::NO_ID};
+    NameTable mapped;
+    mapped.map(chars, offsets, 2, slots, 4);
+    ASSERT_EQ(mapped.intern("yz"), 1);
+    ASSERT_EQ(mapped.intern("w"), 2);
+    ASSERT_STREQ(mapped.getName(0), "x");
+    ASSERT_EQ(mapped.find("w"), 2);
+}
+
+TEST_F(SmallActorGraphFixture, TEST_IDS_FOLLOW_FILE_ORDER) {
+    ASSERT_EQ(graph.numActors(), 8);
+    ASSERT_EQ(graph.numMovies(), 8);
+    ASSERT_EQ(graph.getActorId("Kevin Bacon"), 0);
+    ASSERT_STREQ(graph.getActorName(1), "James McAvoy");
+    ASSERT_STREQ(graph.getMovieName(0), "X-Men: First Class#@2011");
+    ASSERT_EQ(graph.getActorId("Not An Actor"), NameTable::NO_ID);
+
+    vector<unsigned int> actorIds;
+    vector<unsigned int> movieIds;
+    ASSERT_TRUE(graph.findPath(0, 1, actorIds, movieIds));
+    ASSERT_EQ(actorIds, vector<unsigned int>({0, 1}));
+    ASSERT_EQ(movieIds, vector<unsigned int>({0}));
+}
+
+TEST(TwoFileTests, TEST_SECOND_FILE_ADDS_TO_GRAPH) {
+    string secondName = writeSecondCastFile();
+    for (unsigned int numThreads : {1, 4}) {
+        for (bool isCompressed : {false, true}) {
+            ActorGraph graph;
+            ASSERT_TRUE(
+                graph.buildGraphFromFile(writeCastFile().c_str(), numThreads));
+            if (isCompressed) {
+                graph.compress();
+            }
+            ASSERT_TRUE(
+                graph.buildGraphFromFile(secondName.c_str(), numThreads));
+            ASSERT_EQ(graph.numActors(), 9);
+            ASSERT_EQ(graph.numMovies(), 9);
+            ASSERT_EQ(graph.getActorId("Zoe Newcomer"), 8);
+            string path;
+            graph.BFS("Lonely Actor", "Kevin Bacon", path);
+            ASSERT_EQ(path,
+                      "(Lonely Actor)--[New Movie#@2020]-->(Zoe Newcomer)--"
+                      "[Glass#@2019]-->(James McAvoy)--[X-Men: First "
+                      "Class#@2011]-->(Kevin Bacon)");
+            ASSERT_EQ(graph.getComponents().numComponents(), 1u);
+        }
+    }
+}
+
+TEST_F(SmallActorGraphFixture, TEST_BIDIRECTIONAL_BFS) {
+    string path;
+    string bidirectionalPath;
+    graph.BFS("Kevin Bacon", "Tom Holland", path);
+    graph.BFS("Kevin Bacon", "Tom Holland", bidirectionalPath,
+              BIDIRECTIONAL_SEARCH);
+    ASSERT_EQ(bidirectionalPath, path);
+    graph.BFS("Tom Holland", "Tom Holland", bidirectionalPath,
+              BIDIRECTIONAL_SEARCH);
+    ASSERT_EQ(bidirectionalPath, "(Tom Holland)");
+
+    vector<unsigned int> actorIds;
+    vector<unsigned int> movieIds;
+    unsigned int lonely = graph.getActorId("Lonely Actor");
+    ASSERT_FALSE(graph.findPathBidirectional(0, lonely, actorIds, movieIds));
+    ASSERT_TRUE(actorIds.empty());
+}
+
+TEST_F(SmallActorGraphFixture, TEST_WEIGHTED_PATH) {
+    // Movies from 2019 cost 1 and older ones 1 more per year, so the
+    // four recent movies beat the three older ones
+    ASSERT_EQ(graph.getMovieWeight(0), 9u);
+    string path;
+    graph.BFS("Kevin Bacon", "Tom Holland", path, WEIGHTED_SEARCH);
+    ASSERT_EQ(path,
+              "(Kevin Bacon)--[X-Men: First Class#@2011]-->(James "
+              "McAvoy)--[Glass#@2019]-->(Samuel L. "
+              "Jackson)--[Avengers: Endgame#@2019]-->(Robert Downey "
+              "Jr.)--[Spider-Man: Homecoming#@2017]-->(Tom Holland)");
+    graph.BFS("Tom Holland", "Tom Holland", path, WEIGHTED_SEARCH);
+    ASSERT_EQ(path, "(Tom Holland)");
+
+    vector<unsigned int> actorIds;
+    vector<unsigned int> movieIds;
+    unsigned int lonely = graph.getActorId("Lonely Actor");
+    ASSERT_FALSE(graph.findPathWeighted(0, lonely, actorIds, movieIds));
+}
+
+TEST_F(SmallActorGraphFixture, TEST_FIRST_CONNECTION_YEARS) {
+    vector<pair<string, string>> pairs = {
+        {"Kevin Bacon", "Tom Holland"},  {"Tom Holland", "Kevin Bacon"},
+        {"Kevin Bacon", "James McAvoy"}, {"Kevin Bacon", "Samuel L. Jackson"},
+        {"Kevin Bacon", "Kevin Bacon"},  {"Kevin Bacon", "Lonely Actor"},
+        {"Kevin Bacon", "Not An Actor"}};
+    vector<int> years;
+    graph.firstConnectionYears(pairs, years);
+    // Alien: Covenant and The Current War link Kevin to Tom in 2017
+    ASSERT_EQ(years, vector<int>({2017, 2017, 2011, 2019, 2011,
+                                  ActorGraph::NO_YEAR, ActorGraph::NO_YEAR}));
+}
+
+TEST_F(SmallActorGraphFixture, TEST_COMPONENTS) {
+    const ActorComponents& components = graph.getComponents();
+    ASSERT_EQ(components.numComponents(), 2u);
+    ASSERT_EQ(components.getLargest(), 0u);
+    ASSERT_EQ(components.getSize(0), 7u);
+    ASSERT_EQ(components.getNumSingletons(), 1u);
+    unsigned int lonely = graph.getActorId("Lonely Actor");
+    ASSERT_EQ(components.getComponent(lonely), 1u);
+    ASSERT_FALSE(components.areConnected(0, lonely));
+    ASSERT_TRUE(components.areConnected(0, graph.getActorId("Tom Holland")));
+}
+
+TEST(ComponentTests, TEST_SAME_COMPONENTS_FOR_ANY_THREAD_COUNT) {
+    // Pairs of actors share a movie, and every tenth movie links the
+    // pairs of a run of ten
+    string fileName = TempDir() + "test_ActorGraph_components.tsv";
+    {
+        ofstream out(fileName);
+        out << "Actor/Actress\tMovie\tYear\n";
+        for (unsigned int i = 0; i < 20000; i++) {
+            out << "Actor " << i << "\tPair " << i / 2 << "\t2000\n";
+            if (i % 20 < 10 && i % 2 == 0) {
+                out << "Actor " << i << "\tRun " << i / 20 << "\t2000\n";
+            }
+        }
+    }
+    ActorGraph serial;
+    ActorGraph parallel;
+    ASSERT_TRUE(serial.buildGraphFromFile(fileName.c_str()));
+    ASSERT_TRUE(parallel.buildGraphFromFile(fileName.c_str(), 4));
+    ASSERT_EQ(serial.getComponents().numComponents(), 1000u + 5000u);
+    ASSERT_EQ(serial.getComponents().getSize(0), 10u);
+    for (unsigned int a = 0; a < serial.numActors(); a++) {
+        ASSERT_EQ(parallel.getComponents().getComponent(a),
+                  serial.getComponents().getComponent(a));
+    }
+    string path;
+    serial.BFS("Actor 0", "Actor 20", path);
+    ASSERT_EQ(path, "");
+}
+
+TEST(DisjointSetsTests, TEST_UNITE_AND_FIND) {
+    DisjointSets sets(6);
+    ASSERT_NE(sets.find(0), sets.find(1));
+    sets.unite(sets.find(0), sets.find(1));
+    sets.unite(sets.find(2), sets.find(3));
+    ASSERT_EQ(sets.find(0), sets.find(1));
+    ASSERT_NE(sets.find(1), sets.find(2));
+    unsigned int root = sets.unite(sets.find(1), sets.find(3));
+    for (unsigned int i = 0; i < 4; i++) {
+        ASSERT_EQ(sets.find(i), root);
+    }
+    ASSERT_EQ(sets.find(5), 5u);
+}
+
+TEST_F(SmallActorGraphFixture, TEST_BFS_IN_YEARS) {
+    string path;
+    // Without the 2011 movie Kevin Bacon has no collaborator
+    YearRange recent = {2012, 2019};
+    graph.BFS("Kevin Bacon", "Tom Holland", path, FORWARD_SEARCH, recent);
+    ASSERT_EQ(path, "");
+    // Without the 2019 movies the path must go through Alien: Covenant
+    YearRange older = {2011, 2018};
+    graph.BFS("James McAvoy", "Tom Holland", path, FORWARD_SEARCH, older);
+    ASSERT_EQ(path,
+              "(James McAvoy)--[X-Men: First Class#@2011]-->(Michael "
+              "Fassbender)--[Alien: Covenant#@2017]-->(Katherine "
+              "Waterston)--[The Current War#@2017]-->(Tom Holland)");
+    // Both paths have three movies, and older movies are tried first
+    string olderPath = path;
+    YearRange all = {1900, 2100};
+    graph.BFS("James McAvoy", "Tom Holland", path, FORWARD_SEARCH, all);
+    ASSERT_EQ(path, olderPath);
+    // An actor without a movie in the range is left out, like an unknown one
+    path = "";
+    graph.BFS("Kevin Bacon", "Kevin Bacon", path, FORWARD_SEARCH, recent);
+    ASSERT_EQ(path, "");
+}
+
+TEST_F(SmallActorGraphFixture, TEST_HYBRID_BFS) {
+    string path;
+    string hybridPath;
+    graph.BFS("Kevin Bacon", "Tom Holland", path);
+    graph.BFS("Kevin Bacon", "Tom Holland", hybridPath, HYBRID_SEARCH);
+    ASSERT_EQ(hybridPath, path);
+    graph.BFS("Tom Holland", "Tom Holland", hybridPath, HYBRID_SEARCH);
+    ASSERT_EQ(hybridPath, "(Tom Holland)");
+
+    vector<unsigned int> distances;
+    vector<unsigned int> actorIds;
+    vector<unsigned int> movieIds;
+    graph.actorDistances(graph.getActorId("Kevin Bacon"), distances);
+    for (unsigned int a = 0; a < graph.numActors(); a++) {
+        if (graph.findPath(0, a, actorIds, movieIds)) {
+            ASSERT_EQ(distances[a], movieIds.size());
+        } else {
+            ASSERT_EQ(distances[a], HybridBFS::NO_LEVEL);
+        }
+    }
+}
+
+TEST_F(SmallActorGraphFixture, TEST_BACON_NUMBERS) {
+    BaconNumbers numbers;
+    ASSERT_FALSE(graph.baconNumbers("Nobody", numbers));
+    ASSERT_TRUE(graph.baconNumbers("Kevin Bacon", numbers));
+    vector<unsigned int> actorIds;
+    vector<unsigned int> movieIds;
+    for (unsigned int a = 0; a < graph.numActors(); a++) {
+        if (graph.findPath(0, a, actorIds, movieIds)) {
+            ASSERT_EQ(numbers.getDistance(a), movieIds.size());
+        } else {
+            ASSERT_EQ(numbers.getDistance(a), BaconNumbers::NO_DISTANCE);
+        }
+    }
+    ASSERT_EQ(numbers.getNumReached(), graph.numActors() - 1);
+    vector<size_t> histogram = {1, 2, 2, 2};
+    ASSERT_EQ(numbers.getHistogram(), histogram);
+    ASSERT_EQ(numbers.getMaxDistance(), 3u);
+    vector<unsigned int> farthest = {graph.getActorId("Robert Downey Jr."),
+                                     graph.getActorId("Tom Holland")};
+    sort(farthest.begin(), farthest.end());
+    ASSERT_EQ(numbers.getFarthest(), farthest);
+}
+
+TEST(BaconNumbersTests, TEST_SAME_NUMBERS_FOR_ANY_THREAD_COUNT) {
+    // Actor i shares a movie with actors 2i + 1 and 2i + 2, so the levels
+    // are wide enough to be split into many tasks
+    string fileName = TempDir() + "test_ActorGraph_tree.tsv";
+    {
+        ofstream out(fileName);
+        out << "Actor/Actress\tMovie\tYear\n";
+        for (unsigned int i = 0; 2 * i + 2 < 20000; i++) {
+            out << "Actor " << i << "\tMovie " << i << "\t2000\n";
+            out << "Actor " << 2 * i + 1 << "\tMovie " << i << "\t2000\n";
+            out << "Actor " << 2 * i + 2 << "\tMovie " << i << "\t2000\n";
+        }
+    }
+    ActorGraph graph;
+    ASSERT_TRUE(graph.buildGraphFromFile(fileName.c_str()));
+    BaconNumbers serial;
+    BaconNumbers parallel;
+    ASSERT_TRUE(graph.baconNumbers("Actor 0", serial));
+    ASSERT_TRUE(graph.baconNumbers("Actor 0", parallel, 4));
+    ASSERT_EQ(parallel.getDistances(), serial.getDistances());
+    ASSERT_EQ(parallel.getHistogram(), serial.getHistogram());
+    ASSERT_EQ(parallel.getFarthest(), serial.getFarthest());
+    for (unsigned int i = 0; i < 20000; i += 97) {
+        unsigned int level = 0;
+        while ((2u << level) <= i + 1) {
+            level++;
+        }
+        ASSERT_EQ(serial.getDistance(graph.getActorId(
+                      "Actor " + to_string(i))),
+                  level);
+    }
+    ASSERT_EQ(serial.getMaxDistance(), 14u);
+    ASSERT_EQ(serial.getFarthest().size(), 19999u - 16383u);
+}
+
+TEST_F(SmallActorGraphFixture, TEST_DISTANCE_DISTRIBUTION) {
+    // Every N(t) is counted exactly with a BFS from each actor
+    vector<double> exact;
+    BaconNumbers numbers;
+    for (unsigned int a = 0; a < graph.numActors(); a++) {
+        graph.baconNumbers(graph.getActorName(a), numbers);
+        const vector<size_t>& histogram = numbers.getHistogram();
+        exact.resize(max(exact.size(), histogram.size()), 0);
+        for (unsigned int t = 0; t < histogram.size(); t++) {
+            exact[t] += histogram[t];
+        }
+    }
+    for (unsigned int t = 1; t < exact.size(); t++) {
+        exact[t] += exact[t - 1];
+    }
+
+    // With this many registers so few actors are counted all but exactly
+    DistanceDistribution distribution(
+        DistanceDistribution::MAX_LOG2_REGISTERS);
+    ASSERT_TRUE(graph.distanceDistribution(distribution));
+    ASSERT_EQ(distribution.getMaxDistance(), exact.size() - 1);
+    for (unsigned int t = 0; t < exact.size(); t++) {
+        ASSERT_NEAR(distribution.getNeighbourhood()[t], exact[t], 1);
+        ASSERT_LE(distribution.getLower(t), exact[t]);
+        ASSERT_GE(distribution.getUpper(t), exact[t]);
+    }
+    double sum = 0;
+    for (unsigned int t = 1; t < exact.size(); t++) {
+        sum += t * (exact[t] - exact[t - 1]);
+    }
+    double connected = exact.back() - exact[0];
+    ASSERT_NEAR(distribution.getConnectedPairs(), connected, 1);
+    ASSERT_NEAR(distribution.getAverageDistance(), sum / connected, 0.05);
+}
+
+TEST(DistanceDistributionTests, TEST_SAME_ESTIMATES_FOR_ANY_THREAD_COUNT) {
+    ActorGraph graph;
+    ASSERT_TRUE(graph.buildGraphFromFile(writeChainCastFile(300).c_str()));
+    DistanceDistribution serial;
+    DistanceDistribution parallel;
+    ASSERT_TRUE(graph.distanceDistribution(serial));
+    ASSERT_TRUE(graph.distanceDistribution(parallel, 4));
+    ASSERT_EQ(parallel.getNeighbourhood(), serial.getNeighbourhood());
+    // A chain of n actors has n (n - 1) connected ordered pairs, about a
+    // third of n apart on average. The counters of the far ends can stop
+    // growing a little before the last actors are counted.
+    ASSERT_LE(serial.getMaxDistance(), 299u);
+    ASSERT_GE(serial.getMaxDistance(), 250u);
+    double connected = 300.0 * 299.0;
+    ASSERT_GE(serial.getConnectedPairs(), connected * 0.8);
+    ASSERT_LE(serial.getConnectedPairs(), connected * 1.2);
+    ASSERT_NEAR(serial.getAverageDistance(), 100.0, 20.0);
+}
+
+TEST_F(SmallActorGraphFixture, TEST_INDEXED_PATHS) {
+    vector<unsigned int> actorIds;
+    vector<unsigned int> movieIds;
+    vector<unsigned int> indexedActorIds;
+    vector<unsigned int> indexedMovieIds;
+    for (unsigned int a = 0; a < graph.numActors(); a++) {
+        for (unsigned int b = 0; b < graph.numActors(); b++) {
+            bool found = graph.findPath(a, b, actorIds, movieIds);
+            ASSERT_EQ(graph.findPathIndexed(a, b, indexedActorIds,
+                                            indexedMovieIds),
+                      found);
+            if (!found) {
+                continue;
+            }
+            ASSERT_EQ(indexedMovieIds.size(), movieIds.size());
+            ASSERT_EQ(indexedActorIds.front(), a);
+            ASSERT_EQ(indexedActorIds.back(), b);
+            for (size_t i = 0; i < indexedMovieIds.size(); i++) {
+                ASSERT_NE(indexedMovieIds[i], CSRGraph::NO_ID);
+            }
+        }
+    }
+    string path;
+    graph.BFS("Kevin Bacon", "Tom Holland", path, INDEXED_SEARCH);
+    ASSERT_EQ(count(path.begin(), path.end(), '['), 3);
+
+    // The labels read back answer like the ones written
+    string labelsName = TempDir() + "test_ActorGraph_labels.bin";
+    ASSERT_TRUE(graph.saveLabels(labelsName.c_str()));
+    ActorGraph loaded;
+    loaded.buildGraphFromFile(writeCastFile().c_str());
+    ASSERT_TRUE(loaded.loadLabels(labelsName.c_str()));
+    string loadedPath;
+    loaded.BFS("Kevin Bacon", "Tom Holland", loadedPath, INDEXED_SEARCH);
+    ASSERT_EQ(loadedPath, path);
+    ActorGraph other;
+    other.buildGraphFromFile(writeChainCastFile(10).c_str());
+    ASSERT_FALSE(other.loadLabels(labelsName.c_str()));
+
+    // Labels of the same casts under other ids are rejected, not used
+    ActorGraph reordered;
+    reordered.buildGraphFromFile(writeCastFile().c_str());
+    reordered.reorder(DEGREE_ORDER);
+    ASSERT_FALSE(reordered.loadLabels(labelsName.c_str()));
+    string reorderedPath;
+    reordered.BFS("Kevin Bacon", "Tom Holland", reorderedPath, INDEXED_SEARCH);
+    ASSERT_EQ(count(reorderedPath.begin(), reorderedPath.end(), '['), 3);
+
+    // So are labels naming actors the graph does not have
+    fstream corrupt(labelsName, ios::in | ios::out | ios::binary);
+    corrupt.seekp(48);
+    corrupt.write("\xFF\xFF\xFF\xFF", 4);
+    corrupt.close();
+    ActorGraph corrupted;
+    corrupted.buildGraphFromFile(writeCastFile().c_str());
+    ASSERT_FALSE(corrupted.loadLabels(labelsName.c_str()));
+}
+
+TEST_F(SmallActorGraphFixture, TEST_LANDMARK_BOUNDS) {
+    graph.buildLandmarks(2, DEGREE_LANDMARKS);
+    vector<unsigned int> actorIds;
+    vector<unsigned int> movieIds;
+    vector<unsigned int> landmarkActorIds;
+    vector<unsigned int> landmarkMovieIds;
+    for (unsigned int a = 0; a < graph.numActors(); a++) {
+        for (unsigned int b = 0; b < graph.numActors(); b++) {
+            string from = graph.getActorName(a);
+            string to = graph.getActorName(b);
+            unsigned int lower;
+            unsigned int upper;
+            ASSERT_TRUE(graph.distanceBounds(from, to, lower, upper));
+            bool found = graph.findPath(a, b, actorIds, movieIds);
+            if (found) {
+                ASSERT_LE(lower, movieIds.size());
+                ASSERT_GE(upper, movieIds.size());
+            } else {
+                ASSERT_EQ(lower, LandmarkOracle::NO_DISTANCE);
+            }
+            // The pruned search finds a path just as short
+            ASSERT_EQ(graph.findPathLandmarks(a, b, landmarkActorIds,
+                                              landmarkMovieIds),
+                      found);
+            ASSERT_EQ(landmarkMovieIds.size(), movieIds.size());
+            if (found) {
+                ASSERT_EQ(landmarkActorIds.front(), a);
+                ASSERT_EQ(landmarkActorIds.back(), b);
+            }
+        }
+    }
+    unsigned int lower;
+    unsigned int upper;
+    ASSERT_FALSE(graph.distanceBounds("Kevin Bacon", "Nobody", lower, upper));
+}
+
+TEST_F(SmallActorGraphFixture, TEST_REORDER_KEEPS_PATH_LENGTHS) {
+    for (VertexOrdering ordering : {BFS_ORDER, DEGREE_ORDER, COMMUNITY_ORDER}) {
+        ActorGraph reordered;
+        reordered.buildGraphFromFile(writeCastFile().c_str());
+        reordered.reorder(ordering);
+        ASSERT_EQ(reordered.numActors(), graph.numActors());
+        ASSERT_EQ(reordered.getComponents().numComponents(), 2u);
+        for (unsigned int a = 0; a < graph.numActors(); a++) {
+            for (unsigned int b = 0; b < graph.numActors(); b++) {
+                string from = graph.getActorName(a);
+                string to = graph.getActorName(b);
+                string path;
+                string reorderedPath;
+                graph.BFS(from, to, path);
+                reordered.BFS(from, to, reorderedPath);
+                // Ties may be broken another way, but not the length
+                ASSERT_EQ(count(reorderedPath.begin(), reorderedPath.end(),
+                                '>'),
+                          count(path.begin(), path.end(), '>'));
+                if (!path.empty()) {
+                    ASSERT_EQ(reorderedPath.find("(" + from + ")"), 0u);
+                }
+            }
+        }
+    }
+}
+
+TEST(VertexOrderTests, TEST_ORDERS_ARE_PERMUTATIONS) {
+    ActorGraph graph;
+    ASSERT_TRUE(graph.buildGraphFromFile(writeChainCastFile(500).c_str()));
+    const CSRGraph& csr = graph.getCSR();
+    vector<unsigned int> sources = {0, 250, 499};
+    LocalityBenchmark before(4096, 2);
+    before.run(csr, sources);
+    for (VertexOrdering ordering : {BFS_ORDER, DEGREE_ORDER, COMMUNITY_ORDER}) {
+        VertexOrder order(csr, ordering);
+        vector<unsigned int> actors = order.getActorOrder();
+        vector<unsigned int> movies = order.getMovieOrder();
+        sort(actors.begin(), actors.end());
+        sort(movies.begin(), movies.end());
+        for (unsigned int a = 0; a < actors.size(); a++) {
+            ASSERT_EQ(actors[a], a);
+        }
+        for (unsigned int m = 0; m < movies.size(); m++) {
+            ASSERT_EQ(movies[m], m);
+        }
+        ASSERT_EQ(actors.size(), csr.numActors());
+        ASSERT_EQ(movies.size(), csr.numMovies());
+
+        // The renumbered searches from the same actors do the same work
+        CSRGraph renumbered(csr, order.getActorOrder(), order.getMovieOrder());
+        vector<unsigned int> renumberedSources;
+        for (unsigned int source : sources) {
+            renumberedSources.push_back(
+                find(order.getActorOrder().begin(),
+                     order.getActorOrder().end(), source) -
+                order.getActorOrder().begin());
+        }
+        LocalityBenchmark after(4096, 2);
+        after.run(renumbered, renumberedSources);
+        ASSERT_EQ(after.getNumAccesses(), before.getNumAccesses());
+        ASSERT_GT(after.getNumMisses(), 0u);
+    }
+}
+
+TEST_F(SmallActorGraphFixture, TEST_COMPRESSED_SEARCHES) {
+    ActorGraph compressed;
+    compressed.buildGraphFromFile(writeCastFile().c_str());
+    compressed.compress();
+    ASSERT_EQ(compressed.getMovieYear(0), graph.getMovieYear(0));
+    for (unsigned int a = 0; a < graph.numActors(); a++) {
+        string from = graph.getActorName(a);
+        for (unsigned int b = 0; b < graph.numActors(); b++) {
+            string to = graph.getActorName(b);
+            string path;
+            string compressedPath;
+            graph.BFS(from, to, path);
+            compressed.BFS(from, to, compressedPath, BIDIRECTIONAL_SEARCH);
+            // Sorted lists may break ties another way, but not the length
+            ASSERT_EQ(count(compressedPath.begin(), compressedPath.end(),
+                            '>'),
+                      count(path.begin(), path.end(), '>'));
+        }
+        vector<string> predictions;
+        vector<string> compressedPredictions;
+        graph.predictLink(from, predictions, 3);
+        compressed.predictLink(from, compressedPredictions, 3);
+        ASSERT_EQ(compressedPredictions, predictions);
+    }
+}
+
+TEST(CompressedGraphTests, TEST_DECODES_EVERY_LIST) {
+    // Random casts over enough actors for gaps of one to three bytes,
+    // and one cast long enough for many groups of four
+    const unsigned int numActors = 100000;
+    const unsigned int numMovies = 300;
+    srand(1);
+    vector<vector<unsigned int>> casts(numMovies);
+    vector<vector<unsigned int>> movies(numActors);
+    for (unsigned int m = 0; m < numMovies; m++) {
+        unsigned int castSize = m == 0 ? 5000 : rand() % 12;
+        for (unsigned int i = 0; i < castSize; i++) {
+            unsigned int actor = m == 0 ? i * 7 : rand() % numActors;
+            if (find(casts[m].begin(), casts[m].end(), actor) ==
+                casts[m].end()) {
+                casts[m].push_back(actor);
+                movies[actor].push_back(m);
+            }
+        }
+    }
+    vector<unsigned int> actorOffsets;
+    vector<unsigned int> actorMovies;
+    vector<unsigned int> movieOffsets;
+    vector<unsigned int> movieActors;
+    for (unsigned int a = 0; a < numActors; a++) {
+        actorOffsets.push_back(actorMovies.size());
+        actorMovies.insert(actorMovies.end(), movies[a].rbegin(),
+                           movies[a].rend());
+    }
+    actorOffsets.push_back(actorMovies.size());
+    for (unsigned int m = 0; m < numMovies; m++) {
+        movieOffsets.push_back(movieActors.size());
+        movieActors.insert(movieActors.end(), casts[m].begin(),
+                           casts[m].end());
+    }
+    movieOffsets.push_back(movieActors.size());
+    vector<int> years(numMovies, 2000);
+    years[1] = 2020;
+    CSRGraph csr(numActors, numMovies, actorOffsets.data(),
+                 actorMovies.data(), movieOffsets.data(), movieActors.data(),
+                 years.data());
+
+    CompressedGraph graph(csr);
+    ASSERT_EQ(graph.numEdges(), csr.numEdges());
+    ASSERT_EQ(graph.getLatestYear(), 2020);
+    ASSERT_EQ(graph.getMaxCast(), 5000u);
+    size_t plainSize = actorOffsets.size() + actorMovies.size() +
+                       movieOffsets.size() + movieActors.size();
+    ASSERT_LT(graph.memoryUsage(), sizeof(unsigned int) * plainSize);
+    vector<unsigned int> ids(max(graph.getMaxCast(), graph.getMaxMovies()));
+    for (unsigned int a = 0; a < numActors; a++) {
+        vector<unsigned int> expected(csr.moviesBegin(a), csr.moviesEnd(a));
+        sort(expected.begin(), expected.end());
+        unsigned int count = graph.getMovies(a, ids.data());
+        ASSERT_EQ(vector<unsigned int>(ids.begin(), ids.begin() + count),
+                  expected);
+    }
+    for (unsigned int m = 0; m < numMovies; m++) {
+        vector<unsigned int> expected(csr.actorsBegin(m), csr.actorsEnd(m));
+        sort(expected.begin(), expected.end());
+        unsigned int count = graph.getActors(m, ids.data());
+        ASSERT_EQ(vector<unsigned int>(ids.begin(), ids.begin() + count),
+                  expected);
+    }
+}
+
+TEST_F(SmallActorGraphFixture, TEST_CAST_BITSETS) {
+    ASSERT_EQ(graph.getCastBitsets().getMinCast(),
+              CastBitsets::DEFAULT_MIN_CAST);
+    ASSERT_EQ(graph.getCastBitsets().size(), 0u);
+    vector<vector<unsigned int>> lengths(graph.numActors());
+    vector<unsigned int> actorIds;
+    vector<unsigned int> movieIds;
+    for (unsigned int a = 0; a < graph.numActors(); a++) {
+        for (unsigned int b = 0; b < graph.numActors(); b++) {
+            graph.findPath(a, b, actorIds, movieIds);
+            lengths[a].push_back(actorIds.size());
+        }
+    }
+
+    // Every cast but the lonely one fits in a single word
+    const CastBitsets& bitsets = graph.buildCastBitsets(2);
+    ASSERT_EQ(bitsets.size(), 7u);
+    ASSERT_EQ(bitsets.getNumWords(0), 1u);
+    ASSERT_EQ(bitsets.find(graph.numMovies() - 1), CastBitsets::NO_BITSET);
+    for (unsigned int a = 0; a < graph.numActors(); a++) {
+        for (unsigned int b = 0; b < graph.numActors(); b++) {
+            graph.findPath(a, b, actorIds, movieIds);
+            ASSERT_EQ(actorIds.size(), lengths[a][b]);
+            for (unsigned int i = 0; i < movieIds.size(); i++) {
+                ASSERT_NE(bitsets.find(movieIds[i]), CastBitsets::NO_BITSET);
+            }
+        }
+    }
+    string path;
+    graph.BFS("Kevin Bacon", "Tom Holland", path);
+    ASSERT_EQ(count(path.begin(), path.end(), '>'), 3);
+}
+
+TEST(CastBitsetsTests, TEST_SPARSE_CASTS_STAY_LISTS) {
+    // Movie 0 has actors 0 and 500, movie 1 has actors 0 to 63
+    vector<unsigned int> actorOffsets;
+    vector<unsigned int> actorMovies;
+    for (unsigned int a = 0; a <= 500; a++) {
+        actorOffsets.push_back(actorMovies.size());
+        if (a == 0 || a == 500) {
+            actorMovies.push_back(0);
+        }
+        if (a < 64) {
+            actorMovies.push_back(1);
+        }
+    }
+    actorOffsets.push_back(actorMovies.size());
+    vector<unsigned int> movieActors = {0, 500};
+    for (unsigned int a = 0; a < 64; a++) {
+        movieActors.push_back(a);
+    }
+    vector<unsigned int> movieOffsets = {0, 2, 66};
+    vector<int> years = {2000, 2001};
+    CSRGraph graph(501, 2, actorOffsets.data(), actorMovies.data(),
+                   movieOffsets.data(), movieActors.data(), years.data());
+
+    CastBitsets bitsets(graph, 2);
+    ASSERT_EQ(bitsets.size(), 1u);
+    ASSERT_EQ(bitsets.find(0), CastBitsets::NO_BITSET);
+    ASSERT_EQ(bitsets.find(1), 0u);
+    ASSERT_EQ(bitsets.getFirstWord(0), 0u);
+    ASSERT_EQ(bitsets.getWords(0)[0], ~0ull);
+    ASSERT_EQ(CastBitsets(graph, 65).size(), 0u);
+}
+
+TEST(LandmarkOracleTests, TEST_LANDMARK_CHOICES) {
+    // Actor i and actor i + 1 share movie i
+    const unsigned int numActors = 100;
+    vector<unsigned int> actorOffsets;
+    vector<unsigned int> actorMovies;
+    vector<unsigned int> movieOffsets;
+    vector<unsigned int> movieActors;
+    for (unsigned int a = 0; a < numActors; a++) {
+        actorOffsets.push_back(actorMovies.size());
+        if (a > 0) {
+            actorMovies.push_back(a - 1);
+        }
+        if (a + 1 < numActors) {
+            actorMovies.push_back(a);
+        }
+    }
+    actorOffsets.push_back(actorMovies.size());
+    for (unsigned int m = 0; m + 1 < numActors; m++) {
+        movieOffsets.push_back(movieActors.size());
+        movieActors.push_back(m);
+        movieActors.push_back(m + 1);
+    }
+    movieOffsets.push_back(movieActors.size());
+    vector<int> years(numActors - 1, 2000);
+    CSRGraph graph(numActors, numActors - 1, actorOffsets.data(),
+                   actorMovies.data(), movieOffsets.data(), movieActors.data(),
+                   years.data());
+
+    // Actor 1 comes first, then the far end, then the middle
+    LandmarkOracle farthest(graph, 3, FARTHEST_LANDMARKS);
+    ASSERT_EQ(farthest.getLandmark(0), 1u);
+    ASSERT_EQ(farthest.getLandmark(1), 99u);
+    ASSERT_EQ(farthest.getLandmark(2), 50u);
+    unsigned int lower;
+    unsigned int upper;
+    farthest.bounds(10, 30, lower, upper);
+    ASSERT_EQ(lower, 20u);
+    LandmarkOracle random(graph, numActors, RANDOM_LANDMARKS, 3);
+    random.bounds(10, 30, lower, upper);
+    ASSERT_EQ(lower, 20u);
+    ASSERT_EQ(upper, 20u);
+}
+
+TEST(ChainActorGraphTests, TEST_LABELS_WITH_THREADS) {
+    ActorGraph graph;
+    graph.buildGraphFromFile(writeChainCastFile(200).c_str());
+    const PrunedLabelIndex& labels = graph.buildLabels(4);
+    for (unsigned int a = 0; a < 200; a += 7) {
+        for (unsigned int b = 0; b < 200; b += 11) {
+            unsigned int from = graph.getActorId("Actor " + to_string(a));
+            unsigned int to = graph.getActorId("Actor " + to_string(b));
+            ASSERT_EQ(labels.distance(from, to), a > b ? a - b : b - a);
+        }
+    }
+}
+
+TEST(ChainActorGraphTests, TEST_INDEXED_PATHS_PAST_255_MOVIES) {
+    ActorGraph graph;
+    graph.buildGraphFromFile(writeChainCastFile(700).c_str());
+    graph.buildLabels(4);
+    for (unsigned int to : {1u, 256u, 699u}) {
+        string path;
+        graph.BFS("Actor 0", "Actor " + to_string(to), path, INDEXED_SEARCH);
+        ASSERT_EQ((unsigned int)count(path.begin(), path.end(), '['), to);
+        ASSERT_EQ(path.find("(Actor 0)"), 0u);
+    }
+}
+
+TEST(ChainActorGraphTests, TEST_LANDMARKS_PAST_253_MOVIES) {
+    ActorGraph graph;
+    graph.buildGraphFromFile(writeChainCastFile(700).c_str());
+    // Actor 1 is the landmark, 249 movies from Actor 250 and 259 from 260
+    graph.buildLandmarks(1, DEGREE_LANDMARKS);
+    unsigned int lower;
+    unsigned int upper;
+    ASSERT_TRUE(graph.distanceBounds("Actor 250", "Actor 260", lower, upper));
+    ASSERT_LE(lower, 10u);
+    ASSERT_GE(upper, 10u);
+    ASSERT_TRUE(graph.distanceBounds("Actor 0", "Actor 699", lower, upper));
+    ASSERT_LE(lower, 699u);
+    ASSERT_GE(upper, 699u);
+    for (unsigned int from : {0u, 250u}) {
+        for (unsigned int to : {260u, 699u}) {
+            string path;
+            graph.BFS("Actor " + to_string(from), "Actor " + to_string(to),
+                      path, LANDMARK_SEARCH);
+            ASSERT_EQ((unsigned int)count(path.begin(), path.end(), '['),
+                      to - from);
+        }
+    }
+}
+
+TEST(HybridBFSTests, TEST_BOTTOM_UP_STEPS) {
+    // Actors 0 to 99 share one movie, and each has a fan of their own
+    string fileName = TempDir() + "test_ActorGraph_hub.tsv";
+    {
+        ofstream out(fileName);
+        out << "Actor/Actress\tMovie\tYear\n";
+        for (unsigned int i = 0; i < 100; i++) {
+            out << "Actor " << i << "\tHub\t2000\n";
+            out << "Actor " << i << "\tSide " << i << "\t2000\n";
+            out << "Fan " << i << "\tSide " << i << "\t2000\n";
+        }
+    }
+    ActorGraph graph;
+    ASSERT_TRUE(graph.buildGraphFromFile(fileName.c_str()));
+    vector<unsigned int> distances;
+    graph.actorDistances(graph.getActorId("Fan 0"), distances);
+    ASSERT_GT(HybridBFS::forThread().getNumBottomUp(), 0u);
+    ASSERT_GT(HybridBFS::forThread().getNumTopDown(), 0u);
+    ASSERT_EQ(distances[graph.getActorId("Fan 0")], 0u);
+    ASSERT_EQ(distances[graph.getActorId("Actor 0")], 1u);
+    ASSERT_EQ(distances[graph.getActorId("Actor 42")], 2u);
+    ASSERT_EQ(distances[graph.getActorId("Fan 99")], 3u);
+}
+
+TEST(SearchWorkspaceTests, TEST_START_SEARCH_FORGETS_MARKS) {
+    SearchWorkspace workspace;
+    workspace.startSearch(4, 2);
+    workspace.reachActor(2, 1, 0);
+    ASSERT_TRUE(workspace.visitMovie(1));
+    ASSERT_FALSE(workspace.visitMovie(1));
+    ASSERT_TRUE(workspace.hasActor(2));
+    ASSERT_EQ(workspace.getPrevActor(2), 1);
+
+    workspace.startSearch(6, 2);
+    ASSERT_FALSE(workspace.hasActor(2));
+    ASSERT_FALSE(workspace.hasActor(5));
+    ASSERT_TRUE(workspace.visitMovie(1));
+}
+
+TEST_F(SmallActorGraphFixture, TEST_BACK_TO_BACK_QUERIES) {
+    string first;
+    string second;
+    graph.BFS("Kevin Bacon", "Tom Holland", first);
+    graph.BFS("Tom Holland", "Lonely Actor", second);
+    ASSERT_EQ(second, "");
+    graph.BFS("Kevin Bacon", "Tom Holland", second);
+    ASSERT_EQ(first, second);
+}
+
+TEST_F(SmallActorGraphFixture, TEST_BATCH_BFS) {
+    vector<pair<string, string>> actorPairs = {
+        {"Kevin Bacon", "Tom Holland"},
+        {"Kevin Bacon", "James McAvoy"},
+        {"Tom Holland", "Tom Holland"},
+        {"Kevin Bacon", "Lonely Actor"},
+        {"Not An Actor", "Tom Holland"}};
+    vector<string> shortestPaths;
+    graph.BFS(actorPairs, shortestPaths);
+    ASSERT_EQ(shortestPaths.size(), actorPairs.size());
+    for (unsigned int i = 0; i < actorPairs.size(); i++) {
+        string path;
+        graph.BFS(actorPairs[i].first, actorPairs[i].second, path);
+        ASSERT_EQ(shortestPaths[i], path);
+    }
+}
+
+TEST(ChainActorGraphTests, TEST_BATCH_BFS_MANY_SOURCES) {
+    ActorGraph graph;
+    graph.buildGraphFromFile(writeChainCastFile(100).c_str());
+    vector<pair<string, string>> actorPairs;
+    for (unsigned int i = 0; i < 100; i++) {
+        actorPairs.push_back(
+            make_pair("Actor " + to_string(i), "Actor " + to_string(99 - i)));
+    }
+    vector<string> shortestPaths;
+    graph.BFS(actorPairs, shortestPaths);
+    for (unsigned int i = 0; i < 100; i++) {
+        string path;
+        graph.BFS(actorPairs[i].first, actorPairs[i].second, path);
+        ASSERT_EQ(shortestPaths[i], path);
+    }
+}
+
+TEST(ChainActorGraphTests, TEST_PATH_QUERY_POOL_KEEPS_ORDER) {
+    ActorGraph graph;
+    graph.buildGraphFromFile(writeChainCastFile(50).c_str());
+    ostringstream serial;
+    ostringstream parallel;
+    {
+        PathQueryPool pool(&graph, parallel, 4, FORWARD_SEARCH);
+        for (unsigned int i = 0; i < 200; i++) {
+            string from = "Actor " + to_string(i % 50);
+            string to = "Actor " + to_string((i * 7) % 60);
+            pool.submit(from, to);
+            string path;
+            graph.BFS(from, to, path);
+            serial << path << '\n';
+        }
+        pool.finish();
+    }
+    ASSERT_EQ(parallel.str(), serial.str());
+}
+
+TEST(ChainActorGraphTests, TEST_BATCH_BFS_THREADS) {
+    ActorGraph graph;
+    graph.buildGraphFromFile(writeChainCastFile(100).c_str());
+    vector<pair<string, string>> actorPairs;
+    for (unsigned int i = 0; i < 300; i++) {
+        actorPairs.push_back(make_pair("Actor " + to_string(i % 100),
+                                       "Actor " + to_string(i % 37)));
+    }
+    vector<string> serialPaths;
+    vector<string> parallelPaths;
+    graph.BFS(actorPairs, serialPaths);
+    graph.BFS(actorPairs, parallelPaths, 3);
+    ASSERT_EQ(parallelPaths, serialPaths);
+}
+
+TEST(CastFileReaderTests, TEST_PARSE_ROW) {
+    CastRow row;
+    string line = "Kevin Bacon\tFootloose\t1984";
+    ASSERT_TRUE(CastFileReader::parseRow(line.c_str(), line.size(), row));
+    ASSERT_EQ(string(row.actor, row.actorLength), "Kevin Bacon");
+    ASSERT_EQ(string(row.title, row.titleLength), "Footloose");
+    ASSERT_EQ(row.year, 1984);
+
+    // A trailing tab or carriage return is tolerated like getline/stoi did
+    line = "Kevin Bacon\tFootloose\t 1984\r\t";
+    ASSERT_TRUE(CastFileReader::parseRow(line.c_str(), line.size(), row));
+    ASSERT_EQ(row.year, 1984);
+
+    // Rows with the wrong number of fields or no year are malformed
+    vector<string> malformed = {"", "Kevin Bacon", "Kevin Bacon\tFootloose",
+                                "Kevin Bacon\tFootloose\t",
+                                "Kevin Bacon\tFootloose\t1984\tx",
+                                "Kevin Bacon\tFootloose\tyear"};
+    for (const string& bad : malformed) {
+        ASSERT_FALSE(CastFileReader::parseRow(bad.c_str(), bad.size(), row));
+    }
+}
+
+TEST(CastFileReaderTests, TEST_MISSING_FILE) {
+    ActorGraph graph;
+    ASSERT_FALSE(graph.buildGraphFromFile("/nonexistent/cast.tsv"));
+}
+
+TEST(CastFileReaderTests, TEST_READ_FROM_PIPE) {
+    // A pipe has no size, so it cannot be mapped like a file
+    string pipeName = TempDir() + "test_ActorGraph_pipe";
+    unlink(pipeName.c_str());
+    ASSERT_EQ(mkfifo(pipeName.c_str(), 0600), 0);
+    thread writer([&pipeName]() {
+        ifstream in(writeCastFile());
+        ofstream out(pipeName);
+        out << in.rdbuf();
+    });
+    ActorGraph graph;
+    bool isRead = graph.buildGraphFromFile(pipeName.c_str());
+    writer.join();
+    unlink(pipeName.c_str());
+    ASSERT_TRUE(isRead);
+    ASSERT_EQ(graph.numActors(), 8);
+    string path;
+    graph.BFS("Kevin Bacon", "Tom Holland", path);
+    ASSERT_EQ(count(path.begin(), path.end(), '['), 3);
+}
+
+TEST(ParallelLoadTests, TEST_SAME_GRAPH_FOR_ANY_THREAD_COUNT) {
+    string fileName = writeCastFile();
+    ActorGraph serial;
+    serial.buildGraphFromFile(fileName.c_str());
+    for (unsigned int numThreads : {2, 3, 8}) {
+        ActorGraph parallel;
+        ASSERT_TRUE(parallel.buildGraphFromFile(fileName.c_str(), numThreads));
+        ASSERT_EQ(parallel.numActors(), serial.numActors());
+        ASSERT_EQ(parallel.numMovies(), serial.numMovies());
+        for (unsigned int a = 0; a < serial.numActors(); a++) {
+            ASSERT_STREQ(parallel.getActorName(a), serial.getActorName(a));
+            ASSERT_EQ(parallel.getActorId(serial.getActorName(a)), a);
+        }
+        for (unsigned int m = 0; m < serial.numMovies(); m++) {
+            ASSERT_STREQ(parallel.getMovieName(m), serial.getMovieName(m));
+        }
+        string serialPath;
+        string parallelPath;
+        serial.BFS("Kevin Bacon", "Tom Holland", serialPath);
+        parallel.BFS("Kevin Bacon", "Tom Holland", parallelPath);
+        ASSERT_EQ(parallelPath, serialPath);
+    }
+}
+
+TEST_F(SmallActorGraphFixture, TEST_SNAPSHOT_ROUND_TRIP) {
+    string snapshotName = TempDir() + "test_ActorGraph_snapshot.bin";
+    ASSERT_TRUE(graph.saveSnapshot(snapshotName.c_str()));
+    ActorGraph loaded;
+    ASSERT_TRUE(loaded.buildGraphFromFile(snapshotName.c_str()));
+    ASSERT_EQ(loaded.numActors(), graph.numActors());
+    ASSERT_EQ(loaded.numMovies(), graph.numMovies());
+    for (unsigned int a = 0; a < graph.numActors(); a++) {
+        ASSERT_STREQ(loaded.getActorName(a), graph.getActorName(a));
+        ASSERT_EQ(loaded.getActorId(graph.getActorName(a)), a);
+    }
+    for (unsigned int m = 0; m < graph.numMovies(); m++) {
+        ASSERT_STREQ(loaded.getMovieName(m), graph.getMovieName(m));
+        ASSERT_EQ(loaded.getMovieYear(m), graph.getMovieYear(m));
+    }
+    ASSERT_EQ(loaded.getMovieYear(0), 2011);
+    ASSERT_EQ(loaded.getActorId("Not An Actor"), NameTable::NO_ID);
+    ASSERT_EQ(loaded.getActorId("Kevin"), NameTable::NO_ID);
+    string path;
+    string loadedPath;
+    graph.BFS("Kevin Bacon", "Tom Holland", path);
+    loaded.BFS("Kevin Bacon", "Tom Holland", loadedPath);
+    ASSERT_EQ(loadedPath, path);
+
+    // A cast file read afterwards adds to the mapped graph
+    ASSERT_TRUE(loaded.buildGraphFromFile(writeSecondCastFile().c_str()));
+    ASSERT_EQ(loaded.numActors(), graph.numActors() + 1);
+    ASSERT_EQ(loaded.getActorId("Kevin Bacon"), 0);
+    ASSERT_EQ(loaded.getActorId("Zoe Newcomer"), graph.numActors());
+    loaded.BFS("Lonely Actor", "Tom Holland", loadedPath);
+    ASSERT_EQ(loadedPath.find("(Lonely Actor)--[New Movie#@2020]-->"), 0u);
+}
+
+TEST_F(SmallActorGraphFixture, TEST_SNAPSHOT_REJECTS_CORRUPTION) {
+    string snapshotName = TempDir() + "test_ActorGraph_corrupt.bin";
+    ASSERT_TRUE(graph.saveSnapshot(snapshotName.c_str()));
+    {
+        // Flip one byte of the last section
+        fstream file(snapshotName, ios::in | ios::out | ios::binary);
+        file.seekg(-3, ios::end);
+        char byte = file.peek();
+        file.seekp(-3, ios::end);
+        file.put(byte ^ 1);
+    }
+    ActorGraph loaded;
+    ASSERT_FALSE(loaded.loadSnapshot(snapshotName.c_str()));
+}
+
+TEST(ArenaTests, TEST_ALIGNMENT_AND_REUSE) {
+    Arena arena;
+    char* small = (char*)arena.allocate(3, 1);
+    double* aligned = (double*)arena.allocate(sizeof(double), alignof(double));
+    ASSERT_EQ((size_t)aligned % alignof(double), 0);
+    ASSERT_NE((char*)aligned, small);
+
+    // A released power of two piece is handed out again
+    void* piece = arena.allocate(64, sizeof(void*));
+    arena.release(piece, 64);
+    ASSERT_EQ(arena.allocate(64, sizeof(void*)), piece);
+
+    // Allocations bigger than a block get a block of their own
+    char* big = (char*)arena.allocate(4 * Arena::FIRST_BLOCK_SIZE, 1);
+    big[4 * Arena::FIRST_BLOCK_SIZE - 1] = 'x';
+    ASSERT_GE(arena.memoryUsage(), 4 * Arena::FIRST_BLOCK_SIZE);
+
+    vector<int, ArenaAllocator<int>> numbers{ArenaAllocator<int>(arena)};
+    for (int i = 0; i < 1000; i++) {
+        numbers.push_back(i);
+    }
+    ASSERT_EQ(numbers[999], 999);
+}